@@ -88,6 +88,10 @@ void emscripten_main(state_t *state) {
   sdl_show();
 }
 
+scene_t *emscripten_get_scene(state_t *state) {
+  return NULL;
+}
+
 void emscripten_free(state_t *state) {
   list_free(state->list);
   free(state);
@@ -3,7 +3,9 @@
 #include "info.h"
 #include "scene.h"
 #include "sdl_wrapper.h"
+#include <assert.h>
 #include <math.h>
+#include <stdlib.h>
 
 const vector_t WINDOW = (vector_t){.x = 1048, .y = 975};
 
@@ -221,6 +223,8 @@ void init_scene(state_t *state) {
   create_physics_collision(state->scene, 1.0, ball, left_wall);
   create_physics_collision(state->scene, 1.0, ball, right_wall);
   create_physics_collision(state->scene, 1.0, ball, top_wall);
+  body_t **bricks = malloc(NUM_BRICKS * NUM_LINES * sizeof(body_t *));
+  assert(bricks != NULL);
   for (size_t i = 0; i < NUM_BRICKS; i++) {
     rgb_color_t col = generate_col(i);
     for (size_t j = 0; j < NUM_LINES; j++) {
@@ -229,13 +233,15 @@ void init_scene(state_t *state) {
                                    .y = WINDOW.y - GAP_VERT - BRICK_HEIGHT -
                                         (BRICK_HEIGHT + GAP_VERT) * j};
       info_t *info = info_init(BRICK_TYPE);
-      body_t *brick =
+      bricks[NUM_LINES * i + j] =
           body_init_with_info(draw_rect(center, BRICK_LENGTH, BRICK_HEIGHT),
                               BRICK_MASS, col, info, (free_func_t)info_free);
-      scene_add_body(state->scene, brick);
-      create_physics_collision(state->scene, 1.0, ball, brick);
     }
   }
+  scene_add_bodies_n(state->scene, bricks, NUM_BRICKS * NUM_LINES, NULL);
+  create_physics_collisions_batch(state->scene, 1.0, ball, bricks,
+                                  NUM_BRICKS * NUM_LINES);
+  free(bricks);
 }
 
 void check_bottom_ball(state_t *s) {
@@ -263,6 +269,10 @@ void emscripten_main(state_t *state) {
   check_bottom_ball(state);
 }
 
+scene_t *emscripten_get_scene(state_t *state) {
+  return state->scene;
+}
+
 void emscripten_free(state_t *state) {
   scene_free(state->scene);
   free(state);
@@ -70,8 +70,9 @@ state_t *emscripten_init() {
                  DOT_MASS, generate_color(i));
     create_spring(state->scene, K, scene_get_body(state->scene, 2 * i + 1),
                   scene_get_body(state->scene, 2 * i));
-    create_drag(state->scene, GAMMA, scene_get_body(state->scene, 2 * i + 1));
   }
+  scene_add_field(state->scene,
+                  (force_field_t){.kind = FIELD_DRAG, .drag = GAMMA});
   return state;
 }
 
@@ -80,6 +81,10 @@ void emscripten_main(state_t *state) {
   scene_tick(state->scene, time_since_last_tick());
 }
 
+scene_t *emscripten_get_scene(state_t *state) {
+  return state->scene;
+}
+
 void emscripten_free(state_t *state) {
   scene_free(state->scene);
   free(state);
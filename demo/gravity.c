@@ -101,6 +101,10 @@ void emscripten_main(state_t *s) {
   sdl_show();
 }
 
+scene_t *emscripten_get_scene(state_t *s) {
+  return NULL;
+}
+
 void emscripten_free(state_t *s) {
   list_t *arr = s->list;
   for (int i = 0; i < s->end; i++) {
@@ -19,9 +19,8 @@ const vector_t WINDOW = (vector_t){.x = 1000, .y = 1000};
 
 const double PLAYER_HORIZ_SPEED = 200.0;
 const double PLAYER_VERT_SPEED = 400.0;
-const double PLAYER1 = 1;
-const double PLAYER2 = 2;
-const double BLOCK_NUM = 3;
+// Players can only jump while (almost) not moving vertically
+const double STANDING_SPEED = 1e-3;
 
 const size_t PLAYER_LENGTH = 60;
 const size_t PLAYER_HEIGHT = 80;
@@ -130,8 +129,8 @@ const vector_t LEVEL_FOUR_FAN2 = {850, 385};
 const size_t LEVEL_FOUR_FAN2_LENGTH = 60;
 const size_t LEVEL_FOUR_FAN2_HEIGHT = 530;
 
-const size_t FANF_SHIFT = 2;
-const size_t FANL_SHIFT = 1;
+// Every fan's force creators share this tag, so the buttons can switch them
+const size_t FAN_TAG = 1;
 
 const rgb_color_t BLU = (rgb_color_t){.r = 0.0, .g = 0.0, .b = 1.0};
 const rgb_color_t YLLOW = (rgb_color_t){.r = 1.0, .g = 1.0, .b = 0.0};
@@ -156,12 +155,32 @@ typedef struct state {
   int start_time;
   int delt_time;
   char *display_time;
+  // The level's players, block and fans (the second fan only in levels
+  // three and four), which keep their handles as gems are removed
+  body_handle_t player1;
+  body_handle_t player2;
+  body_handle_t block;
+  body_handle_t fan1;
+  body_handle_t fan2;
+  // The last level played, kept on the lose screen so it can be restarted
+  scene_t *level_scene;
+  // The level's scene as it was set up, for restarting it
+  void *checkpoint;
+  size_t checkpoint_size;
 } state_t;
 
 void create_gravity(state_t *s){
-  create_fall(s->scene, GRAV_CONST, scene_get_body(s->scene, PLAYER1));
-  create_fall(s->scene, GRAV_CONST, scene_get_body(s->scene, PLAYER2));
-  create_fall(s->scene, GRAV_CONST, scene_get_body(s->scene, BLOCK_NUM));
+  size_t gravity = scene_add_field(s->scene, (force_field_t){
+      .kind = FIELD_UNIFORM, .force = {0, -GRAV_CONST}, .mass_scaled = true});
+  // Only the players and the block fall; gems and pulleys stay put
+  for (size_t i = 0; i < scene_bodies(s->scene); i++) {
+    body_t *body = scene_get_body(s->scene, i);
+    if (body != scene_resolve(s->scene, s->player1) &&
+        body != scene_resolve(s->scene, s->player2) &&
+        body != scene_resolve(s->scene, s->block)) {
+      body_set_field_mask(body, body_get_field_mask(body) & ~(1u << gravity));
+    }
+  }
 }
 
 void on_key(state_t *s, char key, key_event_type_t type, double held_time) {
@@ -169,22 +188,22 @@ void on_key(state_t *s, char key, key_event_type_t type, double held_time) {
     if (type == KEY_PRESSED) {
       switch (key) {
         case RIGHT_ARROW:
-          body_set_xvelocity(scene_get_body(s->scene, PLAYER1), PLAYER_HORIZ_SPEED);
+          body_set_xvelocity(scene_resolve(s->scene, s->player1), PLAYER_HORIZ_SPEED);
           if (!s->grav){
             create_gravity(s);
             s->grav = true;
           }
           break;
         case LEFT_ARROW:
-          body_set_xvelocity(scene_get_body(s->scene, PLAYER1), -1 * PLAYER_HORIZ_SPEED);
+          body_set_xvelocity(scene_resolve(s->scene, s->player1), -1 * PLAYER_HORIZ_SPEED);
           if (!s->grav){
             create_gravity(s);
             s->grav = true;
           }
           break;
         case UP_ARROW:
-          if (fabs(body_get_velocity(scene_get_body(s->scene, PLAYER1)).y) == 0.0){
-            body_add_impulse(scene_get_body(s->scene, PLAYER1), (vector_t){0, PLAYER_VERT_SPEED * PLAYER_MASS});
+          if (fabs(body_get_velocity(scene_resolve(s->scene, s->player1)).y) < STANDING_SPEED){
+            body_add_impulse(scene_resolve(s->scene, s->player1), (vector_t){0, PLAYER_VERT_SPEED * PLAYER_MASS});
             if (!s->grav){
               create_gravity(s);
               s->grav = true;
@@ -194,22 +213,22 @@ void on_key(state_t *s, char key, key_event_type_t type, double held_time) {
 
           break;
         case 'd':
-          body_set_xvelocity(scene_get_body(s->scene, PLAYER2), PLAYER_HORIZ_SPEED);
+          body_set_xvelocity(scene_resolve(s->scene, s->player2), PLAYER_HORIZ_SPEED);
           if (!s->grav){
             create_gravity(s);
             s->grav = true;
           }
           break;
         case 'a':
-          body_set_xvelocity(scene_get_body(s->scene, PLAYER2), -1 * PLAYER_HORIZ_SPEED);
+          body_set_xvelocity(scene_resolve(s->scene, s->player2), -1 * PLAYER_HORIZ_SPEED);
           if (!s->grav){
             create_gravity(s);
             s->grav = true;
           }
           break;
         case 'w':
-          if (fabs(body_get_velocity(scene_get_body(s->scene, PLAYER2)).y) == 0.0){
-            body_add_impulse(scene_get_body(s->scene, PLAYER2), (vector_t){0, PLAYER_VERT_SPEED * PLAYER_MASS});
+          if (fabs(body_get_velocity(scene_resolve(s->scene, s->player2)).y) < STANDING_SPEED){
+            body_add_impulse(scene_resolve(s->scene, s->player2), (vector_t){0, PLAYER_VERT_SPEED * PLAYER_MASS});
             if (!s->grav){
               create_gravity(s);
               s->grav = true;
@@ -222,20 +241,20 @@ void on_key(state_t *s, char key, key_event_type_t type, double held_time) {
     if (type == KEY_RELEASED) {
       switch (key) {
       case RIGHT_ARROW:
-        body_set_xvelocity(scene_get_body(s->scene, PLAYER1), 0.0);
-        body_set_xvelocity(scene_get_body(s->scene, BLOCK_NUM), 0.0);
+        body_set_xvelocity(scene_resolve(s->scene, s->player1), 0.0);
+        body_set_xvelocity(scene_resolve(s->scene, s->block), 0.0);
         break;
       case LEFT_ARROW:
-        body_set_xvelocity(scene_get_body(s->scene, PLAYER1), 0.0);
-        body_set_xvelocity(scene_get_body(s->scene, BLOCK_NUM), 0.0);
+        body_set_xvelocity(scene_resolve(s->scene, s->player1), 0.0);
+        body_set_xvelocity(scene_resolve(s->scene, s->block), 0.0);
         break;
       case 'd':
-        body_set_xvelocity(scene_get_body(s->scene, PLAYER2), 0.0);
-        body_set_xvelocity(scene_get_body(s->scene, BLOCK_NUM), 0.0);
+        body_set_xvelocity(scene_resolve(s->scene, s->player2), 0.0);
+        body_set_xvelocity(scene_resolve(s->scene, s->block), 0.0);
         break;
       case 'a':
-        body_set_xvelocity(scene_get_body(s->scene, PLAYER2), 0.0);
-        body_set_xvelocity(scene_get_body(s->scene, BLOCK_NUM), 0.0);
+        body_set_xvelocity(scene_resolve(s->scene, s->player2), 0.0);
+        body_set_xvelocity(scene_resolve(s->scene, s->block), 0.0);
         break;
       }
     }
@@ -250,11 +269,12 @@ void add_doors(state_t *state, body_t *player1, body_t *player2, vector_t center
   create_door_collision(state->scene, fake_door_yellow, player1, fake_door_blue, player2);
 }
 
-void add_fan(state_t *state, body_t *player1, body_t *player2, vector_t center, double length, double height) {
+body_handle_t add_fan(state_t *state, body_t *player1, body_t *player2, vector_t center, double length, double height) {
   body_t *fan = body_init_more_info(draw_rect(center, length, height), WALL_MASS, GRAY, length, height);
-  scene_add_body(state->scene, fan);
-  create_fan(state->scene, FAN_CONST, player1, fan);
-  create_fan(state->scene, FAN_CONST, player2, fan);
+  body_handle_t handle = scene_add_body(state->scene, fan);
+  create_fan(state->scene, FAN_CONST, player1, fan, FAN_TAG);
+  create_fan(state->scene, FAN_CONST, player2, fan, FAN_TAG);
+  return handle;
 }
 
 void add_button(state_t *state, body_t *player1, body_t *player2, body_t *block, vector_t center) {
@@ -319,7 +339,7 @@ char calculate_grade(state_t *state){
 void level_one_set_up(state_t *state, body_t *player1, body_t *player2, body_t *block){
   state->scene_num = LEVEL1;
   state->last_lvl = LEVEL1;
-  add_level_one_platforms(state->scene, player1, player2, block);
+  add_level_one_platforms(state->scene);
   add_level_one_obstacles(state->scene, player1, player2);
   add_level_one_gems(state->scene, player1, player2);
   add_doors(state, player1, player2, (vector_t)LEVEL_ONE_DOOR1, (vector_t)LEVEL_ONE_DOOR2);
@@ -331,12 +351,12 @@ void level_one_set_up(state_t *state, body_t *player1, body_t *player2, body_t *
 void level_two_set_up(state_t *state, body_t *player1, body_t *player2, body_t *block){
   state->scene_num = LEVEL2;
   state->last_lvl = LEVEL2;
-  add_level_two_platforms(state->scene, player1, player2, block);
+  add_level_two_platforms(state->scene);
   add_level_two_obstacles(state->scene, player1, player2);
   add_level_two_gems(state->scene, player1, player2);
   add_doors(state, player1, player2, (vector_t)LEVEL_TWO_DOOR1, (vector_t)LEVEL_TWO_DOOR2);
-  add_fan(state, player1, player2, (vector_t)LEVEL_TWO_FANS, LEVEL_TWO_FANS_LENGTH, LEVEL_TWO_FANS_HEIGHT);
-  body_set_texture(scene_get_body(state->scene, scene_bodies(state->scene) - FANL_SHIFT), sdl_load_image("assets/wind2.png"));
+  state->fan1 = add_fan(state, player1, player2, (vector_t)LEVEL_TWO_FANS, LEVEL_TWO_FANS_LENGTH, LEVEL_TWO_FANS_HEIGHT);
+  body_set_texture(scene_resolve(state->scene, state->fan1), sdl_load_image("assets/wind2.png"));
   body_set_centroid(player1, (vector_t) LEVEL_TWO_BODY1_CENTROID);
   body_set_centroid(player2, (vector_t) LEVEL_TWO_BODY2_CENTROID);
   body_set_centroid(block, (vector_t) LEVEL_TWO_BLOCK);
@@ -345,15 +365,15 @@ void level_two_set_up(state_t *state, body_t *player1, body_t *player2, body_t *
 void level_three_set_up(state_t *state, body_t *player1, body_t *player2, body_t *block){
   state->scene_num = LEVEL3;
   state->last_lvl = LEVEL3;
-  add_level_three_platforms(state->scene, player1, player2, block);
+  add_level_three_platforms(state->scene);
   add_level_three_obstacles(state->scene, player1, player2);
   add_level_three_gems(state->scene, player1, player2);
   add_doors(state, player1, player2, (vector_t)LEVEL_THREE_DOOR1, (vector_t)LEVEL_THREE_DOOR2);
   add_button(state, player1, player2, block, (vector_t)LEVEL_THREE_BUTTON);
-  add_fan(state, player1, player2, (vector_t)LEVEL_THREE_FAN1, LEVEL_THREE_FAN1_LENGTH, LEVEL_THREE_FAN1_HEIGHT );
-  add_fan(state, player1, player2, (vector_t)LEVEL_THREE_FAN2, LEVEL_THREE_FAN2_LENGTH, LEVEL_THREE_FAN2_HEIGHT);
-  body_set_texture(scene_get_body(state->scene, scene_bodies(state->scene) - FANL_SHIFT), sdl_load_image("assets/wind3.png"));
-  body_set_texture(scene_get_body(state->scene, scene_bodies(state->scene) - FANF_SHIFT), sdl_load_image("assets/wind3.png"));
+  state->fan1 = add_fan(state, player1, player2, (vector_t)LEVEL_THREE_FAN1, LEVEL_THREE_FAN1_LENGTH, LEVEL_THREE_FAN1_HEIGHT );
+  state->fan2 = add_fan(state, player1, player2, (vector_t)LEVEL_THREE_FAN2, LEVEL_THREE_FAN2_LENGTH, LEVEL_THREE_FAN2_HEIGHT);
+  body_set_texture(scene_resolve(state->scene, state->fan2), sdl_load_image("assets/wind3.png"));
+  body_set_texture(scene_resolve(state->scene, state->fan1), sdl_load_image("assets/wind3.png"));
   body_set_centroid(player1, (vector_t) LEVEL_THREE_BODY1_CENTROID);
   body_set_centroid(player2, (vector_t) LEVEL_THREE_BODY2_CENTROID);
   body_set_centroid(block, (vector_t) LEVEL_THREE_BLOCK);
@@ -362,15 +382,15 @@ void level_three_set_up(state_t *state, body_t *player1, body_t *player2, body_t
 void level_four_set_up(state_t *state, body_t *player1, body_t *player2, body_t *block){
   state->scene_num = LEVEL4;
   state->last_lvl = LEVEL4;
-  add_level_four_platforms(state->scene, player1, player2, block);
+  add_level_four_platforms(state->scene);
   add_level_four_obstacles(state->scene, player1, player2);
   add_level_four_gems(state->scene, player1, player2);
   add_doors(state, player1, player2, (vector_t)LEVEL_FOUR_DOOR1, (vector_t)LEVEL_FOUR_DOOR2);
   add_button(state, player1, player2, block, (vector_t)LEVEL_FOUR_BUTTON);
-  add_fan(state, player1, player2, (vector_t)LEVEL_FOUR_FAN1, LEVEL_FOUR_FAN1_LENGTH , LEVEL_FOUR_FAN1_HEIGHT);
-  add_fan(state, player1, player2, (vector_t)LEVEL_FOUR_FAN2, LEVEL_FOUR_FAN2_LENGTH, LEVEL_FOUR_FAN2_HEIGHT);
-  body_set_texture(scene_get_body(state->scene, scene_bodies(state->scene) - FANL_SHIFT), sdl_load_image("assets/wind4r.png"));
-  body_set_texture(scene_get_body(state->scene, scene_bodies(state->scene) - FANF_SHIFT), sdl_load_image("assets/wind4l.png"));
+  state->fan1 = add_fan(state, player1, player2, (vector_t)LEVEL_FOUR_FAN1, LEVEL_FOUR_FAN1_LENGTH , LEVEL_FOUR_FAN1_HEIGHT);
+  state->fan2 = add_fan(state, player1, player2, (vector_t)LEVEL_FOUR_FAN2, LEVEL_FOUR_FAN2_LENGTH, LEVEL_FOUR_FAN2_HEIGHT);
+  body_set_texture(scene_resolve(state->scene, state->fan2), sdl_load_image("assets/wind4r.png"));
+  body_set_texture(scene_resolve(state->scene, state->fan1), sdl_load_image("assets/wind4l.png"));
   body_set_centroid(player1, (vector_t) LEVEL_FOUR_BODY1_CENTROID);
   body_set_centroid(player2, (vector_t) LEVEL_FOUR_BODY2_CENTROID);
   body_set_centroid(block, (vector_t) LEVEL_FOUR_BLOCK);
@@ -391,51 +411,44 @@ void init_levels(state_t *state, size_t lvl) {
 
   body_t *player1 = body_init_more_info(draw_rect((vector_t){0,0}, PLAYER_LENGTH, PLAYER_HEIGHT), PLAYER_MASS, YLLOW, PLAYER_LENGTH, PLAYER_HEIGHT);
   body_set_texture(player1, sdl_load_image("assets/starshine.png"));
-  scene_add_body(state->scene, player1);
+  state->player1 = scene_add_body(state->scene, player1);
   
   body_t *player2 = body_init_more_info(draw_rect((vector_t){0,0}, PLAYER_LENGTH, PLAYER_HEIGHT), PLAYER_MASS, BLU, PLAYER_LENGTH, PLAYER_HEIGHT);
   body_set_texture(player2, sdl_load_image("assets/moonbeam.png"));
-  scene_add_body(state->scene, player2);
+  state->player2 = scene_add_body(state->scene, player2);
+  scene_add_player(state->scene, state->player1);
+  scene_add_player(state->scene, state->player2);
 
   body_t *block = body_init_more_info(draw_rect((vector_t){0,0}, BLOCK_LENGTH, BLOCK_LENGTH), BLOCK_MASS, GRAY, BLOCK_LENGTH, BLOCK_LENGTH);
   body_set_texture(block, sdl_load_image("assets/block.png"));
-  scene_add_body(state->scene, block);
+  state->block = scene_add_body(state->scene, block);
   
   body_t *ground = body_init_more_info(
     draw_rect((vector_t){WINDOW.x / 2, WALL_HEIGHT/2}, WINDOW.x, WALL_HEIGHT),
     WALL_MASS, BLACK, WINDOW.x, WALL_HEIGHT);
-  scene_add_hidden_body(state->scene, ground);
-
-  create_plat_collision(state->scene, GRAV_CONST, player1, ground);
-  create_plat_collision(state->scene, GRAV_CONST, player2, ground);
-  create_plat_collision(state->scene, GRAV_CONST, block, ground);
+  scene_add_static_body(state->scene, ground);
 
   body_t *ceiling = body_init_more_info(
     draw_rect((vector_t){WINDOW.x / 2, WINDOW.y - WALL_HEIGHT/2}, WINDOW.x, WALL_HEIGHT),
     WALL_MASS, BLACK, WINDOW.x, WALL_HEIGHT);
-  scene_add_hidden_body(state->scene, ceiling);
-  create_plat_collision(state->scene, GRAV_CONST, player1, ceiling);
-  create_plat_collision(state->scene, GRAV_CONST, player2, ceiling);
-  create_plat_collision(state->scene, GRAV_CONST, block, ceiling);
+  scene_add_static_body(state->scene, ceiling);
 
   body_t *left_wall = body_init_more_info(
       draw_rect((vector_t){WALL_HEIGHT/2, WINDOW.y/2}, WALL_HEIGHT, WINDOW.y),
       WALL_MASS, BLACK, WALL_HEIGHT, WINDOW.y);
-  scene_add_hidden_body(state->scene, left_wall);
-  create_plat_collision(state->scene, GRAV_CONST, player1, left_wall);
-  create_plat_collision(state->scene, GRAV_CONST, player2, left_wall);
-  create_plat_collision(state->scene, GRAV_CONST, block, left_wall);
+  scene_add_static_body(state->scene, left_wall);
 
   body_t *right_wall = body_init_more_info(
       draw_rect((vector_t){WINDOW.x - WALL_HEIGHT/2, WINDOW.y/2}, WALL_HEIGHT, WINDOW.y),
       WALL_MASS, BLACK, WALL_HEIGHT, WINDOW.y);
-  scene_add_hidden_body(state->scene, right_wall);
-  create_plat_collision(state->scene, GRAV_CONST, player1, right_wall);
-  create_plat_collision(state->scene, GRAV_CONST, player2, right_wall); 
-  create_plat_collision(state->scene, GRAV_CONST, block, right_wall);
+  scene_add_static_body(state->scene, right_wall);
+
+  create_static_plat_collision(state->scene, player1);
+  create_static_plat_collision(state->scene, player2);
+  create_static_plat_collision(state->scene, block);
 
-  create_plat_collision(state->scene, GRAV_CONST, player1, block);
-  create_plat_collision(state->scene, GRAV_CONST, player2, block);
+  create_plat_collision(state->scene, player1, block);
+  create_plat_collision(state->scene, player2, block);
 
   if (lvl == LEVEL1) { 
     body_set_texture(b, sdl_load_image("assets/level1.png"));
@@ -469,6 +482,42 @@ void init_levels(state_t *state, size_t lvl) {
     level_four_set_up(state, player1, player2, block);
   }
   music_play("assets/background.wav", -1);
+  scene_free_snapshot(state->checkpoint);
+  state->checkpoint = scene_snapshot(state->scene, &state->checkpoint_size);
+}
+
+/**
+ * Restarts the level kept from the lose screen by restoring its checkpoint,
+ * which also brings back any gems collected since.
+ * Returns false if there is no level to restore, or the checkpoint could
+ * not copy the level, and the level has to be rebuilt instead.
+ */
+bool restart_level(state_t *state) {
+  if (state->level_scene == NULL ||
+      !scene_restore(state->level_scene, state->checkpoint,
+                     state->checkpoint_size)) {
+    return false;
+  }
+  scene_free(state->scene);
+  state->scene = state->level_scene;
+  state->level_scene = NULL;
+  state->scene_num = state->last_lvl;
+  state->time_elapsed = 0;
+  state->grav = false;
+  state->curr_gem_ct = 0;
+  state->start_time = SDL_GetTicks();
+  music_play("assets/background.wav", -1);
+  return true;
+}
+
+/**
+ * Frees the level kept from the lose screen, if any.
+ */
+void discard_level(state_t *state) {
+  if (state->level_scene != NULL) {
+    scene_free(state->level_scene);
+    state->level_scene = NULL;
+  }
 }
 
 void map(state_t *s) {
@@ -480,22 +529,24 @@ void map(state_t *s) {
                                   WINDOW.x, WINDOW.y);
   body_set_texture(b, sdl_load_image("assets/home.png"));
   scene_add_body(s->scene, b);
-  body_t *b1 = body_init_more_info(draw_rect((vector_t){3 * WINDOW.x/8, 11 * WINDOW.y/16}, BLOCK_LENGTH, BLOCK_LENGTH), WALL_MASS, BLACK,
-                                   BLOCK_LENGTH, BLOCK_LENGTH);
+  shape_t *block = shape_init(draw_rect(VEC_ZERO, BLOCK_LENGTH, BLOCK_LENGTH));
+  body_t *b1 = body_init_with_shape(block, (vector_t){3 * WINDOW.x/8, 11 * WINDOW.y/16}, WALL_MASS, BLACK,
+                                    BLOCK_LENGTH, BLOCK_LENGTH);
   scene_add_body(s->scene, b1);
   body_set_texture(b1, sdl_load_image(s->lvl1));
-  body_t *b2 = body_init_more_info(draw_rect((vector_t){5 * WINDOW.x/8, 11 * WINDOW.y/16}, BLOCK_LENGTH, BLOCK_LENGTH), WALL_MASS, BLACK,
-                                   BLOCK_LENGTH, BLOCK_LENGTH);
+  body_t *b2 = body_init_with_shape(block, (vector_t){5 * WINDOW.x/8, 11 * WINDOW.y/16}, WALL_MASS, BLACK,
+                                    BLOCK_LENGTH, BLOCK_LENGTH);
   scene_add_body(s->scene, b2);
   body_set_texture(b2, sdl_load_image(s->lvl2));
-  body_t *b3 = body_init_more_info(draw_rect((vector_t){3 * WINDOW.x/8, 7 * WINDOW.y/16}, BLOCK_LENGTH, BLOCK_LENGTH), WALL_MASS, BLACK,
-                                   BLOCK_LENGTH, BLOCK_LENGTH);
+  body_t *b3 = body_init_with_shape(block, (vector_t){3 * WINDOW.x/8, 7 * WINDOW.y/16}, WALL_MASS, BLACK,
+                                    BLOCK_LENGTH, BLOCK_LENGTH);
   scene_add_body(s->scene, b3);
   body_set_texture(b3, sdl_load_image(s->lvl3));
-  body_t *b4 = body_init_more_info(draw_rect((vector_t){5 * WINDOW.x/8, 7 * WINDOW.y/16}, BLOCK_LENGTH, BLOCK_LENGTH), WALL_MASS, BLACK,
-                                   BLOCK_LENGTH, BLOCK_LENGTH);
+  body_t *b4 = body_init_with_shape(block, (vector_t){5 * WINDOW.x/8, 7 * WINDOW.y/16}, WALL_MASS, BLACK,
+                                    BLOCK_LENGTH, BLOCK_LENGTH);
   scene_add_body(s->scene, b4);
   body_set_texture(b4, sdl_load_image(s->lvl4));
+  shape_release(block);
   music_play("assets/map.wav", -1);
 }
 
@@ -523,6 +574,8 @@ void lose(state_t *s) {
   music_bkgd_stop();
   s->time_elapsed = 0;
   s->scene_num = LOSE;
+  discard_level(s);
+  s->level_scene = s->scene;
   s->scene = scene_init();
   body_t *b = body_init_more_info(draw_rect((vector_t){WINDOW.x/2, WINDOW.y/2}, WINDOW.x, WINDOW.y), WALL_MASS, BACKGROUND, WINDOW.x, WINDOW.y);
   scene_add_body(s->scene, b);
@@ -543,29 +596,22 @@ void instruct(state_t *s) {
 void on_mouse(state_t *s, double x, double y) {
   if (s->scene_num == MAP)
   {
-    if (x >= (3 * WINDOW.x/8 - BLOCK_LENGTH/2)/FACTOR + START_X && x <= (3 * WINDOW.x/8 + BLOCK_LENGTH/2)/FACTOR + START_X &&
-        y >= (1000 - (11 * WINDOW.y/16 + BLOCK_LENGTH/2))/FACTOR && y <= (1000 - (11 * WINDOW.y/16 - BLOCK_LENGTH/2))/FACTOR)
-    {
-      scene_free(s->scene);
-      init_levels(s, LEVEL1);
-    }
-    if (x >= (5 * WINDOW.x/8 - BLOCK_LENGTH/2)/FACTOR + START_X && x <= (5 * WINDOW.x/8 + BLOCK_LENGTH/2)/FACTOR + START_X &&
-        y >= (1000 - (11 * WINDOW.y/16 + BLOCK_LENGTH/2))/FACTOR && y <= (1000 - (11 * WINDOW.y/16 - BLOCK_LENGTH/2))/FACTOR)
-    {
-      scene_free(s->scene);
-      init_levels(s, LEVEL2);
-    }
-    if (x >= (3 * WINDOW.x/8 - BLOCK_LENGTH/2)/FACTOR + START_X && x <= (3 * WINDOW.x/8 + BLOCK_LENGTH/2)/FACTOR + START_X &&
-        y >= (1000 - (7 * WINDOW.y/16 + BLOCK_LENGTH/2))/FACTOR && y <= (1000 - (7 * WINDOW.y/16 - BLOCK_LENGTH/2))/FACTOR)
-    {
-      scene_free(s->scene);
-      init_levels(s, LEVEL3);
+    // The level blocks are bodies LEVEL1 to LEVEL4 of the map scene
+    vector_t point = {(x - START_X) * FACTOR, WINDOW.y - y * FACTOR};
+    list_t *clicked = list_init(LEVEL4 + 1, NULL);
+    scene_query_point(s->scene, point, clicked);
+    size_t level = MAP;
+    for (size_t i = 0; i < list_size(clicked); i++) {
+      for (size_t lvl = LEVEL1; lvl <= LEVEL4; lvl++) {
+        if (list_get(clicked, i) == scene_get_body(s->scene, lvl)) {
+          level = lvl;
+        }
+      }
     }
-    if (x >= (5 * WINDOW.x/8 - BLOCK_LENGTH/2)/FACTOR + START_X && x <= (5 * WINDOW.x/8 + BLOCK_LENGTH/2)/FACTOR + START_X &&
-        y >= (WINDOW.y - (7 * WINDOW.y/16 + BLOCK_LENGTH/2))/FACTOR && y <= (WINDOW.y - (7 * WINDOW.y/16 - BLOCK_LENGTH/2))/FACTOR)
-    {
+    list_free(clicked);
+    if (level != MAP) {
       scene_free(s->scene);
-      init_levels(s, LEVEL4);
+      init_levels(s, level);
     }
     if (x >= (WINDOW.x/2 - BLOCK_LENGTH * 2)/FACTOR + START_X && x <= (WINDOW.x/2 + BLOCK_LENGTH * 2)/FACTOR + START_X &&
         y >= (WINDOW.y - (WINDOW.y/4 + BLOCK_LENGTH/2))/FACTOR && y <= (WINDOW.y - (WINDOW.y/4 - BLOCK_LENGTH/2))/FACTOR)
@@ -586,12 +632,16 @@ void on_mouse(state_t *s, double x, double y) {
     if (x >= (WINDOW.x/2 - BLOCK_LENGTH * 2)/FACTOR + START_X && x <= (WINDOW.x/2 + BLOCK_LENGTH * 2)/FACTOR + START_X &&
         y >= (WINDOW.y - (3 * WINDOW.y/8 + BLOCK_LENGTH/2))/FACTOR && y <= (WINDOW.y - (3 * WINDOW.y/8 - BLOCK_LENGTH/2))/FACTOR)
     {
-      scene_free(s->scene);
-      init_levels(s, s->last_lvl);
+      if (!restart_level(s)) {
+        discard_level(s);
+        scene_free(s->scene);
+        init_levels(s, s->last_lvl);
+      }
     }
     if (x >= (WINDOW.x/2 - BLOCK_LENGTH * 2)/FACTOR + START_X && x <= (WINDOW.x/2 + BLOCK_LENGTH * 2)/FACTOR + START_X &&
         y >= (WINDOW.y - (WINDOW.y/4 + BLOCK_LENGTH/2))/FACTOR && y <= (WINDOW.y - (WINDOW.y/4 - BLOCK_LENGTH/2))/FACTOR)
     {
+      discard_level(s);
       scene_free(s->scene);
       map(s);
     }
@@ -662,6 +712,9 @@ state_t *emscripten_init() {
   state->fan_off = false;
   state->grav = false;
   state->scene_num = 0;
+  state->level_scene = NULL;
+  state->checkpoint = NULL;
+  state->checkpoint_size = 0;
 
   map(state);
   return state;
@@ -670,6 +723,13 @@ state_t *emscripten_init() {
 void emscripten_main(state_t *state) {
   sdl_render_scene(state->scene);
   check_display_timer(state);
+  if (state->scene_num >= LEVEL1 && state->scene_num <= LEVEL4) {
+    // Standing on a button switches the fans off
+    bool fans_off = body_get_fan(scene_resolve(state->scene, state->player1)) ||
+                    body_get_fan(scene_resolve(state->scene, state->player2)) ||
+                    body_get_fan(scene_resolve(state->scene, state->block));
+    scene_set_tag_enabled(state->scene, FAN_TAG, !fans_off);
+  }
   scene_tick(state->scene, time_since_last_tick());
   check_gem(state);
   
@@ -684,43 +744,49 @@ void emscripten_main(state_t *state) {
     draw_win(state->display_time, state->curr_gem_ct, calculate_grade(state));
   }
   if (state->scene_num == LEVEL2) {
-    if (!(state->fan_off) && (body_get_fan(scene_get_body(state->scene, PLAYER1)) || body_get_fan(scene_get_body(state->scene, PLAYER2)) || body_get_fan(scene_get_body(state->scene, BLOCK_NUM)))) {
-      body_set_texture(scene_get_body(state->scene, scene_bodies(state->scene) - FANL_SHIFT), sdl_load_image("assets/twind2.png"));
+    if (!(state->fan_off) && (body_get_fan(scene_resolve(state->scene, state->player1)) || body_get_fan(scene_resolve(state->scene, state->player2)) || body_get_fan(scene_resolve(state->scene, state->block)))) {
+      body_set_texture(scene_resolve(state->scene, state->fan1), sdl_load_image("assets/twind2.png"));
       state->fan_off = true;
     }
-    else if (state->fan_off && !body_get_fan(scene_get_body(state->scene, PLAYER1)) && !body_get_fan(scene_get_body(state->scene, PLAYER2)) && !body_get_fan(scene_get_body(state->scene, BLOCK_NUM))) {
-      body_set_texture(scene_get_body(state->scene, scene_bodies(state->scene) - FANL_SHIFT), sdl_load_image("assets/wind2.png"));
+    else if (state->fan_off && !body_get_fan(scene_resolve(state->scene, state->player1)) && !body_get_fan(scene_resolve(state->scene, state->player2)) && !body_get_fan(scene_resolve(state->scene, state->block))) {
+      body_set_texture(scene_resolve(state->scene, state->fan1), sdl_load_image("assets/wind2.png"));
       state->fan_off = false;
     }
   }
   if (state->scene_num == LEVEL3) {
-    if (!(state->fan_off) && (body_get_fan(scene_get_body(state->scene, PLAYER1)) || body_get_fan(scene_get_body(state->scene, PLAYER2)) || body_get_fan(scene_get_body(state->scene, BLOCK_NUM)))) {
-      body_set_texture(scene_get_body(state->scene, scene_bodies(state->scene) - FANL_SHIFT), sdl_load_image("assets/twind3.png"));
-      body_set_texture(scene_get_body(state->scene, scene_bodies(state->scene) - FANF_SHIFT), sdl_load_image("assets/twind3.png"));
+    if (!(state->fan_off) && (body_get_fan(scene_resolve(state->scene, state->player1)) || body_get_fan(scene_resolve(state->scene, state->player2)) || body_get_fan(scene_resolve(state->scene, state->block)))) {
+      body_set_texture(scene_resolve(state->scene, state->fan2), sdl_load_image("assets/twind3.png"));
+      body_set_texture(scene_resolve(state->scene, state->fan1), sdl_load_image("assets/twind3.png"));
       state->fan_off = true;
     }
-    else if (state->fan_off && !body_get_fan(scene_get_body(state->scene, PLAYER1)) && !body_get_fan(scene_get_body(state->scene, PLAYER2)) && !body_get_fan(scene_get_body(state->scene, BLOCK_NUM))) {
-      body_set_texture(scene_get_body(state->scene, scene_bodies(state->scene) - FANL_SHIFT), sdl_load_image("assets/wind3.png"));
-      body_set_texture(scene_get_body(state->scene, scene_bodies(state->scene) - FANF_SHIFT), sdl_load_image("assets/wind3.png"));
+    else if (state->fan_off && !body_get_fan(scene_resolve(state->scene, state->player1)) && !body_get_fan(scene_resolve(state->scene, state->player2)) && !body_get_fan(scene_resolve(state->scene, state->block))) {
+      body_set_texture(scene_resolve(state->scene, state->fan2), sdl_load_image("assets/wind3.png"));
+      body_set_texture(scene_resolve(state->scene, state->fan1), sdl_load_image("assets/wind3.png"));
       state->fan_off = false;
     }
   }
   if (state->scene_num == LEVEL4) {
-    if (!(state->fan_off) && (body_get_fan(scene_get_body(state->scene, PLAYER1)) || body_get_fan(scene_get_body(state->scene, PLAYER2)) || body_get_fan(scene_get_body(state->scene, BLOCK_NUM)))) {
-      body_set_texture(scene_get_body(state->scene, scene_bodies(state->scene) - FANL_SHIFT), sdl_load_image("assets/twind4r.png"));
-      body_set_texture(scene_get_body(state->scene, scene_bodies(state->scene) - FANF_SHIFT), sdl_load_image("assets/twind4l.png"));
+    if (!(state->fan_off) && (body_get_fan(scene_resolve(state->scene, state->player1)) || body_get_fan(scene_resolve(state->scene, state->player2)) || body_get_fan(scene_resolve(state->scene, state->block)))) {
+      body_set_texture(scene_resolve(state->scene, state->fan2), sdl_load_image("assets/twind4r.png"));
+      body_set_texture(scene_resolve(state->scene, state->fan1), sdl_load_image("assets/twind4l.png"));
       state->fan_off = true;
     }
-    else if (state->fan_off && !body_get_fan(scene_get_body(state->scene, PLAYER1)) && !body_get_fan(scene_get_body(state->scene, PLAYER2)) && !body_get_fan(scene_get_body(state->scene, BLOCK_NUM))) {
-      body_set_texture(scene_get_body(state->scene, scene_bodies(state->scene) - FANL_SHIFT), sdl_load_image("assets/wind4r.png"));
-      body_set_texture(scene_get_body(state->scene, scene_bodies(state->scene) - FANF_SHIFT), sdl_load_image("assets/wind4l.png"));
+    else if (state->fan_off && !body_get_fan(scene_resolve(state->scene, state->player1)) && !body_get_fan(scene_resolve(state->scene, state->player2)) && !body_get_fan(scene_resolve(state->scene, state->block))) {
+      body_set_texture(scene_resolve(state->scene, state->fan2), sdl_load_image("assets/wind4r.png"));
+      body_set_texture(scene_resolve(state->scene, state->fan1), sdl_load_image("assets/wind4l.png"));
       state->fan_off = false;
     }
   }
   state->time_elapsed += 1;
 }
 
+scene_t *emscripten_get_scene(state_t *state) {
+  return state->scene;
+}
+
 void emscripten_free(state_t *state) {
+  discard_level(state);
+  scene_free_snapshot(state->checkpoint);
   scene_free(state->scene);
   free(state);
 }
\ No newline at end of file
@@ -91,6 +91,10 @@ void emscripten_main(state_t *state) {
   scene_tick(state->scene, time_since_last_tick());
 }
 
+scene_t *emscripten_get_scene(state_t *state) {
+  return state->scene;
+}
+
 void emscripten_free(state_t *state) {
   scene_free(state->scene);
   free(state);
@@ -168,6 +168,10 @@ void emscripten_main(state_t *s) {
   }
 }
 
+scene_t *emscripten_get_scene(state_t *s) {
+  return s->scene;
+}
+
 void emscripten_free(state_t *s) {
   scene_free(s->scene);
   free(s);
@@ -170,6 +170,7 @@ void add_ball(scene_t *scene) {
     body_t *ball = get_ball(ball_center, START_VELOCITY);
     size_t body_count = scene_bodies(scene);
     scene_add_body(scene, ball);
+    scene_reserve_forces(scene, FORCE_PHASE_IMPULSE, body_count);
 
     // Add force creators with other bodies
     for (size_t i = 0; i < body_count; i++) {
@@ -197,6 +198,8 @@ void add_ball(scene_t *scene) {
 /** Adds the pegs to the scene */
 void add_pegs(scene_t *scene) {
     // Add N_ROWS and N_COLS of pegs.
+    // Row i has i + 1 pegs
+    scene_reserve_bodies(scene, N_ROWS * (N_ROWS + 3) / 2);
     for (size_t i = 1; i <= N_ROWS; i++) {
         for (size_t j = 0; j <= i; j++) {
             list_t *polygon = circle_init(PEG_RADIUS);
@@ -276,6 +279,10 @@ void emscripten_main(state_t *state) {
     sdl_render_scene(state->scene);
 }
 
+scene_t *emscripten_get_scene(state_t *state) {
+    return state->scene;
+}
+
 void emscripten_free(state_t *state) {
     scene_free(state->scene);
     free(state);
@@ -4,6 +4,7 @@
 #include "scene.h"
 #include "sdl_wrapper.h"
 #include "star_body.h"
+#include <assert.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stdio.h>
@@ -139,6 +140,8 @@ void gen_bodies(state_t *state) {
       draw_player((vector_t){WINDOW.x / 2.0, PLAYER_HEIGHT + PLAYER_SHIFT}),
       1.0, NEON_GREEN, info_init(PLAYER_TYPE), (free_func_t)info_free);
   scene_add_body(state->scene, player);
+  body_t **invaders = malloc(NUM_BODIES * NUM_LINES * sizeof(body_t *));
+  assert(invaders != NULL);
   for (size_t i = 0; i < NUM_BODIES; i++) {
     for (size_t j = 0; j < NUM_LINES; j++) {
       vector_t center = (vector_t){
@@ -147,13 +150,14 @@ void gen_bodies(state_t *state) {
                (INVADER_RADIUS +
                 (INVADER_RADIUS + INVADER_RADIUS_IN + INVADER_GAP_VERT) * j)};
       info_t *info = info_init(INVADER_TYPE);
-      scene_add_body(state->scene,
-                     body_init_with_info(draw_invader(center), 1.0, GREY, info,
-                                         (free_func_t)info_free));
-      body_set_velocity(scene_get_body(state->scene, NUM_LINES * i + j + 1),
-                        (vector_t){.x = INVADER_SPEED, .y = 0.0});
+      body_t *invader = body_init_with_info(draw_invader(center), 1.0, GREY,
+                                            info, (free_func_t)info_free);
+      body_set_velocity(invader, (vector_t){.x = INVADER_SPEED, .y = 0.0});
+      invaders[NUM_LINES * i + j] = invader;
     }
   }
+  scene_add_bodies_n(state->scene, invaders, NUM_BODIES * NUM_LINES, NULL);
+  free(invaders);
 }
 
 void check_wall_invader(state_t *s) {
@@ -257,6 +261,10 @@ void emscripten_main(state_t *state) {
   }
 }
 
+scene_t *emscripten_get_scene(state_t *state) {
+  return state->scene;
+}
+
 void emscripten_free(state_t *state) {
   scene_free(state->scene);
   free(state);
@@ -0,0 +1,114 @@
+#ifndef __AABB_TREE_H__
+#define __AABB_TREE_H__
+
+#include "collision.h"
+#include "list.h"
+#include "vector.h"
+#include <stdbool.h>
+
+/**
+ * A dynamic bounding volume tree over axis-aligned boxes.
+ * Each leaf stores an item (usually a body) with a "fat" box: its bounds
+ * grown by a margin, so the leaf only needs to be reinserted once the item
+ * leaves the fat box. The tree is kept balanced with rotations.
+ */
+typedef struct aabb_tree aabb_tree_t;
+
+/**
+ * A function that gives the item to store in place of another,
+ * e.g. a body's copy in a cloned scene.
+ *
+ * @param context the context value passed along with the function
+ * @param item the item to replace
+ * @return the item to store instead
+ */
+typedef void *(*item_mapper_t)(void *context, void *item);
+
+/**
+ * Allocates an empty tree.
+ *
+ * @param margin how far each leaf's box extends past the bounds it is given
+ * @return a pointer to the newly allocated tree
+ */
+aabb_tree_t *aabb_tree_init(double margin);
+
+/**
+ * Releases the memory allocated for a tree.
+ * Does not free the items stored in it.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ */
+void aabb_tree_free(aabb_tree_t *tree);
+
+/**
+ * Copies a tree, including the ids of its leaves, replacing each item with
+ * mapper(context, item). This costs one copy of the nodes rather than
+ * an insertion per item.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param mapper a function giving each item's replacement
+ * @param context a value to pass to mapper
+ * @return a pointer to the newly allocated copy
+ */
+aabb_tree_t *aabb_tree_clone(aabb_tree_t *tree, item_mapper_t mapper,
+                             void *context);
+
+/**
+ * Adds an item to a tree.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param item the item to store
+ * @param box the item's bounds
+ * @return the id of the new leaf, to pass to aabb_tree_move()
+ *   and aabb_tree_remove()
+ */
+size_t aabb_tree_insert(aabb_tree_t *tree, void *item, aabb_t box);
+
+/**
+ * Removes an item from a tree.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param id the id returned by aabb_tree_insert()
+ */
+void aabb_tree_remove(aabb_tree_t *tree, size_t id);
+
+/**
+ * Updates the bounds of an item.
+ * The leaf is only reinserted if the new bounds leave its fat box.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param id the id returned by aabb_tree_insert()
+ * @param box the item's new bounds
+ * @return whether the leaf was reinserted
+ */
+bool aabb_tree_move(aabb_tree_t *tree, size_t id, aabb_t box);
+
+/**
+ * Gets the height of a tree, for checking its balance.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @return the number of levels below the root (0 for a lone leaf or no leaves)
+ */
+size_t aabb_tree_height(aabb_tree_t *tree);
+
+/**
+ * Finds every item whose fat box overlaps a box.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param box the region to search
+ * @param results a list to which the matching items are added
+ */
+void aabb_tree_query(aabb_tree_t *tree, aabb_t box, list_t *results);
+
+/**
+ * Finds every item whose fat box is crossed by a line segment.
+ *
+ * @param tree a pointer to a tree returned from aabb_tree_init()
+ * @param start the start of the segment
+ * @param end the end of the segment
+ * @param results a list to which the matching items are added
+ */
+void aabb_tree_raycast(aabb_tree_t *tree, vector_t start, vector_t end,
+                       list_t *results);
+
+#endif // #ifndef __AABB_TREE_H__
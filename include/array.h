@@ -0,0 +1,126 @@
+#ifndef __ARRAY_H__
+#define __ARRAY_H__
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Growable arrays of one element type, generated per type.
+ * Unlike list_t, which holds pointers to separately allocated values,
+ * an array holds its elements by value in one buffer, so filling it does not
+ * allocate per element and reading it does not chase pointers.
+ *
+ * ARRAY_DECLARE(type, name) declares the array type name_t and its functions
+ * in a header, and ARRAY_DEFINE(type, name) defines the functions in exactly
+ * one source file. For example, ARRAY_DECLARE(vector_t, vector_array)
+ * declares vector_array_t, vector_array_init(), vector_array_add(), etc.
+ *
+ * The struct is public so that arrays can be kept by value inside other
+ * structs or on the stack. Its items can be walked directly from
+ * name_begin() to name_end(), but they move when the array grows, so those
+ * pointers are only valid until the next add or reserve.
+ */
+#define ARRAY_DECLARE(type, name)                                              \
+  typedef struct name {                                                        \
+    type *items;                                                               \
+    size_t size;                                                               \
+    size_t capacity;                                                           \
+  } name##_t;                                                                  \
+                                                                               \
+  /* Initializes an empty array with room for initial_size elements */         \
+  void name##_init(name##_t *array, size_t initial_size);                      \
+  /* Releases the array's buffer; the array can be initialized again */       \
+  void name##_free(name##_t *array);                                           \
+  size_t name##_size(name##_t *array);                                         \
+  /* Asserts that the index is valid */                                        \
+  type name##_get(name##_t *array, size_t index);                              \
+  void name##_set(name##_t *array, size_t index, type value);                  \
+  void name##_add(name##_t *array, type value);                                \
+  /* Removes and returns an element, shifting the later ones down */           \
+  type name##_remove(name##_t *array, size_t index);                           \
+  /* Removes and returns an element, moving the last one into its place */     \
+  type name##_swap_remove(name##_t *array, size_t index);                      \
+  void name##_clear(name##_t *array);                                          \
+  void name##_reserve(name##_t *array, size_t capacity);                       \
+  void name##_shrink_to_fit(name##_t *array);                                  \
+  type *name##_begin(name##_t *array);                                         \
+  type *name##_end(name##_t *array);
+
+#define ARRAY_DEFINE(type, name)                                               \
+  void name##_init(name##_t *array, size_t initial_size) {                     \
+    array->capacity = initial_size > 0 ? initial_size : 1;                     \
+    array->items = malloc(array->capacity * sizeof(type));                     \
+    assert(array->items != NULL);                                              \
+    array->size = 0;                                                           \
+  }                                                                            \
+                                                                               \
+  void name##_free(name##_t *array) {                                          \
+    free(array->items);                                                        \
+    array->items = NULL;                                                       \
+    array->size = 0;                                                           \
+    array->capacity = 0;                                                       \
+  }                                                                            \
+                                                                               \
+  size_t name##_size(name##_t *array) { return array->size; }                  \
+                                                                               \
+  type name##_get(name##_t *array, size_t index) {                             \
+    assert(index < array->size);                                               \
+    return array->items[index];                                                \
+  }                                                                            \
+                                                                               \
+  void name##_set(name##_t *array, size_t index, type value) {                 \
+    assert(index < array->size);                                               \
+    array->items[index] = value;                                               \
+  }                                                                            \
+                                                                               \
+  void name##_reserve(name##_t *array, size_t capacity) {                      \
+    if (capacity <= array->capacity) {                                         \
+      return;                                                                  \
+    }                                                                          \
+    array->items = realloc(array->items, capacity * sizeof(type));             \
+    assert(array->items != NULL);                                              \
+    array->capacity = capacity;                                                \
+  }                                                                            \
+                                                                               \
+  void name##_add(name##_t *array, type value) {                               \
+    if (array->size == array->capacity) {                                      \
+      name##_reserve(array, array->capacity > 0 ? 2 * array->capacity : 1);    \
+    }                                                                          \
+    array->items[array->size++] = value;                                       \
+  }                                                                            \
+                                                                               \
+  type name##_remove(name##_t *array, size_t index) {                          \
+    assert(index < array->size);                                               \
+    type value = array->items[index];                                          \
+    memmove(&array->items[index], &array->items[index + 1],                    \
+            (array->size - index - 1) * sizeof(type));                         \
+    array->size--;                                                             \
+    return value;                                                              \
+  }                                                                            \
+                                                                               \
+  type name##_swap_remove(name##_t *array, size_t index) {                     \
+    assert(index < array->size);                                               \
+    type value = array->items[index];                                          \
+    array->items[index] = array->items[--array->size];                         \
+    return value;                                                              \
+  }                                                                            \
+                                                                               \
+  void name##_clear(name##_t *array) { array->size = 0; }                      \
+                                                                               \
+  void name##_shrink_to_fit(name##_t *array) {                                 \
+    size_t capacity = array->size > 0 ? array->size : 1;                       \
+    if (capacity >= array->capacity) {                                         \
+      return;                                                                  \
+    }                                                                          \
+    array->items = realloc(array->items, capacity * sizeof(type));             \
+    assert(array->items != NULL);                                              \
+    array->capacity = capacity;                                                \
+  }                                                                            \
+                                                                               \
+  type *name##_begin(name##_t *array) { return array->items; }                 \
+                                                                               \
+  type *name##_end(name##_t *array) { return array->items + array->size; }
+
+#endif // #ifndef __ARRAY_H__
@@ -1,10 +1,13 @@
 #ifndef __BODY_H__
 #define __BODY_H__
 
+#include "array.h"
 #include "color.h"
 #include "list.h"
+#include "shape.h"
 #include "vector.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_timer.h>
 #include <SDL2/SDL_image.h>
@@ -17,6 +20,45 @@
  */
 typedef struct body body_t;
 
+/**
+ * A growable array of body pointers (see array.h), e.g. the bodies a force
+ * acts on.
+ */
+ARRAY_DECLARE(body_t *, body_array)
+
+/**
+ * The positions, velocities, accelerations and accumulated forces and
+ * impulses of a group of bodies, stored as one array per component so that
+ * body_store_integrate() can tick them all in a single loop.
+ * Every body's physics state lives in a store: a new body has a store of its
+ * own, and a scene moves its bodies' state into a shared one.
+ * The body_* accessors work the same wherever the state is kept.
+ */
+typedef struct body_store body_store_t;
+
+/**
+ * The part of a body that changes as a scene runs, as plain data,
+ * for saving and restoring with body_get_state() and body_set_state().
+ * The body's shape, mass, color, texture and info are not included.
+ */
+typedef struct body_state {
+  vector_t centroid;
+  vector_t velocity;
+  vector_t acceleration;
+  double angle;
+  vector_t total_force;
+  vector_t total_impulse;
+  bool asleep;
+  size_t sleep_ticks;
+  bool removed;
+  bool lose;
+  bool win;
+  bool fan;
+  bool ground;
+  double pull_mass;
+  uint32_t field_mask;
+} body_state_t;
+
 /**
  * Initializes a body without any info.
  * Acts like body_init_with_info() where info and info_freer are NULL.
@@ -51,6 +93,33 @@ body_t *body_init_with_info(list_t *shape, double mass, rgb_color_t color,
  */
 body_t *body_init_more_info(list_t *shape, double mass, rgb_color_t color, double width, double height);
 
+/**
+ * Allocates memory for a body that shares an existing shape with other bodies.
+ * The body takes its own reference to the shape, so the caller may release
+ * theirs once all the bodies have been created. The body is initially at rest.
+ *
+ * @param shape the shape of the body, in local coordinates
+ * @param centroid where the shape's origin is placed
+ * @param mass the mass of the body (if INFINITY, stops the body from moving)
+ * @param color the color of the body, used to draw it on the screen
+ * @param width the width of the body (x direction)
+ * @param height the height of the body (y direction)
+ * @return a pointer to the newly allocated body
+ */
+body_t *body_init_with_shape(shape_t *shape, vector_t centroid, double mass,
+                             rgb_color_t color, double width, double height);
+
+/**
+ * Copies a body, e.g. for a speculative copy of its scene.
+ * The copy shares the original's shape, texture and info rather than
+ * copying them, so it is cheap to make. The bodies sharing them can be
+ * freed in any order; the last one to go frees the texture and info.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return a pointer to the newly allocated copy
+ */
+body_t *body_clone(body_t *body);
+
 /**
  * Releases the memory allocated for a body.
  *
@@ -67,6 +136,29 @@ void body_free(body_t *body);
  */
 list_t *body_get_shape(body_t *body);
 
+/**
+ * Gets the current shape of a body without copying it.
+ * The vertices are cached and only recomputed after the body moves or rotates.
+ * The returned list is owned by the body: it must not be modified or freed,
+ * and is only valid until the body next moves.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the polygon describing the body's current position
+ */
+list_t *body_borrow_shape(body_t *body);
+
+/**
+ * Gets the convex pieces a concave body's shape was decomposed into,
+ * placed at the body's current position and rotation.
+ * Like body_borrow_shape(), the list is owned by the body and is only valid
+ * until the body next moves.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return a list of convex pieces (each a list of vectors),
+ * or NULL if the body's shape is already convex
+ */
+list_t *body_get_pieces(body_t *body);
+
 /**
  * Gets the current center of mass of a body.
  * While this could be calculated with polygon_centroid(), that becomes too slow
@@ -238,12 +330,162 @@ void body_add_impulse(body_t *body, vector_t impulse);
  * The body should be translated at the *average* of the velocities before
  * and after the tick.
  * Resets the forces and impulses accumulated on the body.
+ * A body that stays nearly at rest for a number of ticks falls asleep;
+ * ticking a sleeping body only resets its accumulated forces and impulses.
  *
  * @param body the body to tick
  * @param dt the number of seconds elapsed since the last tick
  */
 void body_tick(body_t *body, double dt);
 
+/**
+ * Allocates memory for an empty store of body state.
+ *
+ * @param capacity the number of bodies to allocate space for at first
+ * @return a pointer to the newly allocated store
+ */
+body_store_t *body_store_init(size_t capacity);
+
+/**
+ * Releases the memory allocated for a store.
+ * Any bodies still in it must be freed first.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ */
+void body_store_free(body_store_t *store);
+
+/**
+ * Makes room in a store for at least a given number of bodies,
+ * so that adding up to that many never reallocates its arrays.
+ * Does nothing if the store already has room.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @param capacity the number of bodies to make room for
+ */
+void body_store_reserve(body_store_t *store, size_t capacity);
+
+/**
+ * Gets the number of bodies whose state is kept in a store.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @return the number of bodies
+ */
+size_t body_store_size(body_store_t *store);
+
+/**
+ * Moves a body's state into a store.
+ * Asserts that the body is not already in a shared store.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @param body a pointer to a body returned from body_init()
+ */
+void body_store_add(body_store_t *store, body_t *body);
+
+/**
+ * Moves a body's state out of a store into one of its own, so the body can
+ * live on outside it. The store's last body takes its place.
+ *
+ * @param store the store the body was added to
+ * @param body a pointer to a body returned from body_init()
+ */
+void body_store_remove(body_store_t *store, body_t *body);
+
+/**
+ * Removes a body from a store and frees it. Unlike body_store_remove(), the
+ * body's state is dropped rather than moved, so nothing is allocated.
+ * The store's last body takes its place.
+ *
+ * @param store the store the body was added to
+ * @param body a pointer to a body returned from body_init()
+ */
+void body_store_discard(body_store_t *store, body_t *body);
+
+/**
+ * Copies the state of every body in a store into an empty store, one array
+ * at a time, e.g. for a copy of the store's scene.
+ * Each copied state keeps its index, and belongs to no body until the body
+ * it came from is cloned with body_clone_into().
+ *
+ * @param store a pointer to an empty store returned from body_store_init()
+ * @param from the store to copy
+ */
+void body_store_copy_state(body_store_t *store, body_store_t *from);
+
+/**
+ * Copies a body like body_clone(), but keeps the copy's state in a store
+ * filled by body_store_copy_state() instead of allocating a store for it.
+ *
+ * @param body a body in the store that was copied
+ * @param store the store its state was copied into
+ * @return a pointer to the newly allocated copy
+ */
+body_t *body_clone_into(body_t *body, body_store_t *store);
+
+/**
+ * Integrates every awake body in a store over a tick, as body_tick() does,
+ * and resets the forces and impulses of all of them.
+ * Only the stored state is updated; body_finish_tick() must then be called
+ * on each body to finish its tick.
+ *
+ * @param store a pointer to a store returned from body_store_init()
+ * @param dt the number of seconds elapsed since the last tick
+ */
+void body_store_integrate(body_store_t *store, double dt);
+
+/**
+ * Finishes the tick of a body integrated by body_store_integrate():
+ * marks its shape as moved and updates whether it is asleep.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param dt the number of seconds passed to body_store_integrate()
+ */
+void body_finish_tick(body_t *body, double dt);
+
+/**
+ * Gets where a body's centroid was at the start of its last tick.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the centroid before the last call to body_tick() or
+ *   body_store_integrate()
+ */
+vector_t body_get_tick_start(body_t *body);
+
+/**
+ * Returns whether a body is asleep, i.e. has been at rest long enough that
+ * it is no longer integrated.
+ * A sleeping body wakes when its position, velocity or acceleration is
+ * changed, or when a nonzero force or impulse is applied to it.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return whether the body is asleep
+ */
+bool body_is_asleep(body_t *body);
+
+/**
+ * Wakes a sleeping body so that it is integrated again.
+ * Does nothing if the body is awake.
+ *
+ * @param body a pointer to a body returned from body_init()
+ */
+void body_wake(body_t *body);
+
+/**
+ * Puts a body to sleep immediately and stops it, e.g. because the bodies it
+ * is connected to have all come to rest.
+ *
+ * @param body a pointer to a body returned from body_init()
+ */
+void body_sleep(body_t *body);
+
+/**
+ * Returns whether a body is asleep or was at rest during its last tick,
+ * i.e. is on its way to falling asleep.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return whether the body is resting
+ */
+bool body_is_resting(body_t *body);
+
 /**
  * Marks a body for removal--future calls to body_is_removed() will return true.
  * Does not free the body.
@@ -381,5 +623,128 @@ double body_get_width(body_t *body);
  */
 free_func_t body_get_info_freer(body_t *body);
 
+/**
+ * Gets the id of the body's leaf in the spatial index of its scene.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the id last passed to body_set_proxy()
+ */
+size_t body_get_proxy(body_t *body);
+
+/**
+ * Records the id of the body's leaf in the spatial index of its scene.
+ * Only the scene should call this.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param proxy the id of the leaf
+ */
+void body_set_proxy(body_t *body, size_t proxy);
+
+/**
+ * Gets the index of the body's handle slot in its scene
+ * (see body_handle_t).
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the index last passed to body_set_slot()
+ */
+size_t body_get_slot(body_t *body);
+
+/**
+ * Records the index of the body's handle slot in its scene.
+ * Only the scene should call this.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param slot the index of the slot
+ */
+void body_set_slot(body_t *body, size_t slot);
+
+/**
+ * Gets a counter that increases every time the body's centroid or rotation
+ * changes. Two equal readings mean the body has not moved in between.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the number of times the body has moved
+ */
+size_t body_get_moves(body_t *body);
+
+/**
+ * Marks a body as fast, so its scene always checks the path it moves along
+ * each tick for walls instead of only its end position.
+ * Bodies that move more than half their size in a tick are checked anyway.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param fast whether the body's motion should always be swept
+ */
+void body_set_fast(body_t *body, bool fast);
+
+/**
+ * Gets whether a body was marked with body_set_fast().
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return whether the body's motion is always swept
+ */
+bool body_is_fast(body_t *body);
+
+/**
+ * Chooses which of its scene's force fields act on a body
+ * (see scene_add_field()). Bit i of the mask is set if field i acts on it.
+ * Bodies feel every field by default.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param mask the fields that act on the body
+ */
+void body_set_field_mask(body_t *body, uint32_t mask);
+
+/**
+ * Gets which of its scene's force fields act on a body.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the mask set with body_set_field_mask()
+ */
+uint32_t body_get_field_mask(body_t *body);
+
+/**
+ * Copies out the state of a body that changes as it moves and collides.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the body's current state
+ */
+body_state_t body_get_state(body_t *body);
+
+/**
+ * Puts a body back into a state returned by body_get_state().
+ * Counts as a move if the body's position or angle changes.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @param state the state to restore
+ */
+void body_set_state(body_t *body, body_state_t state);
+
+/**
+ * The starting value for hash_bytes().
+ */
+extern const uint64_t HASH_SEED;
+
+/**
+ * Mixes raw bytes into a hash (64-bit FNV-1a).
+ * Start from HASH_SEED.
+ *
+ * @param hash the hash so far
+ * @param bytes the bytes to mix in
+ * @param size the number of bytes
+ * @return the new hash
+ */
+uint64_t hash_bytes(uint64_t hash, const void *bytes, size_t size);
+
+/**
+ * Hashes a body's state (see body_get_state()) bit for bit, so any change
+ * to its motion or flags, however small, changes the hash.
+ * Used to check that two runs of a simulation stay identical.
+ *
+ * @param body a pointer to a body returned from body_init()
+ * @return the hash of the body's state
+ */
+uint64_t body_hash(body_t *body);
+
 #endif // #ifndef __BODY_H__
 
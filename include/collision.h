@@ -1,6 +1,7 @@
 #ifndef __COLLISION_H__
 #define __COLLISION_H__
 
+#include "body.h"
 #include "list.h"
 #include "vector.h"
 #include <stdbool.h>
@@ -19,8 +20,39 @@ typedef struct {
    * If collided is false, this value is undefined.
    */
   vector_t axis;
+  /**
+   * If the shapes are colliding, how far they overlap along the axis.
+   * If collided is false, this value is undefined.
+   */
+  double depth;
 } collision_info_t;
 
+/**
+ * An axis-aligned bounding box.
+ */
+typedef struct {
+  vector_t min;
+  vector_t max;
+} aabb_t;
+
+/**
+ * The result of sweeping a moving box against a fixed one.
+ */
+typedef struct {
+  /** Whether the moving box reaches the fixed box during the sweep */
+  bool hit;
+  /**
+   * The fraction of the displacement travelled at first contact, in [0, 1).
+   * If hit is false, this value is undefined.
+   */
+  double time;
+  /**
+   * The unit normal of the fixed box's face that is hit, pointing back
+   * towards the moving box. If hit is false, this value is undefined.
+   */
+  vector_t normal;
+} sweep_info_t;
+
 /**
  * Computes the status of the collision between two convex polygons.
  * The shapes are given as lists of vertices in counterclockwise order.
@@ -34,4 +66,47 @@ typedef struct {
  */
 collision_info_t find_collision(list_t *shape1, list_t *shape2);
 
+/**
+ * Computes the smallest axis-aligned box containing a shape.
+ *
+ * @param shape the list of vertices that make up the shape
+ * @return the bounding box of the shape
+ */
+aabb_t find_bounds(list_t *shape);
+
+/**
+ * Finds when a box moving in a straight line first touches a fixed box,
+ * e.g. to stop fast bodies from passing through thin walls in one tick.
+ * Boxes that already overlap at the start are not reported.
+ *
+ * @param moving the moving box at the start of its motion
+ * @param displacement how far the moving box travels
+ * @param fixed the box it may run into
+ * @return whether and when the boxes first touch, and the face that is hit
+ */
+sweep_info_t aabb_sweep(aabb_t moving, vector_t displacement, aabb_t fixed);
+
+/**
+ * Returns whether two axis-aligned boxes overlap.
+ *
+ * @param box1 the first box
+ * @param box2 the second box
+ * @return whether the boxes share any area
+ */
+bool aabb_overlap(aabb_t box1, aabb_t box2);
+
+/**
+ * Computes the status of the collision between two bodies.
+ * Unlike find_collision(), the bodies' shapes may be concave:
+ * a concave body is tested piece by piece using the convex pieces it was
+ * decomposed into (see body_get_pieces()), skipping pieces whose bounding
+ * boxes do not overlap. If several pieces collide, the deepest contact wins.
+ *
+ * @param body1 the first body
+ * @param body2 the second body
+ * @return whether the bodies are colliding, and if so, the collision axis
+ * (a unit vector pointing from body1 towards body2)
+ */
+collision_info_t find_body_collision(body_t *body1, body_t *body2);
+
 #endif // #ifndef __COLLISION_H__
@@ -0,0 +1,176 @@
+#ifndef __CONTACT_CACHE_H__
+#define __CONTACT_CACHE_H__
+
+#include "aabb_tree.h"
+#include "body.h"
+#include "collision.h"
+#include <stdbool.h>
+
+/**
+ * A cache of what is known about each pair of bodies that has been checked
+ * for collision, keyed by the pair: the last narrowphase result, whether the
+ * bodies were touching the previous tick, and the impulse the contact solver
+ * needed to keep them apart.
+ *
+ * The narrowphase result is reused until either body moves, so bodies
+ * resting on each other are not re-tested every tick, and the solver starts
+ * from the remembered impulse (see solver_solve()).
+ */
+typedef struct contact_cache contact_cache_t;
+
+/**
+ * How the contact between two bodies changed since the previous tick.
+ */
+typedef enum {
+  /** The bodies were apart and still are */
+  CONTACT_NONE,
+  /** The bodies started touching this tick */
+  CONTACT_ENTER,
+  /** The bodies were touching and still are */
+  CONTACT_STAY,
+  /** The bodies stopped touching this tick */
+  CONTACT_EXIT
+} contact_event_t;
+
+/**
+ * The result of checking a pair of bodies with contact_cache_collide().
+ */
+typedef struct contact_result {
+  /** The collision between the bodies, as find_body_collision() reports it */
+  collision_info_t collision;
+  /** How the contact changed since the previous tick */
+  contact_event_t event;
+} contact_result_t;
+
+/**
+ * Allocates an empty cache.
+ *
+ * @return a pointer to the newly allocated cache
+ */
+contact_cache_t *contact_cache_init(void);
+
+/**
+ * Replaces a cache's pairs with those of another cache whose bodies have
+ * been copied, e.g. for a cloned scene, so the copy reports the same events
+ * and reuses the same results.
+ * Pairs whose bodies have no replacement are left out.
+ *
+ * @param cache a pointer to a cache returned from contact_cache_init()
+ * @param from the cache to copy
+ * @param mapper a function giving each body's replacement, or NULL if it
+ *     has none
+ * @param context a value to pass to mapper
+ */
+void contact_cache_copy(contact_cache_t *cache, contact_cache_t *from,
+                        item_mapper_t mapper, void *context);
+
+/**
+ * Releases the memory allocated for a cache.
+ * Does not free any bodies.
+ *
+ * @param cache a pointer to a cache returned from contact_cache_init()
+ */
+void contact_cache_free(contact_cache_t *cache);
+
+/**
+ * Starts a new tick. Events are reported relative to the previous tick,
+ * and pairs that were apart and not checked during it are dropped.
+ *
+ * @param cache a pointer to a cache returned from contact_cache_init()
+ */
+void contact_cache_begin_tick(contact_cache_t *cache);
+
+/**
+ * Checks two bodies for collision.
+ * If neither body has moved since the pair was last checked,
+ * the previous result is returned without running the narrowphase again.
+ * Checking a pair several times in one tick reports the same event.
+ *
+ * @param cache a pointer to a cache returned from contact_cache_init()
+ * @param body1 the first body
+ * @param body2 the second body
+ * @return the collision, with its axis pointing from body1 towards body2,
+ *   and how the contact changed since the previous tick
+ */
+contact_result_t contact_cache_collide(contact_cache_t *cache, body_t *body1,
+                                       body_t *body2);
+
+/**
+ * Gets the event reported for two bodies the last time they were checked
+ * this tick.
+ *
+ * @param cache a pointer to a cache returned from contact_cache_init()
+ * @param body1 the first body
+ * @param body2 the second body
+ * @return the event, or CONTACT_NONE if the pair was not checked this tick
+ */
+contact_event_t contact_cache_event(contact_cache_t *cache, body_t *body1,
+                                    body_t *body2);
+
+/**
+ * Gets the number of checks this tick that reused a cached result.
+ *
+ * @param cache a pointer to a cache returned from contact_cache_init()
+ * @return the number of narrowphase tests skipped since the tick began
+ */
+size_t contact_cache_reused(contact_cache_t *cache);
+
+/**
+ * Gets the number of body pairs the cache is tracking.
+ *
+ * @param cache a pointer to a cache returned from contact_cache_init()
+ * @return the number of cached pairs
+ */
+size_t contact_cache_size(contact_cache_t *cache);
+
+/**
+ * Records the impulse the contact solver applied between two bodies.
+ *
+ * @param cache a pointer to a cache returned from contact_cache_init()
+ * @param body1 the first body of the contact
+ * @param body2 the second body of the contact
+ * @param impulse the magnitude of the impulse along the contact normal
+ */
+void contact_cache_set_impulse(contact_cache_t *cache, body_t *body1,
+                               body_t *body2, double impulse);
+
+/**
+ * Gets the impulse recorded between two bodies this tick.
+ *
+ * @param cache a pointer to a cache returned from contact_cache_init()
+ * @param body1 the first body of the contact
+ * @param body2 the second body of the contact
+ * @return the impulse, or 0 if none was recorded this tick
+ */
+double contact_cache_get_impulse(contact_cache_t *cache, body_t *body1,
+                                 body_t *body2);
+
+/**
+ * Gets the impulse recorded between two bodies the previous tick,
+ * which the solver uses as its starting guess.
+ *
+ * @param cache a pointer to a cache returned from contact_cache_init()
+ * @param body1 the first body of the contact
+ * @param body2 the second body of the contact
+ * @return the impulse, or 0 if none was recorded the previous tick
+ */
+double contact_cache_previous_impulse(contact_cache_t *cache, body_t *body1,
+                                      body_t *body2);
+
+/**
+ * Forgets every pair, e.g. after the bodies have been moved back to an
+ * earlier state, so nothing from the abandoned ticks is reused.
+ *
+ * @param cache a pointer to a cache returned from contact_cache_init()
+ */
+void contact_cache_clear(contact_cache_t *cache);
+
+/**
+ * Forgets every pair involving a body, e.g. before it is freed.
+ *
+ * @param cache a pointer to a cache returned from contact_cache_init()
+ * @param body the body to forget
+ */
+void contact_cache_forget(contact_cache_t *cache, body_t *body);
+
+#endif // #ifndef __CONTACT_CACHE_H__
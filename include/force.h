@@ -22,13 +22,31 @@ force_t *force_init(force_creator_t forcer, void *aux, free_func_t freer);
  * 
  * @param forcer applies the forces to bodies
  * @param aux auxiliary data
- * @param relevant_bodies the bodies impacted by the force
+ * @param relevant_bodies the bodies impacted by the force; the force copies
+ *   them and frees the list
  * @param freer used to free the auxiliary data
  * @return a pointer to the newly allocated force
  */
 force_t *force_init_with_bodies(force_creator_t forcer, void *aux,
                                 list_t *relevant_bodies, free_func_t freer);
 
+/**
+ * Initializes a force like force_init_with_bodies(), taking its relevant
+ * bodies from an array, so no list has to be built for them.
+ * Forces and their body arrays come from the size-class pools
+ * (see pool_alloc_sized()).
+ *
+ * @param forcer applies the forces to bodies
+ * @param aux auxiliary data
+ * @param bodies the bodies impacted by the force, which are copied
+ * @param num_bodies the number of bodies
+ * @param freer used to free the auxiliary data
+ * @return a pointer to the newly allocated force
+ */
+force_t *force_init_with_body_array(force_creator_t forcer, void *aux,
+                                    body_t **bodies, size_t num_bodies,
+                                    free_func_t freer);
+
 /**
  * Releases the memory allocated for a force.
  *
@@ -64,6 +82,58 @@ free_func_t get_freer(force_t *force);
  * Returns relavant bodies that the force is applied to.
  * 
  * @param force the force whose information is being retrieved
- * @return any bodies that the force affects
+ * @return any bodies that the force affects, or NULL if the force was
+ *   created without a list of bodies
+ */
+body_array_t *get_relevant_bodies(force_t *force);
+
+
+/**
+ * Sets the tag a force was registered with, so it can be enabled and
+ * disabled along with the other forces sharing the tag.
+ *
+ * @param force the force to tag
+ * @param tag the tag, or 0 for none
+ */
+void force_set_tag(force_t *force, size_t tag);
+
+/**
+ * Returns the tag a force was registered with.
+ *
+ * @param force the force whose information is being retrieved
+ * @return the force's tag, or 0 if it has none
+ */
+size_t force_get_tag(force_t *force);
+
+/**
+ * Enables or disables a force. Disabled forces are not run.
+ * Forces start enabled.
+ *
+ * @param force the force to change
+ * @param enabled whether the force should run
+ */
+void force_set_enabled(force_t *force, bool enabled);
+
+/**
+ * Returns whether a force is enabled.
+ *
+ * @param force the force whose information is being retrieved
+ * @return whether the force runs each tick
+ */
+bool force_is_enabled(force_t *force);
+
+/**
+ * Sets how to copy the force's auxiliary data when its scene is cloned.
+ *
+ * @param force the force to change
+ * @param cloner copies the auxiliary data, or NULL if it cannot be copied
+ */
+void force_set_cloner(force_t *force, aux_cloner_t cloner);
+
+/**
+ * Returns how to copy the force's auxiliary data when its scene is cloned.
+ *
+ * @param force the force whose information is being retrieved
+ * @return the cloner for the auxiliary data, or NULL
  */
-list_t *get_relevant_bodies(force_t *force);
+aux_cloner_t get_cloner(force_t *force);
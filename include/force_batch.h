@@ -0,0 +1,90 @@
+#ifndef __FORCE_BATCH_H__
+#define __FORCE_BATCH_H__
+
+#include "body.h"
+#include "islands.h"
+#include "scene.h"
+
+/**
+ * The scene's built-in forces, stored in one contiguous array per kind
+ * (see force_kind_t). Each kind is applied by a single loop over its array,
+ * instead of calling a force creator through a pointer for every force.
+ */
+typedef struct force_batch force_batch_t;
+
+/**
+ * Allocates an empty set of batches.
+ *
+ * @return a pointer to the newly allocated batches
+ */
+force_batch_t *force_batch_init(void);
+
+/**
+ * Releases the memory allocated for a set of batches.
+ * Does not free any bodies.
+ *
+ * @param batch a pointer to batches returned from force_batch_init()
+ */
+void force_batch_free(force_batch_t *batch);
+
+/**
+ * Copies a set of batches for a clone of their scene, pointing each force at
+ * the clone's copies of its bodies (see scene_find_clone()).
+ *
+ * @param batch a pointer to batches returned from force_batch_init()
+ * @param clone the scene the copy is for
+ * @return the copy, or NULL if some body has no copy in the clone
+ */
+force_batch_t *force_batch_clone(force_batch_t *batch, scene_t *clone);
+
+/**
+ * Adds a force to the batch for its kind.
+ *
+ * @param batch a pointer to batches returned from force_batch_init()
+ * @param kind the kind of force
+ * @param constant the force's constant
+ * @param body1 the body the force acts on
+ * @param body2 the other body, or NULL for kinds that act on one body
+ */
+void force_batch_add(force_batch_t *batch, force_kind_t kind, double constant,
+                     body_t *body1, body_t *body2);
+
+/**
+ * Gets the number of forces of one kind.
+ *
+ * @param batch a pointer to batches returned from force_batch_init()
+ * @param kind the kind of force
+ * @return the number of forces of that kind
+ */
+size_t force_batch_size(force_batch_t *batch, force_kind_t kind);
+
+/**
+ * Removes every force that acts on a body, keeping the others in order.
+ *
+ * @param batch a pointer to batches returned from force_batch_init()
+ * @param body the body being removed
+ */
+void force_batch_remove_with(force_batch_t *batch, body_t *body);
+
+/**
+ * Applies every force of one kind. Forces whose bodies are all asleep or
+ * have infinite mass are skipped.
+ *
+ * @param batch a pointer to batches returned from force_batch_init()
+ * @param kind the kind of force to apply
+ * @param scene the scene the forces belong to, for the contact kinds
+ * @param skipped incremented once for each force skipped
+ * @return the number of forces applied
+ */
+size_t force_batch_apply(force_batch_t *batch, force_kind_t kind,
+                         scene_t *scene, size_t *skipped);
+
+/**
+ * Joins the islands of the bodies each force acts on.
+ *
+ * @param batch a pointer to batches returned from force_batch_init()
+ * @param islands the islands being built this tick
+ */
+void force_batch_connect(force_batch_t *batch, islands_t *islands);
+
+#endif // #ifndef __FORCE_BATCH_H__
@@ -16,11 +16,15 @@ typedef struct door_param door_param_t;
 
 typedef struct pulley_param pulley_param_t;
 
+/**
+ * Bodies closer than this do not attract each other under gravity.
+ */
+extern const double GRAVITY_MIN_DIST;
+
 void crt_gravity(void *aux);
 void crt_spring(void *aux);
 void crt_drag(void *aux);
 void crt_collision(void *aux);
-void crt_plat(void *aux);
 void crt_fall(void *aux);
 void crt_pulley(void *aux);
 
@@ -92,6 +96,7 @@ void create_drag(scene_t *scene, double gamma, body_t *body);
  * @param handler a function to call whenever the bodies collide
  * @param aux an auxiliary value to pass to the handler
  * @param freer if non-NULL, a function to call in order to free aux
+ *   The scene can only be cloned (see scene_clone()) if aux is NULL.
  */
 void create_collision(scene_t *scene, body_t *body1, body_t *body2,
                       collision_handler_t handler, void *aux,
@@ -108,8 +113,20 @@ void create_collision(scene_t *scene, body_t *body1, body_t *body2,
  */
 void create_fall(scene_t *scene, double gamma, body_t *body);
 
-
-void create_fan(scene_t *scene, double k, body_t *body1, body_t *body2);
+/**
+ * Adds a force creator to a scene that pushes body1 up while it overlaps
+ * body2, the fan's air stream, with an impulse proportional to its mass.
+ *
+ * @param scene the scene containing the bodies
+ * @param k the impulse per unit mass each tick, however the tick is split
+ *   into substeps
+ * @param body1 the body to push
+ * @param body2 the fan
+ * @param tag a tag for switching the fan on and off
+ *   (see scene_set_tag_enabled()), or 0 for none
+ */
+void create_fan(scene_t *scene, double k, body_t *body1, body_t *body2,
+                size_t tag);
 
 
 void create_button(scene_t *scene, body_t *body1, body_t *body2);
@@ -119,6 +136,8 @@ void create_button(scene_t *scene, body_t *body1, body_t *body2);
  * The bodies should be destroyed by calling body_remove().
  * This should be represented as an on-collision callback
  * registered with create_collision().
+ * It runs in FORCE_PHASE_IMPULSE, so the bounce does not change with
+ * substepping.
  *
  * @param scene the scene containing the bodies
  * @param body1 the first body
@@ -131,6 +150,8 @@ void create_destructive_collision(scene_t *scene, body_t *body1, body_t *body2);
  * to resolve collisions between two bodies in the scene.
  * This should be represented as an on-collision callback
  * registered with create_collision().
+ * It runs in FORCE_PHASE_IMPULSE, so the bounce does not change with
+ * substepping.
  *
  * You may remember from project01 that you should avoid applying impulses
  * multiple times while the bodies are still colliding.
@@ -146,8 +167,57 @@ void create_destructive_collision(scene_t *scene, body_t *body1, body_t *body2);
 void create_physics_collision(scene_t *scene, double elasticity, body_t *body1,
                               body_t *body2);
 
-void create_plat_collision(scene_t *scene, double G, body_t *body1,
-                                  body_t *body2);
+/**
+ * Adds a physics collision (see create_physics_collision()) between one body
+ * and each of a group of others, making room for all of them in the scene
+ * first.
+ *
+ * @param scene the scene containing the bodies
+ * @param elasticity the "coefficient of restitution" of the collisions
+ * @param body the body that collides with each of the others,
+ *   passed as body1 to each collision
+ * @param others the other bodies, each passed as body2
+ * @param num_others the number of other bodies
+ */
+void create_physics_collisions_batch(scene_t *scene, double elasticity,
+                                     body_t *body, body_t **others,
+                                     size_t num_others);
+
+/**
+ * Adds a force creator to a scene that keeps two bodies from passing through
+ * each other, e.g. a player standing on a block.
+ * Each tick the overlap between the bodies is handed to the scene's contact
+ * solver (see scene_add_contact()), which resolves it together with every
+ * other contact so that stacks of bodies settle quickly.
+ *
+ * @param scene the scene containing the bodies
+ * @param body1 the first body
+ * @param body2 the second body
+ */
+void create_plat_collision(scene_t *scene, body_t *body1, body_t *body2);
+
+/**
+ * Adds the contact between two bodies, if they overlap, to the scene's
+ * contact solver, with the normal pointing from body1 towards body2.
+ * This is what create_plat_collision() does each tick.
+ *
+ * @param scene the scene containing the bodies
+ * @param body1 the first body
+ * @param body2 the second body
+ */
+void add_plat_contact(scene_t *scene, body_t *body1, body_t *body2);
+
+/**
+ * Adds a force creator to a scene that keeps a body from passing through any
+ * of the scene's static bodies (see scene_add_static_body()), treating them
+ * as platforms the way create_plat_collision() does.
+ * Only the static bodies near the body are tested each tick, so one call
+ * covers every wall and platform, including ones added later.
+ *
+ * @param scene the scene containing the bodies
+ * @param body the dynamic body to collide with the static geometry
+ */
+void create_static_plat_collision(scene_t *scene, body_t *body);
 
 void create_door_collision(scene_t *scene, body_t *door_red, body_t *player1,
                                            body_t *door_blue, body_t *player2);
@@ -185,6 +255,17 @@ void handle_free(handle_param_t *h);
 void door_free(door_param_t *d);
 void pulley_free(pulley_param_t *p);
 
+/**
+ * Copy a force creator's auxiliary value for a clone of its scene
+ * (see scene_clone()), or return NULL if it refers to a body the clone
+ * does not have.
+ */
+void *two_clone(two_body_param_t *t, scene_t *clone);
+void *twos_clone(two_bodies_param_t *ts, scene_t *clone);
+void *handle_clone(handle_param_t *h, scene_t *clone);
+void *door_clone(door_param_t *d, scene_t *clone);
+void *pulley_clone(pulley_param_t *p, scene_t *clone);
+
 void disappear_handler(body_t *body1, body_t *body2, vector_t axis,
                          void *aux);
 
@@ -9,20 +9,30 @@
 #include "draw.h"
 #include "body.h"
 #include "scene.h"
+#include "shape.h"
 #include "vector.h"
 #include <stdlib.h>
 #include <stdio.h>
 
+/**
+ * Builds the shape shared by every gem in a level.
+ * The caller releases it with shape_release() once the gems are added.
+ *
+ * @return the gem shape, in local coordinates
+ */
+shape_t *gem_shape_init(void);
+
 /**
  * Adds a gem of a specific center that can collide with a player,
  * and has an image laid over it.
  * 
  * @param scene the scene that holds the bodies and forces
+ * @param shape the gem shape returned from gem_shape_init()
  * @param player1 the body that can collect the gem and make it disappear
  * @param center the center of the gem
  * @param draw the path for the image that represents the gem
  */
-void add_gem(scene_t *scene, body_t *player1, vector_t center, char *draw);
+void add_gem(scene_t *scene, shape_t *shape, body_t *player1, vector_t center, char *draw);
 
 /**
  * Adds gems specifically for level 1.
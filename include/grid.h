@@ -0,0 +1,53 @@
+#ifndef __GRID_H__
+#define __GRID_H__
+
+#include "body.h"
+#include "collision.h"
+#include "list.h"
+
+/**
+ * A uniform grid over a fixed set of bodies, used to quickly find the bodies
+ * whose bounding boxes overlap a region.
+ * The grid is built once from the bodies' current positions, so it is meant
+ * for bodies that do not move (walls, platforms, ...); rebuild it with
+ * grid_build() whenever the set of bodies changes.
+ */
+typedef struct grid grid_t;
+
+/**
+ * Allocates an empty grid.
+ *
+ * @param cell_size the width and height of each grid cell
+ * @return a pointer to the newly allocated grid
+ */
+grid_t *grid_init(double cell_size);
+
+/**
+ * Releases the memory allocated for a grid.
+ * Does not free the bodies it was built from.
+ *
+ * @param grid a pointer to a grid returned from grid_init()
+ */
+void grid_free(grid_t *grid);
+
+/**
+ * Rebuilds a grid from a list of bodies, replacing its previous contents.
+ * The grid stores pointers to the bodies, which must outlive it (or the next
+ * call to grid_build()).
+ *
+ * @param grid a pointer to a grid returned from grid_init()
+ * @param bodies the list of bodies to index
+ */
+void grid_build(grid_t *grid, list_t *bodies);
+
+/**
+ * Finds every indexed body whose bounding box overlaps a box.
+ * Each body is reported at most once.
+ *
+ * @param grid a pointer to a grid returned from grid_init()
+ * @param box the region to search
+ * @param results a list to which the matching bodies are added
+ */
+void grid_query(grid_t *grid, aabb_t box, list_t *results);
+
+#endif // #ifndef __GRID_H__
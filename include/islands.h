@@ -0,0 +1,111 @@
+#ifndef __ISLANDS_H__
+#define __ISLANDS_H__
+
+#include "body.h"
+#include "list.h"
+#include <stdbool.h>
+
+/**
+ * Groups bodies into islands: sets of bodies connected to each other through
+ * forces or contacts. Bodies in different islands cannot affect each other
+ * this tick, so each island can be put to sleep or woken as a whole.
+ * Bodies with infinite mass never move, so they do not connect islands.
+ *
+ * The islands are rebuilt every tick with a union-find structure:
+ * reset with the tick's bodies, connect them, then finish.
+ */
+typedef struct islands islands_t;
+
+/**
+ * Allocates an empty set of islands.
+ *
+ * @return a pointer to the newly allocated islands
+ */
+islands_t *islands_init(void);
+
+/**
+ * Releases the memory allocated for a set of islands.
+ * Does not free any bodies.
+ *
+ * @param islands a pointer to islands returned from islands_init()
+ */
+void islands_free(islands_t *islands);
+
+/**
+ * Starts over with each body with finite mass in its own island.
+ *
+ * @param islands a pointer to islands returned from islands_init()
+ * @param bodies the bodies to group
+ */
+void islands_reset(islands_t *islands, list_t *bodies);
+
+/**
+ * Joins the islands of two bodies.
+ * Bodies that were not passed to islands_reset() (or have infinite mass)
+ * are ignored.
+ *
+ * @param islands a pointer to islands returned from islands_init()
+ * @param body1 the first body
+ * @param body2 the second body
+ */
+void islands_connect(islands_t *islands, body_t *body1, body_t *body2);
+
+/**
+ * Joins the islands of all the bodies in a list, e.g. the bodies a force
+ * acts on.
+ *
+ * @param islands a pointer to islands returned from islands_init()
+ * @param bodies the bodies to join
+ */
+void islands_connect_all(islands_t *islands, list_t *bodies);
+
+/**
+ * Joins the islands of all the bodies in an array,
+ * like islands_connect_all().
+ *
+ * @param islands a pointer to islands returned from islands_init()
+ * @param bodies the bodies to join
+ * @param num_bodies the number of bodies
+ */
+void islands_connect_n(islands_t *islands, body_t **bodies,
+                       size_t num_bodies);
+
+/**
+ * Numbers the islands once all the connections have been made.
+ *
+ * @param islands a pointer to islands returned from islands_init()
+ * @return the number of islands
+ */
+size_t islands_finish(islands_t *islands);
+
+/**
+ * Returns whether two bodies are in the same island.
+ * Only valid after islands_finish().
+ *
+ * @param islands a pointer to islands returned from islands_init()
+ * @param body1 the first body
+ * @param body2 the second body
+ * @return whether both bodies were grouped and share an island
+ */
+bool islands_same(islands_t *islands, body_t *body1, body_t *body2);
+
+/**
+ * Stops tracking a body, e.g. before it is freed.
+ *
+ * @param islands a pointer to islands returned from islands_init()
+ * @param body the body to forget
+ */
+void islands_forget(islands_t *islands, body_t *body);
+
+/**
+ * Makes each island sleep or wake as a whole, after its bodies have ticked.
+ * An island with a moving body is woken entirely. An island where every body
+ * is resting and at least one has fallen asleep is put to sleep entirely.
+ * Only valid after islands_finish().
+ *
+ * @param islands a pointer to islands returned from islands_init()
+ * @return the number of islands that are asleep
+ */
+size_t islands_update_sleep(islands_t *islands);
+
+#endif // #ifndef __ISLANDS_H__
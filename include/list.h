@@ -1,6 +1,7 @@
 #ifndef __LIST_H__
 #define __LIST_H__
 
+#include <stdbool.h>
 #include <stddef.h>
 
 /**
@@ -16,6 +17,12 @@ typedef struct list list_t;
  */
 typedef void (*free_func_t)(void *);
 
+/**
+ * A test on a list element, e.g. for list_remove_if().
+ * The auxiliary value is passed through unchanged.
+ */
+typedef bool (*list_predicate_t)(void *value, void *aux);
+
 /**
  * Allocates memory for a new list with space for the given number of elements.
  * The list is initially empty.
@@ -65,13 +72,66 @@ void *list_get(list_t *list, size_t index);
 void *list_remove(list_t *list, size_t index);
 
 /**
- * Resizes the list if there is not enough space for a new element
- * to be added.
+ * Removes the element at a given index in a list and returns it,
+ * moving the last element into its place. Takes constant time, but does not
+ * keep the order of the remaining elements.
+ * Asserts that the index is valid, given the list's current size.
+ *
+ * @param list a pointer to a list returned from list_init()
+ * @param index the index of the element to remove
+ * @return the element at the given index in the list
+ */
+void *list_swap_remove(list_t *list, size_t index);
+
+/**
+ * Removes every element of a list that passes a test, keeping the order of
+ * the rest, in one pass over the list.
+ * The removed elements are passed to the list's freer, if it has one.
+ *
+ * @param list a pointer to a list returned from list_init()
+ * @param predicate the test; elements for which it returns true are removed
+ * @param aux an auxiliary value to pass to predicate
+ * @return the number of elements removed
+ */
+size_t list_remove_if(list_t *list, list_predicate_t predicate, void *aux);
+
+/**
+ * Grows the list by its growth factor (see list_set_growth()), so that
+ * there is space for a new element to be added.
+ * The array is grown in place when the allocator can, and otherwise copied
+ * once.
  *
  * @param list a pointer to a list returned from list_init()
  */
 void list_resize(list_t *list);
 
+/**
+ * Sets how much a list's capacity is multiplied by when it fills up.
+ * The default is 2. Asserts that the factor is greater than 1.
+ *
+ * @param list a pointer to a list returned from list_init()
+ * @param factor the new growth factor
+ */
+void list_set_growth(list_t *list, double factor);
+
+/**
+ * Makes room for at least a given number of elements in a list, in one
+ * allocation, so that adding up to that many never resizes it.
+ * Does nothing if the list already has room.
+ *
+ * @param list a pointer to a list returned from list_init()
+ * @param capacity the number of elements to make room for
+ */
+void list_reserve(list_t *list, size_t capacity);
+
+/**
+ * Releases the room a list has beyond its current elements,
+ * e.g. after removing most of them.
+ *
+ * @param list a pointer to a list returned from list_init()
+ */
+void list_shrink_to_fit(list_t *list);
+
 /**
  * Appends an element to the end of a list.
  * If the list is filled to capacity, resizes the list to fit more elements
@@ -3,6 +3,7 @@
 
 #include "list.h"
 #include "vector.h"
+#include <stdbool.h>
 
 typedef struct polygon {
   list_t *points;
@@ -57,4 +58,46 @@ void polygon_translate(list_t *polygon, vector_t translation);
  */
 void polygon_rotate(list_t *polygon, double angle, vector_t point);
 
+/**
+ * Returns whether a polygon is convex.
+ * Works for either winding order; collinear vertices are allowed.
+ *
+ * @param polygon the list of vertices that make up the polygon
+ * @return whether every interior angle of the polygon is at most 180 degrees
+ */
+bool polygon_is_convex(list_t *polygon);
+
+/**
+ * Splits a simple concave polygon into a small set of convex pieces
+ * (ear-clipping triangulation followed by Hertel-Mehlhorn merging).
+ * This is meant to run once when a shape is created, not every tick.
+ * Each piece keeps the winding order of the original polygon.
+ *
+ * @param polygon the list of vertices that make up the polygon
+ * @return a newly allocated list of pieces, each a list of vectors,
+ * or NULL if the polygon is already convex or cannot be triangulated
+ */
+list_t *polygon_convex_decompose(list_t *polygon);
+
+/**
+ * Returns whether a point lies inside a simple polygon (convex or not).
+ * Works for either winding order.
+ *
+ * @param polygon the list of vertices that make up the polygon
+ * @param point the point to test
+ * @return whether the point is inside the polygon
+ */
+bool polygon_contains(list_t *polygon, vector_t point);
+
+/**
+ * Casts a ray against the edges of a simple polygon.
+ *
+ * @param polygon the list of vertices that make up the polygon
+ * @param start the start of the ray
+ * @param direction a unit vector along the ray
+ * @return the distance along the ray to the first edge it crosses,
+ * 0 if the ray starts inside the polygon, or INFINITY if it misses
+ */
+double polygon_raycast(list_t *polygon, vector_t start, vector_t direction);
+
 #endif // #ifndef __POLYGON_H__
@@ -0,0 +1,89 @@
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#include <stddef.h>
+
+/**
+ * A pool of equally sized objects, carved out of slabs that each hold many
+ * of them. Released objects go on a free list and are handed out again by
+ * the next allocation, so once a pool has grown to its working size,
+ * allocating and releasing are a pointer pop and push with no calls to
+ * malloc() or free().
+ *
+ * Slabs are only returned to the system when the pool is freed.
+ * Under AddressSanitizer, released objects are poisoned, so using one after
+ * releasing it is still reported.
+ */
+typedef struct pool pool_t;
+
+/**
+ * Allocates an empty pool.
+ * Objects are rounded up so that a released one can hold the free list link.
+ *
+ * @param object_size the size of each object in bytes
+ * @param slab_objects the number of objects to allocate space for each time
+ *   the pool runs out
+ * @return a pointer to the newly allocated pool
+ */
+pool_t *pool_init(size_t object_size, size_t slab_objects);
+
+/**
+ * Releases the memory allocated for a pool, including every object still
+ * allocated from it.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ */
+void pool_free(pool_t *pool);
+
+/**
+ * Allocates an object from a pool. Its contents are undefined.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ * @return a pointer to the object
+ */
+void *pool_alloc(pool_t *pool);
+
+/**
+ * Returns an object to the pool it was allocated from.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ * @param object an object returned from pool_alloc() on the same pool
+ */
+void pool_release(pool_t *pool, void *object);
+
+/**
+ * Gets the number of objects allocated from a pool and not yet released.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ * @return the number of live objects
+ */
+size_t pool_live(pool_t *pool);
+
+/**
+ * Gets the number of objects a pool has room for, live or free.
+ *
+ * @param pool a pointer to a pool returned from pool_init()
+ * @return the total number of objects in the pool's slabs
+ */
+size_t pool_capacity(pool_t *pool);
+
+/**
+ * Allocates a small object from a shared pool for its size class
+ * (16, 32, 64 or 128 bytes). Larger objects come from malloc().
+ * For objects with many short-lived instances, such as forces and their
+ * parameters.
+ *
+ * @param size the size of the object in bytes
+ * @return a pointer to the object
+ */
+void *pool_alloc_sized(size_t size);
+
+/**
+ * Returns an object from pool_alloc_sized() to its size class.
+ *
+ * @param object an object returned from pool_alloc_sized()
+ * @param size the size it was allocated with
+ */
+void pool_release_sized(void *object, size_t size);
+
+#endif // #ifndef __POOL_H__
@@ -0,0 +1,149 @@
+#ifndef __REPLAY_H__
+#define __REPLAY_H__
+
+#include "scene.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * A recording of a session's input: the dt of every tick and the key and
+ * mouse events handled after it. Feeding the same events and dts back into
+ * a demo re-runs the session exactly, without a window or a real clock.
+ */
+typedef struct replay replay_t;
+
+/**
+ * The kinds of recorded events.
+ */
+typedef enum { REPLAY_TICK, REPLAY_KEY, REPLAY_MOUSE } replay_kind_t;
+
+/**
+ * A recorded event. Only the fields for its kind are used.
+ */
+typedef struct replay_event {
+  replay_kind_t kind;
+  // REPLAY_TICK: the time passed to the tick
+  double dt;
+  // REPLAY_KEY: the key handler's arguments
+  char key;
+  bool released;
+  double held_time;
+  // REPLAY_MOUSE: the mouse handler's arguments
+  double x;
+  double y;
+} replay_event_t;
+
+/**
+ * Allocates an empty recording.
+ *
+ * @return a pointer to the newly allocated recording
+ */
+replay_t *replay_init(void);
+
+/**
+ * Releases the memory allocated for a recording.
+ *
+ * @param replay a pointer to a recording returned from replay_init()
+ */
+void replay_free(replay_t *replay);
+
+/**
+ * Appends an event to a recording.
+ *
+ * @param replay a pointer to a recording returned from replay_init()
+ * @param event the event
+ */
+void replay_add(replay_t *replay, replay_event_t event);
+
+/**
+ * Gets the number of events in a recording.
+ *
+ * @param replay a pointer to a recording returned from replay_init()
+ * @return the number of events
+ */
+size_t replay_size(replay_t *replay);
+
+/**
+ * Gets the number of ticks in a recording.
+ *
+ * @param replay a pointer to a recording returned from replay_init()
+ * @return the number of REPLAY_TICK events
+ */
+size_t replay_ticks(replay_t *replay);
+
+/**
+ * Gets an event of a recording.
+ * Asserts that the index is valid.
+ *
+ * @param replay a pointer to a recording returned from replay_init()
+ * @param index the index of the event, in the order they were added
+ * @return the event
+ */
+replay_event_t replay_get(replay_t *replay, size_t index);
+
+/**
+ * Writes a recording to a binary stream.
+ * Each event takes a one-byte kind followed by only its kind's fields.
+ * Numbers are written in the machine's byte order.
+ *
+ * @param replay a pointer to a recording returned from replay_init()
+ * @param file the stream to write to
+ * @return whether the whole recording was written
+ */
+bool replay_write(replay_t *replay, FILE *file);
+
+/**
+ * Reads a recording written by replay_write().
+ *
+ * @param file the stream to read from
+ * @return the recording, or NULL if the stream is not a whole recording
+ */
+replay_t *replay_read(FILE *file);
+
+/**
+ * What differs between a scene and a line of a hash trace.
+ */
+typedef enum {
+  TRACE_MATCH,
+  // The trace has no line for the tick, or a different number of bodies
+  TRACE_MISSING,
+  // One of the scene's bodies (see scene_get_body())
+  TRACE_BODY,
+  TRACE_COUNTER,
+  TRACE_WIN,
+  TRACE_LOSE,
+  // Only the rest of the scene, i.e. its hidden or static bodies
+  TRACE_OTHER_BODIES
+} trace_diff_t;
+
+/**
+ * Writes one line of a hash trace: the tick, the scene's hash
+ * (see scene_hash()), its counter, win and lose flags, and the hash of each
+ * of its bodies.
+ * A trace from a trusted build can be checked against later builds with
+ * replay_check_hashes().
+ *
+ * @param file the stream to write the trace to
+ * @param tick the index of the tick that just ran
+ * @param scene the scene after the tick
+ */
+void replay_write_hashes(FILE *file, size_t tick, scene_t *scene);
+
+/**
+ * Reads the next line of a trace written by replay_write_hashes() and
+ * compares it with a scene.
+ * If several things differ, the bodies are reported before the counter and
+ * flags, and those before the hidden and static bodies.
+ *
+ * @param reference the stream to read the trace from
+ * @param tick the index of the tick that just ran
+ * @param scene the scene after the tick
+ * @param body set to the index of the first body that differs,
+ *   if TRACE_BODY is returned
+ * @return what differs, or TRACE_MATCH if the scene matches the trace
+ */
+trace_diff_t replay_check_hashes(FILE *reference, size_t tick,
+                                 scene_t *scene, size_t *body);
+
+#endif // #ifndef __REPLAY_H__
@@ -0,0 +1,84 @@
+#ifndef __SAP_H__
+#define __SAP_H__
+
+#include "body.h"
+#include "collision.h"
+#include "list.h"
+#include <stdbool.h>
+
+/**
+ * A sweep-and-prune broadphase along the x axis.
+ * It tracks moving bodies against a set of static bodies and finds every
+ * (moving, static) pair whose bounding boxes overlap.
+ * The endpoints of the bodies' x extents are kept sorted between updates;
+ * since bodies only move a little from one tick to the next, re-sorting them
+ * with insertion sort is close to linear.
+ * This suits wide levels with long thin platforms, which a grid has to copy
+ * into many cells.
+ */
+typedef struct sap sap_t;
+
+/**
+ * Allocates an empty sweep-and-prune structure.
+ *
+ * @return a pointer to the newly allocated structure
+ */
+sap_t *sap_init(void);
+
+/**
+ * Releases the memory allocated for a sweep-and-prune structure.
+ * Does not free the bodies it tracks.
+ *
+ * @param sap a pointer to a structure returned from sap_init()
+ */
+void sap_free(sap_t *sap);
+
+/**
+ * Starts tracking a body.
+ * Static bodies are assumed not to move; their bounds are only read here.
+ *
+ * @param sap a pointer to a structure returned from sap_init()
+ * @param body the body to track, which must outlive the structure
+ *   or be passed to sap_remove()
+ * @param is_static whether the body is part of the static set
+ */
+void sap_add(sap_t *sap, body_t *body, bool is_static);
+
+/**
+ * Stops tracking a body.
+ * Asserts that the body is tracked.
+ *
+ * @param sap a pointer to a structure returned from sap_init()
+ * @param body a body passed to sap_add()
+ */
+void sap_remove(sap_t *sap, body_t *body);
+
+/**
+ * Re-reads the bounds of the moving bodies, re-sorts the endpoints
+ * and recomputes the overlapping pairs.
+ *
+ * @param sap a pointer to a structure returned from sap_init()
+ */
+void sap_update(sap_t *sap);
+
+/**
+ * Finds the static bodies that overlapped a tracked body at the last update.
+ * Updates first if bodies were added or removed since then.
+ *
+ * @param sap a pointer to a structure returned from sap_init()
+ * @param body the body to look up
+ * @param results a list to which the overlapping static bodies are added
+ * @return whether the body is tracked; if not, results is left unchanged
+ */
+bool sap_query_body(sap_t *sap, body_t *body, list_t *results);
+
+/**
+ * Finds every static body whose bounding box overlaps a box.
+ *
+ * @param sap a pointer to a structure returned from sap_init()
+ * @param box the region to search
+ * @param results a list to which the matching static bodies are added
+ */
+void sap_query(sap_t *sap, aabb_t box, list_t *results);
+
+#endif // #ifndef __SAP_H__
@@ -2,6 +2,8 @@
 #define __SCENE_H__
 
 #include "body.h"
+#include "collision.h"
+#include "contact_cache.h"
 #include "list.h"
 
 /**
@@ -11,6 +13,21 @@
  */
 typedef struct scene scene_t;
 
+/**
+ * A stable reference to a body in a scene.
+ * Indices into the scene change as bodies are removed, since the scene moves
+ * its last body into the gap; a handle keeps referring to the same body
+ * until it is removed, and then stops resolving instead of pointing at
+ * another body or freed memory.
+ * A zeroed handle never refers to a body.
+ */
+typedef struct body_handle {
+  // The body's slot in the scene
+  uint32_t index;
+  // Bumped each time the slot is freed, so old handles stop matching
+  uint32_t generation;
+} body_handle_t;
+
 /**
  * A function which adds some forces or impulses to bodies,
  * e.g. from collisions, gravity, or spring forces.
@@ -18,6 +35,155 @@ typedef struct scene scene_t;
  */
 typedef void (*force_creator_t)(void *aux);
 
+/**
+ * A function which copies a force creator's auxiliary value for a copy of
+ * its scene (see scene_clone()), pointing the copy at the clone's bodies
+ * (see scene_find_clone()).
+ * Returns NULL if the value cannot be copied.
+ */
+typedef void *(*aux_cloner_t)(void *aux, scene_t *clone);
+
+/**
+ * The structures a scene can use to find the static bodies near a body.
+ */
+typedef enum {
+  /** A uniform grid over the static bodies (the default) */
+  BROADPHASE_GRID,
+  /**
+   * Sweep-and-prune along the x axis over the static and dynamic bodies,
+   * suited to wide levels with long thin platforms
+   */
+  BROADPHASE_SAP,
+  /** The dynamic AABB tree the scene keeps for spatial queries */
+  BROADPHASE_TREE
+} broadphase_t;
+
+/**
+ * The phases a scene tick runs its forces in, in order.
+ * Within a phase, force creators run from the most recently added to the
+ * first, so a force creator can override the ones registered before it.
+ */
+typedef enum {
+  /**
+   * Forces that only add to the forces on bodies, e.g. gravity and springs.
+   * Force fields and batched forces run first in this phase.
+   */
+  FORCE_PHASE_APPLY,
+  /**
+   * Force creators that react to the applied forces or set velocities and
+   * positions directly, e.g. collision handlers and pulleys (the default)
+   */
+  FORCE_PHASE_REACT,
+  /**
+   * Force creators that add a fixed impulse each call, e.g. fans and
+   * bouncing collisions. They run right after FORCE_PHASE_REACT, but only in
+   * the first substep of a tick (see scene_set_max_substeps()), so splitting
+   * a tick does not multiply their impulse.
+   */
+  FORCE_PHASE_IMPULSE,
+  /**
+   * Force creators that hand contacts to the contact solver, after anything
+   * that moves bodies. Batched platform contacts run first in this phase.
+   */
+  FORCE_PHASE_CONTACT
+} force_phase_t;
+
+/**
+ * The kinds of built-in force the scene stores in typed batches
+ * (see scene_add_batched_force()) instead of as generic force creators.
+ */
+typedef enum {
+  /** A drag on body1 proportional to its velocity */
+  FORCE_DRAG,
+  /** A spring pulling body1 towards body2 */
+  FORCE_SPRING,
+  /** Newtonian gravity between body1 and body2 */
+  FORCE_GRAVITY,
+  /** Uniform downward gravity on body1 */
+  FORCE_FALL,
+  /** Contacts between body1 and body2, passed to the contact solver */
+  FORCE_PLAT,
+  /** Contacts between body1 and the static bodies near it */
+  FORCE_STATIC_PLAT
+} force_kind_t;
+
+/**
+ * The kinds of scene-wide force field (see scene_add_field()).
+ */
+typedef enum {
+  /** A constant force, e.g. uniform gravity or wind */
+  FIELD_UNIFORM,
+  /** A force against each body's velocity and proportional to it */
+  FIELD_DRAG
+} field_kind_t;
+
+/**
+ * A force field acting on every body in a scene, or every body in a region.
+ */
+typedef struct force_field {
+  field_kind_t kind;
+  /** The force a uniform field applies */
+  vector_t force;
+  /** The drag coefficient of a drag field */
+  double drag;
+  /**
+   * Whether the force is multiplied by each body's mass,
+   * so every body accelerates the same way (as under gravity)
+   */
+  bool mass_scaled;
+  /**
+   * Whether the field only acts on bodies overlapping region,
+   * e.g. the air blown by a fan
+   */
+  bool bounded;
+  aabb_t region;
+} force_field_t;
+
+/**
+ * The result of casting a ray into a scene with scene_raycast().
+ */
+typedef struct raycast_hit {
+  /** Whether the ray hit any body */
+  bool hit;
+  /** The first body the ray hit, or NULL */
+  body_t *body;
+  /** Where the ray first touched the body (undefined if hit is false) */
+  vector_t point;
+  /** How far along the ray the point is */
+  double distance;
+} raycast_hit_t;
+
+/**
+ * Counters describing how much work the last call to scene_tick() did.
+ * If the tick was split into substeps, the work counters add up over all of
+ * them, while the body and island counts describe the end of the tick.
+ */
+typedef struct scene_stats {
+  /** Bodies that were integrated */
+  size_t awake_bodies;
+  /** Bodies that were asleep at the end of the tick */
+  size_t sleeping_bodies;
+  /** Force creators that were run */
+  size_t forces_run;
+  /** Force creators skipped because all their bodies were asleep or static */
+  size_t forces_skipped;
+  /**
+   * Groups of bodies connected through forces or contacts
+   * (see scene_same_island())
+   */
+  size_t islands;
+  /** Islands that were asleep at the end of the tick */
+  size_t sleeping_islands;
+  /** Contacts resolved by the contact solver */
+  size_t contacts;
+  /** Collision checks answered from the contact cache (see scene_collide()) */
+  size_t collisions_cached;
+  /** Bodies whose motion was swept against the static bodies */
+  size_t bodies_swept;
+  /** How many substeps the tick was split into (see scene_set_max_substeps()) */
+  size_t substeps;
+} scene_stats_t;
+
 /**
  * Allocates memory for an empty scene.
  * Makes a reasonable guess of the number of bodies to allocate space for.
@@ -54,6 +220,8 @@ size_t scene_counter(scene_t *scene);
 /**
  * Gets the body at a given index in a scene.
  * Asserts that the index is valid.
+ * Removing a body moves the last body into its index, so hold on to a handle
+ * (see scene_get_handle()) to find a body again in later ticks.
  *
  * @param scene a pointer to a scene returned from scene_init()
  * @param index the index of the body in the scene (starting at 0)
@@ -66,10 +234,212 @@ body_t *scene_get_body(scene_t *scene, size_t index);
  *
  * @param scene a pointer to a scene returned from scene_init()
  * @param body a pointer to the body to add to the scene
+ * @return a handle to the body
  */
-void scene_add_body(scene_t *scene, body_t *body);
+body_handle_t scene_add_body(scene_t *scene, body_t *body);
 
-void scene_add_hidden_body(scene_t *scene, body_t *body);
+/**
+ * Adds several bodies to a scene at once, after making room for all of them,
+ * as if each were passed to scene_add_body() in order.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param bodies the bodies to add to the scene
+ * @param num_bodies the number of bodies
+ * @param handles if non-NULL, an array of num_bodies handles to fill in
+ */
+void scene_add_bodies_n(scene_t *scene, body_t **bodies, size_t num_bodies,
+                        body_handle_t *handles);
+
+/**
+ * Makes room in a scene for a number of bodies on top of those it has,
+ * so that adding them with scene_add_body() does not reallocate its
+ * storage as it goes. Useful before building a large scene body by body.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param num_bodies the number of bodies that will be added
+ */
+void scene_reserve_bodies(scene_t *scene, size_t num_bodies);
+
+/**
+ * Makes room in a scene for a number of force creators in a phase on top of
+ * those it has, e.g. before adding a collision between each pair of a large
+ * group of bodies.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param phase the phase the force creators will run in
+ * @param num_forces the number of force creators that will be added
+ */
+void scene_reserve_forces(scene_t *scene, force_phase_t phase,
+                          size_t num_forces);
+
+/**
+ * Adds a body to a scene that forces can act on but that is not drawn,
+ * ticked or counted by scene_bodies().
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param body a pointer to the body to add to the scene
+ * @return a handle to the body
+ */
+body_handle_t scene_add_hidden_body(scene_t *scene, body_t *body);
+
+/**
+ * Adds a static body (a wall, platform, ...) to a scene.
+ * Static bodies have infinite mass, never move and are not drawn.
+ * They are indexed by a spatial grid, so dynamic bodies can be tested against
+ * all of them at once (see scene_query_static() and
+ * create_static_plat_collision()) instead of through one force per pair.
+ * Asserts that the body has infinite mass.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param body a pointer to the body to add to the scene
+ * @return a handle to the body
+ */
+body_handle_t scene_add_static_body(scene_t *scene, body_t *body);
+
+/**
+ * Gets a handle to a body in a scene, which stays valid while the scene
+ * removes and moves other bodies.
+ * Asserts that the body is in the scene.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param body a body added to the scene
+ * @return a handle to the body
+ */
+body_handle_t scene_get_handle(scene_t *scene, body_t *body);
+
+/**
+ * Finds the body a handle refers to, in constant time.
+ *
+ * @param scene the scene the handle came from
+ * @param handle a handle to a body
+ * @return the body, or NULL if it has been removed from the scene
+ */
+body_t *scene_resolve(scene_t *scene, body_handle_t handle);
+
+/**
+ * Gets the number of static bodies in a scene.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the number of static bodies added with scene_add_static_body()
+ */
+size_t scene_static_bodies(scene_t *scene);
+
+/**
+ * Finds the static bodies whose bounding boxes overlap a box.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param box the region to search
+ * @param results a list to which the matching bodies are added
+ */
+void scene_query_static(scene_t *scene, aabb_t box, list_t *results);
+
+/**
+ * Finds the static bodies whose bounding boxes overlap a body's.
+ * With BROADPHASE_SAP, the overlaps of the scene's own bodies are computed
+ * once per tick, at the start of scene_tick().
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param body the body to search around
+ * @param results a list to which the matching bodies are added
+ */
+void scene_query_static_near(scene_t *scene, body_t *body, list_t *results);
+
+/**
+ * Chooses how a scene finds the static bodies near its bodies.
+ * Levels can pick whichever is faster for their layout.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param broadphase the structure to use
+ */
+void scene_set_broadphase(scene_t *scene, broadphase_t broadphase);
+
+/**
+ * Finds the bodies and static bodies whose bounding boxes overlap a box,
+ * e.g. to check whether an area is clear.
+ * Hidden bodies are not included.
+ * Positions are as of the last scene_tick() (or when the body was added).
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param box the region to search
+ * @param results a list to which the matching bodies are added
+ */
+void scene_query_aabb(scene_t *scene, aabb_t box, list_t *results);
+
+/**
+ * Finds the bodies and static bodies whose shapes contain a point,
+ * e.g. the bodies under the mouse.
+ * Positions are as of the last scene_tick() (or when the body was added).
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param point the point to look under
+ * @param results a list to which the matching bodies are added
+ */
+void scene_query_point(scene_t *scene, vector_t point, list_t *results);
+
+/**
+ * Finds the first body or static body a ray hits.
+ * Positions are as of the last scene_tick() (or when the body was added).
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param start where the ray starts
+ * @param direction a unit vector along the ray
+ * @param max_distance how far along the ray to look
+ * @return the nearest hit; a ray starting inside a body hits it at distance 0
+ */
+raycast_hit_t scene_raycast(scene_t *scene, vector_t start, vector_t direction,
+                            double max_distance);
+
+/**
+ * Adds a contact between two overlapping bodies, to be resolved by the
+ * scene's contact solver once all force creators have run this tick.
+ * Force creators such as create_plat_collision() call this instead of
+ * moving the bodies themselves, so all the contacts are solved together.
+ * Wakes both bodies if they have finite mass, unless scene_collide() found
+ * them already touching the previous tick; the solver treats a sleeping body
+ * as immovable.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param body1 the first body
+ * @param body2 the second body
+ * @param normal a unit vector pointing from body1 towards body2
+ * @param depth how far the bodies overlap along the normal
+ */
+void scene_add_contact(scene_t *scene, body_t *body1, body_t *body2,
+                       vector_t normal, double depth);
+
+/**
+ * Sets how many passes the contact solver makes over the contacts each tick.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param iterations the number of passes (8 by default)
+ */
+void scene_set_solver_iterations(scene_t *scene, size_t iterations);
+
+/**
+ * Gets the impulse the contact solver applied between two bodies
+ * during the last tick.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param body1 the first body passed to scene_add_contact()
+ * @param body2 the second body passed to scene_add_contact()
+ * @return the magnitude of the impulse, or 0 if they were not in contact
+ */
+double scene_get_contact_impulse(scene_t *scene, body_t *body1,
+                                 body_t *body2);
+
+/**
+ * Checks two bodies for collision through the scene's contact cache.
+ * The narrowphase is skipped if neither body has moved since the pair was
+ * last checked, and the result says whether the bodies started touching,
+ * kept touching or stopped touching since the previous tick.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param body1 the first body
+ * @param body2 the second body
+ * @return the collision, with its axis pointing from body1 towards body2,
+ *   and how the contact changed
+ */
+contact_result_t scene_collide(scene_t *scene, body_t *body1, body_t *body2);
 
 /**
  * @deprecated Use body_remove() instead
@@ -95,6 +465,7 @@ void scene_add_force_creator(scene_t *scene, force_creator_t forcer, void *aux,
  * The auxiliary value is passed to the force creator each time it is called.
  * The force creator is registered with a list of bodies it applies to,
  * so it can be removed when any one of the bodies is removed.
+ * It runs in the FORCE_PHASE_REACT phase of each tick.
  *
  * @param scene a pointer to a scene returned from scene_init()
  * @param forcer a force creator function
@@ -108,18 +479,146 @@ void scene_add_bodies_force_creator(scene_t *scene, force_creator_t forcer,
                                     void *aux, list_t *bodies,
                                     free_func_t freer);
 
+/**
+ * Adds a built-in force to a scene. Forces of each kind are stored together
+ * and applied in one loop per kind, without calling through a force creator.
+ * Like any force creator, the force is removed when either of its bodies is.
+ * Drags, springs and gravity are applied before the force creators, and
+ * platform contacts after them.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param kind the kind of force
+ * @param constant the force's constant, e.g. the spring constant
+ * @param body1 the body the force acts on
+ * @param body2 the other body, or NULL for kinds that act on one body
+ */
+void scene_add_batched_force(scene_t *scene, force_kind_t kind,
+                             double constant, body_t *body1, body_t *body2);
+
+/**
+ * Adds a force field to a scene. Each tick, every body with finite mass that
+ * is awake and has the field in its mask (see body_set_field_mask()) feels
+ * the field, in one pass over the bodies. This replaces adding a force
+ * creator per body, e.g. create_fall() or create_drag() on each body.
+ * Fields are applied before any force creators.
+ * Asserts that the scene has fewer than 32 fields.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param field the field to add
+ * @return the field's index, i.e. its bit in the bodies' field masks
+ */
+size_t scene_add_field(scene_t *scene, force_field_t field);
+
+/**
+ * Adds a force creator to a scene to run in a given phase of each tick,
+ * like scene_add_bodies_force_creator().
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param phase the phase of the tick to run the force creator in
+ * @param tag a tag for enabling and disabling the force creator along with
+ *   others (see scene_set_tag_enabled()), or 0 for none
+ * @param forcer a force creator function
+ * @param aux an auxiliary value to pass to forcer when it is called
+ * @param bodies the list of bodies affected by the force creator
+ * @param freer if non-NULL, a function to call in order to free aux
+ * @param cloner if non-NULL, a function to copy aux when the scene is cloned
+ */
+void scene_add_phased_force_creator(scene_t *scene, force_phase_t phase,
+                                    size_t tag, force_creator_t forcer,
+                                    void *aux, list_t *bodies,
+                                    free_func_t freer, aux_cloner_t cloner);
+
+/**
+ * Adds a force creator like scene_add_phased_force_creator(), taking the
+ * bodies it acts on from an array instead of a list.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param phase the phase of the tick to run the force creator in
+ * @param tag a tag for the force creator (see scene_set_tag_enabled()),
+ *   or 0 for none
+ * @param forcer a force creator function
+ * @param aux an auxiliary value to pass to forcer when it is called
+ * @param bodies the bodies affected by the force creator, which are copied
+ * @param num_bodies the number of bodies
+ * @param freer if non-NULL, a function to call in order to free aux
+ * @param cloner if non-NULL, a function to copy aux when the scene is cloned
+ */
+void scene_add_phased_force_creator_n(scene_t *scene, force_phase_t phase,
+                                      size_t tag, force_creator_t forcer,
+                                      void *aux, body_t **bodies,
+                                      size_t num_bodies, free_func_t freer,
+                                      aux_cloner_t cloner);
+
+/**
+ * Enables or disables every force creator registered with a tag,
+ * e.g. to switch a set of fans off. Disabled force creators are not run.
+ * The bodies the force creators act on are woken when they change, so
+ * bodies at rest react to the switch.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param tag the tag the force creators were registered with (not 0)
+ * @param enabled whether the force creators should run
+ */
+void scene_set_tag_enabled(scene_t *scene, size_t tag, bool enabled);
+
 /**
  * Executes a tick of a given scene over a small time interval.
  * This requires executing all the force creators
  * and then ticking each body (see body_tick()).
  * If any bodies are marked for removal, they should be removed from the scene
  * and freed, along with any force creators acting on them.
+ * The forces run phase by phase (see force_phase_t).
+ * Force creators whose relevant bodies are all asleep or have infinite mass
+ * are skipped (see body_is_asleep()), as are disabled ones.
+ * Contacts added by the force creators are solved before the bodies tick.
+ * Bodies that move far in one tick, or are marked with body_set_fast(), are
+ * stopped at the first static body along their path instead of passing
+ * through it, so larger time steps do not make bodies tunnel through walls.
  *
  * @param scene a pointer to a scene returned from scene_init()
  * @param dt the time elapsed since the last tick, in seconds
  */
 void scene_tick(scene_t *scene, double dt);
 
+/**
+ * Returns whether two bodies were in the same island during the last tick:
+ * connected, directly or through other bodies, by force creators or contacts.
+ * Bodies with infinite mass do not connect islands and are in none.
+ * Each tick, an island with a moving body is kept awake as a whole, and an
+ * island whose bodies are all at rest falls asleep as a whole.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param body1 the first body
+ * @param body2 the second body
+ * @return whether the bodies share an island
+ */
+bool scene_same_island(scene_t *scene, body_t *body1, body_t *body2);
+
+/**
+ * Lets scene_tick() split a tick into up to a given number of equal
+ * substeps. The count is chosen each tick from how far the fastest body
+ * moves relative to its size and from the stiffest spring registered with
+ * scene_add_stiffness(), so calm ticks still take one step.
+ * Force creators run once per substep, except those in FORCE_PHASE_IMPULSE,
+ * which run once per tick so that substepping does not change how hard they
+ * push.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param max_substeps the most substeps per tick; 1 (the default) disables
+ *   substepping
+ */
+void scene_set_max_substeps(scene_t *scene, size_t max_substeps);
+
+/**
+ * Tells a scene about a spring acting on one of its bodies, so substepping
+ * (see scene_set_max_substeps()) can keep it stable.
+ * create_spring() calls this.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param stiffness the spring constant divided by the mass it acts on
+ */
+void scene_add_stiffness(scene_t *scene, double stiffness);
+
 /**
  * Frees all forces in the scene (does not free scene or force list itself)
  *
@@ -128,7 +627,112 @@ void scene_tick(scene_t *scene, double dt);
 void scene_free_forces(scene_t *scene);
 
 /**
- * Finds out whether any of the bodies have encourntered a lose condition
+ * Saves the state of a scene's bodies and forces, e.g. at the start of a
+ * level, so it can be restarted with scene_restore() instead of being
+ * rebuilt.
+ * The buffer records the bodies' positions, velocities and flags
+ * (see body_get_state()), the force fields, whether each force creator is
+ * enabled, and the scene's win, lose and removal counters. It also keeps a
+ * copy of the scene (see scene_clone()), from which the force creators'
+ * auxiliary values and any bodies removed later are put back.
+ * If some force creator cannot be copied, no copy is kept, and the
+ * snapshot can only be restored while the scene has all the bodies it saved.
+ * Each body's state is saved with its handle (see scene_get_handle()),
+ * so it can only be restored onto the same scene.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param size set to the size of the buffer in bytes
+ * @return a newly allocated buffer, which the caller must free with
+ *   scene_free_snapshot()
+ */
+void *scene_snapshot(scene_t *scene, size_t *size);
+
+/**
+ * Puts a scene back into the state saved by scene_snapshot().
+ * If the scene still has the same bodies and force creators, the bodies are
+ * restored in place and the force creators are replaced by copies of the
+ * saved ones, so their auxiliary values (e.g. hit counts) go back too.
+ * If bodies or forces have been added or removed since (e.g. a collected
+ * gem), the whole scene is rebuilt from the copy the snapshot kept: every
+ * body is replaced, so only handles to them stay valid, and anything added
+ * since the snapshot is dropped.
+ * Without a kept copy the auxiliary values are left alone, and a scene that
+ * has gained or lost bodies or forces is left unchanged.
+ * Contacts go back to those remembered when the snapshot was taken, or are
+ * forgotten without a kept copy.
+ *
+ * @param scene the scene the snapshot was taken of
+ * @param snapshot a buffer returned from scene_snapshot()
+ * @param size the size of the buffer
+ * @return whether the scene was restored
+ */
+bool scene_restore(scene_t *scene, const void *snapshot, size_t size);
+
+/**
+ * Releases a buffer returned from scene_snapshot(), and the copy of the
+ * scene it keeps.
+ *
+ * @param snapshot a buffer returned from scene_snapshot(), or NULL
+ */
+void scene_free_snapshot(void *snapshot);
+
+/**
+ * Hashes the state of every body in a scene (see body_hash()), including
+ * hidden and static bodies, along with the scene's win, lose and removal
+ * counters. Two runs of the same scene with the same input should have the
+ * same hash after every tick; a change in the hash shows where a build or
+ * optimization made the simulation drift.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the hash of the scene's state
+ */
+uint64_t scene_hash(scene_t *scene);
+
+/**
+ * Makes an independent copy of a scene, e.g. to run it ahead speculatively
+ * and throw the result away. The copy has its own copy of every body
+ * (see body_clone()) and force, and remembers the same contacts.
+ * Bodies share their shapes, textures and info with the originals, and
+ * either scene can be freed first.
+ * Force creators with an auxiliary value are copied with the cloner they
+ * were registered with (see scene_add_phased_force_creator()).
+ * Handles to the original's bodies resolve to their copies in the clone.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the copy, or NULL if some force creator cannot be copied
+ */
+scene_t *scene_clone(scene_t *scene);
+
+/**
+ * Finds the copy of one of the original scene's bodies in a clone.
+ *
+ * @param clone a scene returned from scene_clone()
+ * @param original a body in the scene the clone was made from
+ * @return the clone's copy of the body, or NULL if it has none
+ */
+body_t *scene_find_clone(scene_t *clone, body_t *original);
+
+/**
+ * Gets counters describing the work done by the last scene_tick().
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @return the statistics of the last tick
+ */
+scene_stats_t scene_get_stats(scene_t *scene);
+
+/**
+ * Marks a body as a player: the scene is won or lost as soon as any player
+ * is (see body_win() and body_lose()). Other bodies' flags are ignored.
+ * At most four bodies can be players.
+ *
+ * @param scene a pointer to a scene returned from scene_init()
+ * @param player the handle of a body in the scene
+ */
+void scene_add_player(scene_t *scene, body_handle_t player);
+
+/**
+ * Finds out whether any of the players (see scene_add_player()) have
+ * encountered a lose condition
  *
  * @param scene a pointer to a scene
  * @return whether the scene is considered lost
@@ -136,7 +740,8 @@ void scene_free_forces(scene_t *scene);
 bool scene_get_lose(scene_t *scene);
 
 /**
- * Finds out whether any of the bodies have encourntered a win condition
+ * Finds out whether any of the players (see scene_add_player()) have
+ * encountered a win condition
  *
  * @param a pointer to a scene
  * @return scene whether the scene is considered won
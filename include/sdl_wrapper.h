@@ -3,6 +3,7 @@
 
 #include "color.h"
 #include "list.h"
+#include "replay.h"
 #include "scene.h"
 #include "vector.h"
 #include <state.h>
@@ -59,6 +60,41 @@ typedef void (*mouse_handler_t)(state_t *s, double x, double y);
 void sdl_init(vector_t min, vector_t max);
 
 
+/**
+ * Sets whether to run without a window or sound, e.g. to replay a session
+ * faster than real time. While headless, the drawing functions do nothing
+ * and sdl_load_image() returns NULL.
+ * Must be called before sdl_init().
+ *
+ * @param is_headless whether to run without a window
+ */
+void sdl_set_headless(bool is_headless);
+
+/**
+ * Returns whether sdl_set_headless() turned off the window.
+ *
+ * @return whether the window is off
+ */
+bool sdl_is_headless(void);
+
+/**
+ * Starts recording every tick's dt and every key and mouse event handled
+ * into a recording, so the session can be replayed with sdl_replay().
+ *
+ * @param replay the recording to add to, or NULL to stop recording
+ */
+void sdl_record(replay_t *replay);
+
+/**
+ * Plays back a recording instead of the real events and clock.
+ * time_since_last_tick() returns each recorded tick's dt in turn, and
+ * sdl_is_done() passes the events recorded after that tick to the handlers,
+ * returning true once the recording runs out.
+ *
+ * @param replay the recording to play back, or NULL to stop playing back
+ */
+void sdl_replay(replay_t *replay);
+
 /**
  * Returns SDL_Renderer
  *
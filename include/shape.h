@@ -0,0 +1,94 @@
+#ifndef __SHAPE_H__
+#define __SHAPE_H__
+
+#include "list.h"
+#include "vector.h"
+
+/**
+ * An immutable polygon stored in local coordinates, i.e. relative to its
+ * centroid with no rotation applied.
+ * Shapes are reference counted so that congruent bodies (gems, blocks, ...)
+ * can share one copy of their vertices; each body only stores where the shape
+ * is placed.
+ */
+typedef struct shape shape_t;
+
+/**
+ * Allocates a shape from a polygon. The polygon is moved so that its centroid
+ * lies at the origin, and is decomposed into convex pieces if it is concave.
+ * The returned shape has a single reference.
+ *
+ * @param points a list of vectors describing the polygon;
+ *   the shape takes ownership of this list
+ * @return a pointer to the newly allocated shape
+ */
+shape_t *shape_init(list_t *points);
+
+/**
+ * Adds a reference to a shape.
+ *
+ * @param shape a pointer to a shape returned from shape_init()
+ * @return the same shape, for convenience
+ */
+shape_t *shape_acquire(shape_t *shape);
+
+/**
+ * Removes a reference to a shape, freeing it once no references remain.
+ *
+ * @param shape a pointer to a shape returned from shape_init()
+ */
+void shape_release(shape_t *shape);
+
+/**
+ * Gets where the shape's centroid was in the polygon it was built from,
+ * i.e. how far the polygon was moved to center it on the origin.
+ * A body placed at this position covers exactly the original polygon.
+ *
+ * @param shape a pointer to a shape returned from shape_init()
+ * @return the centroid of the polygon passed to shape_init()
+ */
+vector_t shape_get_origin(shape_t *shape);
+
+/**
+ * Gets the vertices of a shape in local coordinates.
+ * The list is owned by the shape and must not be modified or freed.
+ *
+ * @param shape a pointer to a shape returned from shape_init()
+ * @return the list of vertices of the shape
+ */
+list_t *shape_get_points(shape_t *shape);
+
+/**
+ * Gets the convex pieces of a concave shape in local coordinates.
+ * The list is owned by the shape and must not be modified or freed.
+ *
+ * @param shape a pointer to a shape returned from shape_init()
+ * @return a list of convex pieces (each a list of vectors),
+ *   or NULL if the shape is convex
+ */
+list_t *shape_get_pieces(shape_t *shape);
+
+/**
+ * Places a polygon given in local coordinates into the world.
+ * Each vertex is rotated about the origin and then translated.
+ *
+ * @param points a list of vectors in local coordinates
+ * @param position where the origin of the local coordinates ends up
+ * @param angle the counterclockwise rotation to apply, in radians
+ * @return a newly allocated list of the transformed vertices
+ */
+list_t *shape_place(list_t *points, vector_t position, double angle);
+
+/**
+ * Like shape_place(), but overwrites the vertices of an existing list
+ * instead of allocating a new one.
+ *
+ * @param points a list of vectors in local coordinates
+ * @param position where the origin of the local coordinates ends up
+ * @param angle the counterclockwise rotation to apply, in radians
+ * @param placed a list returned from shape_place() for the same points
+ */
+void shape_place_into(list_t *points, vector_t position, double angle,
+                      list_t *placed);
+
+#endif // #ifndef __SHAPE_H__
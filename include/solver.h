@@ -0,0 +1,95 @@
+#ifndef __SOLVER_H__
+#define __SOLVER_H__
+
+#include "body.h"
+#include "contact_cache.h"
+#include "vector.h"
+
+/**
+ * A sequential-impulse contact solver.
+ * Contacts are gathered during a tick (see solver_add_contact()) and then
+ * solved together by solver_solve(), which adds the impulses that keep the
+ * bodies from moving into each other. Each pair's impulse is remembered in a
+ * contact cache and used as the starting guess the next tick (warm starting),
+ * so resting contacts converge in very few iterations.
+ *
+ * Bodies do not rotate, so a contact manifold reduces to a single normal
+ * constraint: every contact point of a pair would push along the same normal
+ * through the same center of mass.
+ */
+typedef struct solver solver_t;
+
+/**
+ * Allocates an empty solver.
+ *
+ * @param iterations the number of passes over the contacts per solve
+ * @param cache the cache the impulses are remembered in from tick to tick;
+ *   the solver does not free it
+ * @return a pointer to the newly allocated solver
+ */
+solver_t *solver_init(size_t iterations, contact_cache_t *cache);
+
+/**
+ * Releases the memory allocated for a solver.
+ * Does not free any bodies.
+ *
+ * @param solver a pointer to a solver returned from solver_init()
+ */
+void solver_free(solver_t *solver);
+
+/**
+ * Sets the number of passes over the contacts per solve.
+ * More passes converge better for stacks of bodies; the cost per contact
+ * is proportional to this.
+ *
+ * @param solver a pointer to a solver returned from solver_init()
+ * @param iterations the number of passes
+ */
+void solver_set_iterations(solver_t *solver, size_t iterations);
+
+/**
+ * Gets the number of passes over the contacts per solve.
+ *
+ * @param solver a pointer to a solver returned from solver_init()
+ * @return the number of passes
+ */
+size_t solver_get_iterations(solver_t *solver);
+
+/**
+ * Adds a contact to be solved by the next call to solver_solve().
+ *
+ * @param solver a pointer to a solver returned from solver_init()
+ * @param body1 the first body
+ * @param body2 the second body
+ * @param normal a unit vector pointing from body1 towards body2
+ * @param depth how far the bodies overlap along the normal
+ */
+void solver_add_contact(solver_t *solver, body_t *body1, body_t *body2,
+                        vector_t normal, double depth);
+
+/**
+ * Gets the number of contacts added since the last solve.
+ *
+ * @param solver a pointer to a solver returned from solver_init()
+ * @return the number of pending contacts
+ */
+size_t solver_contacts(solver_t *solver);
+
+/**
+ * Solves the pending contacts and clears them.
+ * Must be called after all forces and impulses for the tick have been added
+ * and before the bodies are ticked: the solver predicts each body's velocity
+ * at the end of the tick and adds impulses (see body_add_impulse()) so that
+ * no contact is still closing. Bodies that overlap by more than a small slop
+ * are also given a separating velocity to push them apart.
+ * Sleeping bodies are treated as immovable, like bodies with infinite mass.
+ * The impulses are recorded with contact_cache_set_impulse(); call
+ * contact_cache_begin_tick() before the next solve so they are used
+ * as its starting guess.
+ *
+ * @param solver a pointer to a solver returned from solver_init()
+ * @param dt the length of the tick the bodies are about to be ticked by
+ */
+void solver_solve(solver_t *solver, double dt);
+
+#endif // #ifndef __SOLVER_H__
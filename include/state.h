@@ -24,6 +24,12 @@ state_t *emscripten_init();
  */
 void emscripten_main(state_t *state);
 
+/**
+ * Returns the scene the demo is running, or NULL if it does not use one.
+ * Used to hash the simulation while replaying a recorded session.
+ */
+scene_t *emscripten_get_scene(state_t *state);
+
 /**
  * Frees anything allocated in the demo
  * Should free everything in state as well as state itself.
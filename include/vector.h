@@ -1,6 +1,8 @@
 #ifndef __VECTOR_H__
 #define __VECTOR_H__
 
+#include "array.h"
+
 /**
  * A real-valued 2-dimensional vector.
  * Positive x is towards the right; positive y is towards the top.
@@ -18,6 +20,11 @@ typedef struct {
  */
 extern const vector_t VEC_ZERO;
 
+/**
+ * A growable array of vectors held by value (see array.h).
+ */
+ARRAY_DECLARE(vector_t, vector_array)
+
 /**
  * Adds two vectors.
  * Performs the usual componentwise vector sum.
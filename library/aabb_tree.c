@@ -0,0 +1,382 @@
+#include "aabb_tree.h"
+#include "collision.h"
+#include "list.h"
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+const size_t INITIAL_NODES_GUESS = 16;
+const size_t NULL_NODE = SIZE_MAX;
+
+/**
+ * A node of the tree. Leaves have no children and store an item;
+ * internal nodes always have two children and a box covering both.
+ * Free nodes are chained through their parent field.
+ */
+typedef struct tree_node {
+  aabb_t box;
+  void *item;
+  size_t parent;
+  size_t left;
+  size_t right;
+  size_t height;
+} tree_node_t;
+
+typedef struct aabb_tree {
+  tree_node_t *nodes;
+  size_t capacity;
+  size_t root;
+  size_t free_list;
+  double margin;
+} aabb_tree_t;
+
+aabb_tree_t *aabb_tree_init(double margin) {
+  aabb_tree_t *tree = malloc(sizeof(aabb_tree_t));
+  assert(tree != NULL);
+  tree->capacity = INITIAL_NODES_GUESS;
+  tree->nodes = malloc(tree->capacity * sizeof(tree_node_t));
+  assert(tree->nodes != NULL);
+  for (size_t i = 0; i < tree->capacity; i++) {
+    tree->nodes[i].parent = i + 1 < tree->capacity ? i + 1 : NULL_NODE;
+  }
+  tree->free_list = 0;
+  tree->root = NULL_NODE;
+  tree->margin = margin;
+  return tree;
+}
+
+void aabb_tree_free(aabb_tree_t *tree) {
+  free(tree->nodes);
+  free(tree);
+}
+
+size_t tree_alloc_node(aabb_tree_t *tree) {
+  if (tree->free_list == NULL_NODE) {
+    size_t old_capacity = tree->capacity;
+    tree->capacity *= 2;
+    tree->nodes = realloc(tree->nodes, tree->capacity * sizeof(tree_node_t));
+    assert(tree->nodes != NULL);
+    for (size_t i = old_capacity; i < tree->capacity; i++) {
+      tree->nodes[i].parent = i + 1 < tree->capacity ? i + 1 : NULL_NODE;
+    }
+    tree->free_list = old_capacity;
+  }
+  size_t index = tree->free_list;
+  tree->free_list = tree->nodes[index].parent;
+  tree->nodes[index] = (tree_node_t){.item = NULL,
+                                     .parent = NULL_NODE,
+                                     .left = NULL_NODE,
+                                     .right = NULL_NODE,
+                                     .height = 0};
+  return index;
+}
+
+void tree_free_node(aabb_tree_t *tree, size_t index) {
+  tree->nodes[index].parent = tree->free_list;
+  tree->free_list = index;
+}
+
+bool tree_is_leaf(aabb_tree_t *tree, size_t index) {
+  return tree->nodes[index].left == NULL_NODE;
+}
+
+aabb_t aabb_union(aabb_t box1, aabb_t box2) {
+  return (aabb_t){.min = {fmin(box1.min.x, box2.min.x),
+                          fmin(box1.min.y, box2.min.y)},
+                  .max = {fmax(box1.max.x, box2.max.x),
+                          fmax(box1.max.y, box2.max.y)}};
+}
+
+double aabb_perimeter(aabb_t box) {
+  return 2 * ((box.max.x - box.min.x) + (box.max.y - box.min.y));
+}
+
+bool aabb_contains(aabb_t outer, aabb_t inner) {
+  return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y &&
+         inner.max.x <= outer.max.x && inner.max.y <= outer.max.y;
+}
+
+/**
+ * Recomputes an internal node's box and height from its children.
+ */
+void tree_refit(aabb_tree_t *tree, size_t index) {
+  tree_node_t *node = &tree->nodes[index];
+  tree_node_t *left = &tree->nodes[node->left];
+  tree_node_t *right = &tree->nodes[node->right];
+  node->box = aabb_union(left->box, right->box);
+  node->height = 1 + (left->height > right->height ? left->height
+                                                   : right->height);
+}
+
+/**
+ * Points the parent of old_child (or the root) at new_child instead.
+ */
+void tree_replace_child(aabb_tree_t *tree, size_t parent, size_t old_child,
+                        size_t new_child) {
+  if (parent == NULL_NODE) {
+    tree->root = new_child;
+  } else if (tree->nodes[parent].left == old_child) {
+    tree->nodes[parent].left = new_child;
+  } else {
+    tree->nodes[parent].right = new_child;
+  }
+}
+
+/**
+ * If one child of node a is more than one level taller than the other,
+ * rotates the taller child up into a's place.
+ * Returns the index of the node now in a's place.
+ */
+size_t tree_balance(aabb_tree_t *tree, size_t a) {
+  if (tree_is_leaf(tree, a) || tree->nodes[a].height < 2) {
+    return a;
+  }
+  size_t b = tree->nodes[a].left;
+  size_t c = tree->nodes[a].right;
+  size_t up;
+  size_t stay;
+  bool up_is_right;
+  if (tree->nodes[c].height > tree->nodes[b].height + 1) {
+    up = c;
+    stay = b;
+    up_is_right = true;
+  } else if (tree->nodes[b].height > tree->nodes[c].height + 1) {
+    up = b;
+    stay = c;
+    up_is_right = false;
+  } else {
+    return a;
+  }
+
+  // The taller grandchild stays under up; the shorter one moves under a
+  size_t f = tree->nodes[up].left;
+  size_t g = tree->nodes[up].right;
+  size_t tall = tree->nodes[f].height > tree->nodes[g].height ? f : g;
+  size_t short_child = tall == f ? g : f;
+
+  tree->nodes[up].parent = tree->nodes[a].parent;
+  tree_replace_child(tree, tree->nodes[up].parent, a, up);
+  tree->nodes[a].parent = up;
+  tree->nodes[up].left = a;
+  tree->nodes[up].right = tall;
+  if (up_is_right) {
+    tree->nodes[a].left = stay;
+    tree->nodes[a].right = short_child;
+  } else {
+    tree->nodes[a].left = short_child;
+    tree->nodes[a].right = stay;
+  }
+  tree->nodes[short_child].parent = a;
+  tree_refit(tree, a);
+  tree_refit(tree, up);
+  return up;
+}
+
+/**
+ * Walks from a node up to the root, rebalancing and refitting each ancestor.
+ */
+void tree_fix_upwards(aabb_tree_t *tree, size_t index) {
+  while (index != NULL_NODE) {
+    index = tree_balance(tree, index);
+    tree_refit(tree, index);
+    index = tree->nodes[index].parent;
+  }
+}
+
+/**
+ * Inserts a leaf next to the sibling that grows the tree's total perimeter
+ * the least.
+ */
+void tree_insert_leaf(aabb_tree_t *tree, size_t leaf) {
+  if (tree->root == NULL_NODE) {
+    tree->root = leaf;
+    tree->nodes[leaf].parent = NULL_NODE;
+    return;
+  }
+
+  aabb_t box = tree->nodes[leaf].box;
+  size_t index = tree->root;
+  while (!tree_is_leaf(tree, index)) {
+    tree_node_t *node = &tree->nodes[index];
+    double area = aabb_perimeter(node->box);
+    double combined = aabb_perimeter(aabb_union(node->box, box));
+    // Cost of pairing the leaf with this node, and the cost pushed down to
+    // every node below it if we descend instead
+    double cost = 2 * combined;
+    double inherited = 2 * (combined - area);
+    double child_costs[2];
+    size_t children[2] = {node->left, node->right};
+    for (size_t i = 0; i < 2; i++) {
+      aabb_t child = tree->nodes[children[i]].box;
+      double grown = aabb_perimeter(aabb_union(child, box));
+      child_costs[i] = inherited + (tree_is_leaf(tree, children[i])
+                                        ? grown
+                                        : grown - aabb_perimeter(child));
+    }
+    if (cost < child_costs[0] && cost < child_costs[1]) {
+      break;
+    }
+    index = child_costs[0] < child_costs[1] ? children[0] : children[1];
+  }
+
+  size_t sibling = index;
+  size_t old_parent = tree->nodes[sibling].parent;
+  size_t new_parent = tree_alloc_node(tree);
+  tree->nodes[new_parent].parent = old_parent;
+  tree->nodes[new_parent].left = sibling;
+  tree->nodes[new_parent].right = leaf;
+  tree_replace_child(tree, old_parent, sibling, new_parent);
+  tree->nodes[sibling].parent = new_parent;
+  tree->nodes[leaf].parent = new_parent;
+  tree_fix_upwards(tree, new_parent);
+}
+
+void tree_remove_leaf(aabb_tree_t *tree, size_t leaf) {
+  if (leaf == tree->root) {
+    tree->root = NULL_NODE;
+    return;
+  }
+  size_t parent = tree->nodes[leaf].parent;
+  size_t grandparent = tree->nodes[parent].parent;
+  size_t sibling = tree->nodes[parent].left == leaf ? tree->nodes[parent].right
+                                                    : tree->nodes[parent].left;
+  tree_replace_child(tree, grandparent, parent, sibling);
+  tree->nodes[sibling].parent = grandparent;
+  tree_free_node(tree, parent);
+  tree_fix_upwards(tree, grandparent);
+}
+
+aabb_t tree_fatten(aabb_tree_t *tree, aabb_t box) {
+  vector_t margin = {tree->margin, tree->margin};
+  return (aabb_t){.min = vec_subtract(box.min, margin),
+                  .max = vec_add(box.max, margin)};
+}
+
+size_t aabb_tree_insert(aabb_tree_t *tree, void *item, aabb_t box) {
+  size_t leaf = tree_alloc_node(tree);
+  tree->nodes[leaf].item = item;
+  tree->nodes[leaf].box = tree_fatten(tree, box);
+  tree_insert_leaf(tree, leaf);
+  return leaf;
+}
+
+void aabb_tree_remove(aabb_tree_t *tree, size_t id) {
+  assert(tree_is_leaf(tree, id));
+  tree_remove_leaf(tree, id);
+  tree_free_node(tree, id);
+}
+
+bool aabb_tree_move(aabb_tree_t *tree, size_t id, aabb_t box) {
+  assert(tree_is_leaf(tree, id));
+  if (aabb_contains(tree->nodes[id].box, box)) {
+    return false;
+  }
+  tree_remove_leaf(tree, id);
+  tree->nodes[id].box = tree_fatten(tree, box);
+  tree_insert_leaf(tree, id);
+  return true;
+}
+
+/**
+ * Replaces the items of the leaves under a node with their mapped values.
+ */
+void tree_map_items(aabb_tree_t *tree, size_t index, item_mapper_t mapper,
+                    void *context) {
+  tree_node_t *node = &tree->nodes[index];
+  if (tree_is_leaf(tree, index)) {
+    node->item = mapper(context, node->item);
+    return;
+  }
+  tree_map_items(tree, node->left, mapper, context);
+  tree_map_items(tree, node->right, mapper, context);
+}
+
+aabb_tree_t *aabb_tree_clone(aabb_tree_t *tree, item_mapper_t mapper,
+                             void *context) {
+  aabb_tree_t *clone = malloc(sizeof(aabb_tree_t));
+  assert(clone != NULL);
+  *clone = *tree;
+  clone->nodes = malloc(tree->capacity * sizeof(tree_node_t));
+  assert(clone->nodes != NULL);
+  memcpy(clone->nodes, tree->nodes, tree->capacity * sizeof(tree_node_t));
+  if (clone->root != NULL_NODE) {
+    tree_map_items(clone, clone->root, mapper, context);
+  }
+  return clone;
+}
+
+size_t aabb_tree_height(aabb_tree_t *tree) {
+  return tree->root == NULL_NODE ? 0 : tree->nodes[tree->root].height;
+}
+
+void tree_query_node(aabb_tree_t *tree, size_t index, aabb_t box,
+                     list_t *results) {
+  tree_node_t *node = &tree->nodes[index];
+  if (!aabb_overlap(node->box, box)) {
+    return;
+  }
+  if (tree_is_leaf(tree, index)) {
+    list_add(results, node->item);
+    return;
+  }
+  tree_query_node(tree, node->left, box, results);
+  tree_query_node(tree, node->right, box, results);
+}
+
+void aabb_tree_query(aabb_tree_t *tree, aabb_t box, list_t *results) {
+  if (tree->root != NULL_NODE) {
+    tree_query_node(tree, tree->root, box, results);
+  }
+}
+
+/**
+ * Returns whether the segment start + t * delta, 0 <= t <= 1, crosses a box.
+ */
+bool segment_hits_box(vector_t start, vector_t delta, aabb_t box) {
+  double t_min = 0;
+  double t_max = 1;
+  double starts[2] = {start.x, start.y};
+  double deltas[2] = {delta.x, delta.y};
+  double mins[2] = {box.min.x, box.min.y};
+  double maxes[2] = {box.max.x, box.max.y};
+  for (size_t i = 0; i < 2; i++) {
+    if (deltas[i] == 0) {
+      if (starts[i] < mins[i] || starts[i] > maxes[i]) {
+        return false;
+      }
+      continue;
+    }
+    double t1 = (mins[i] - starts[i]) / deltas[i];
+    double t2 = (maxes[i] - starts[i]) / deltas[i];
+    t_min = fmax(t_min, fmin(t1, t2));
+    t_max = fmin(t_max, fmax(t1, t2));
+    if (t_min > t_max) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void tree_raycast_node(aabb_tree_t *tree, size_t index, vector_t start,
+                       vector_t delta, list_t *results) {
+  tree_node_t *node = &tree->nodes[index];
+  if (!segment_hits_box(start, delta, node->box)) {
+    return;
+  }
+  if (tree_is_leaf(tree, index)) {
+    list_add(results, node->item);
+    return;
+  }
+  tree_raycast_node(tree, node->left, start, delta, results);
+  tree_raycast_node(tree, node->right, start, delta, results);
+}
+
+void aabb_tree_raycast(aabb_tree_t *tree, vector_t start, vector_t end,
+                       list_t *results) {
+  if (tree->root != NULL_NODE) {
+    tree_raycast_node(tree, tree->root, start, vec_subtract(end, start),
+                      results);
+  }
+}
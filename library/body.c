@@ -3,6 +3,7 @@
 #include "info.h"
 #include "list.h"
 #include "polygon.h"
+#include "shape.h"
 #include "vector.h"
 #include <assert.h>
 #include <stdio.h>
@@ -12,16 +13,72 @@
 #include <SDL2/SDL_timer.h>
 #include <SDL2/SDL_image.h>
 
+const double SLEEP_SPEED = 1e-3;
+const double SLEEP_ACCELERATION = 1e-3;
+const size_t SLEEP_TICKS = 60;
+// 64-bit FNV-1a
+const uint64_t HASH_SEED = 14695981039346656037ULL;
+const uint64_t HASH_PRIME = 1099511628211ULL;
+// x, y, vx, vy, ax, ay, fx, fy, jx, jy, inv_mass and the four start arrays
+const size_t NUM_STORE_ARRAYS = 15;
+
+ARRAY_DEFINE(body_t *, body_array)
+
+/**
+ * The physics state that body_tick() reads and writes, for a group of bodies,
+ * with one array per component. A scene keeps all its bodies' state in one
+ * store, so integrating them is a single loop over contiguous arrays;
+ * a body outside a scene has a store of its own.
+ */
+typedef struct body_store {
+  // NUM_STORE_ARRAYS arrays of capacity doubles each, in one allocation
+  double *data;
+  double *x;
+  double *y;
+  double *vx;
+  double *vy;
+  double *ax;
+  double *ay;
+  double *fx;
+  double *fy;
+  double *jx;
+  double *jy;
+  double *inv_mass;
+  // Each body's centroid and velocity at the start of its last tick
+  double *start_x;
+  double *start_y;
+  double *start_vx;
+  double *start_vy;
+  bool *asleep;
+  body_t **bodies;
+  size_t size;
+  size_t capacity;
+} body_store_t;
+
+/**
+ * The rest of a body: its shape, appearance, game flags and bookkeeping.
+ */
 typedef struct body {
+  body_store_t *store;
+  // The body's index in its store
+  size_t index;
+  // Whether the store is the body's own rather than its scene's
+  bool owns_store;
   rgb_color_t color;
   double mass;
-  vector_t position;
-  vector_t velocity;
-  vector_t acceleration;
-  list_t *shape;
-  vector_t total_force;
-  vector_t total_impulse;
-  vector_t centroid;
+  shape_t *shape;
+  list_t *world_points;
+  list_t *world_pieces;
+  bool world_dirty;
+  size_t sleep_ticks;
+  size_t proxy;
+  // The body's handle slot in its scene
+  size_t slot;
+  // Counts changes to the transform, so callers can tell it moved
+  size_t moves;
+  bool fast;
+  // Bit i is set if the body feels the scene's force field i
+  uint32_t field_mask;
   double curr_angle;
   void *info;
   bool body_remove;
@@ -34,170 +91,562 @@ typedef struct body {
   double pull_mass;
   SDL_Texture *texture;
   free_func_t info_freer;
+  // How many clones share the texture and info, which the last of them
+  // frees; NULL while the body has never been cloned
+  size_t *extras_refs;
 } body_t;
 
-body_t *body_init(list_t *shape, double mass, rgb_color_t color) {
+/**
+ * Points the store's arrays into its buffer.
+ */
+void body_store_place_arrays(body_store_t *store) {
+  double **arrays[] = {&store->x,        &store->y,        &store->vx,
+                       &store->vy,       &store->ax,       &store->ay,
+                       &store->fx,       &store->fy,       &store->jx,
+                       &store->jy,       &store->inv_mass, &store->start_x,
+                       &store->start_y,  &store->start_vx, &store->start_vy};
+  for (size_t i = 0; i < NUM_STORE_ARRAYS; i++) {
+    *arrays[i] = store->data + i * store->capacity;
+  }
+}
+
+body_store_t *body_store_init(size_t capacity) {
+  assert(capacity > 0);
+  body_store_t *store = malloc(sizeof(body_store_t));
+  assert(store != NULL);
+  store->capacity = capacity;
+  store->size = 0;
+  store->data = malloc(NUM_STORE_ARRAYS * capacity * sizeof(double));
+  store->asleep = malloc(capacity * sizeof(bool));
+  store->bodies = malloc(capacity * sizeof(body_t *));
+  assert(store->data != NULL && store->asleep != NULL &&
+         store->bodies != NULL);
+  body_store_place_arrays(store);
+  return store;
+}
+
+void body_store_free(body_store_t *store) {
+  free(store->data);
+  free(store->asleep);
+  free(store->bodies);
+  free(store);
+}
+
+size_t body_store_size(body_store_t *store) { return store->size; }
+
+void body_store_reserve(body_store_t *store, size_t capacity) {
+  if (capacity <= store->capacity) {
+    return;
+  }
+  double *data = malloc(NUM_STORE_ARRAYS * capacity * sizeof(double));
+  assert(data != NULL);
+  for (size_t i = 0; i < NUM_STORE_ARRAYS; i++) {
+    memcpy(data + i * capacity, store->data + i * store->capacity,
+           store->size * sizeof(double));
+  }
+  free(store->data);
+  store->data = data;
+  store->capacity = capacity;
+  body_store_place_arrays(store);
+  store->asleep = realloc(store->asleep, capacity * sizeof(bool));
+  store->bodies = realloc(store->bodies, capacity * sizeof(body_t *));
+  assert(store->asleep != NULL && store->bodies != NULL);
+}
+
+/**
+ * Copies one body's state from one store to another.
+ */
+void body_store_copy(body_store_t *to, size_t to_index, body_store_t *from,
+                     size_t from_index) {
+  for (size_t i = 0; i < NUM_STORE_ARRAYS; i++) {
+    to->data[i * to->capacity + to_index] =
+        from->data[i * from->capacity + from_index];
+  }
+  to->asleep[to_index] = from->asleep[from_index];
+}
+
+/**
+ * Makes room for a body at the end of a store and moves the body's state
+ * there from its current store, if it has one.
+ */
+void body_store_append(body_store_t *store, body_t *body) {
+  if (store->size == store->capacity) {
+    body_store_reserve(store, store->capacity * 2);
+  }
+  size_t index = store->size++;
+  store->bodies[index] = body;
+  if (body->store != NULL) {
+    body_store_copy(store, index, body->store, body->index);
+  }
+  body->store = store;
+  body->index = index;
+}
+
+/**
+ * Gives a new body a store of its own, at rest at the given centroid.
+ */
+void body_own_store(body_t *body, vector_t centroid) {
+  body->store = NULL;
+  body_store_t *store = body_store_init(1);
+  body_store_append(store, body);
+  body->owns_store = true;
+  store->x[0] = centroid.x;
+  store->y[0] = centroid.y;
+  store->vx[0] = store->vy[0] = 0;
+  store->ax[0] = store->ay[0] = 0;
+  store->fx[0] = store->fy[0] = 0;
+  store->jx[0] = store->jy[0] = 0;
+  store->inv_mass[0] = 1 / body->mass;
+  store->start_x[0] = centroid.x;
+  store->start_y[0] = centroid.y;
+  store->start_vx[0] = store->start_vy[0] = 0;
+  store->asleep[0] = false;
+}
+
+void body_store_add(body_store_t *store, body_t *body) {
+  assert(body->owns_store);
+  body_store_t *own = body->store;
+  body_store_append(store, body);
+  body->owns_store = false;
+  body_store_free(own);
+}
+
+/**
+ * Closes the gap left at an index of a store by moving its last body there.
+ */
+void body_store_fill_gap(body_store_t *store, size_t index) {
+  size_t last = --store->size;
+  if (index != last) {
+    body_store_copy(store, index, store, last);
+    store->bodies[index] = store->bodies[last];
+    store->bodies[index]->index = index;
+  }
+}
+
+void body_store_remove(body_store_t *store, body_t *body) {
+  assert(body->store == store && !body->owns_store);
+  size_t index = body->index;
+  body_store_t *own = body_store_init(1);
+  body_store_append(own, body);
+  body->owns_store = true;
+  body_store_fill_gap(store, index);
+}
+
+void body_store_discard(body_store_t *store, body_t *body) {
+  assert(body->store == store && !body->owns_store);
+  body_store_fill_gap(store, body->index);
+  body->store = NULL;
+  body_free(body);
+}
+
+/**
+ * Integrates the awake bodies in a range of a store over a tick, and clears
+ * the forces and impulses of every body in it.
+ * Each array is only read and written at the loop index, so the loop can be
+ * vectorized; sleeping bodies are left in place with a select, not a branch.
+ */
+void body_store_integrate_range(body_store_t *store, size_t start,
+                                size_t end, double dt) {
+  double *x = store->x, *y = store->y;
+  double *vx = store->vx, *vy = store->vy;
+  double *ax = store->ax, *ay = store->ay;
+  double *fx = store->fx, *fy = store->fy;
+  double *jx = store->jx, *jy = store->jy;
+  double *inv_mass = store->inv_mass;
+  double *start_x = store->start_x, *start_y = store->start_y;
+  double *start_vx = store->start_vx, *start_vy = store->start_vy;
+  bool *asleep = store->asleep;
+  for (size_t i = start; i < end; i++) {
+    start_x[i] = x[i];
+    start_y[i] = y[i];
+    start_vx[i] = vx[i];
+    start_vy[i] = vy[i];
+    double final_vx = vx[i] + dt * ax[i] + inv_mass[i] * jx[i];
+    double final_vy = vy[i] + dt * ay[i] + inv_mass[i] * jy[i];
+    double moved_x = x[i] + dt * (0.5 * (vx[i] + final_vx));
+    double moved_y = y[i] + dt * (0.5 * (vy[i] + final_vy));
+    x[i] = asleep[i] ? x[i] : moved_x;
+    y[i] = asleep[i] ? y[i] : moved_y;
+    vx[i] = asleep[i] ? vx[i] : final_vx;
+    vy[i] = asleep[i] ? vy[i] : final_vy;
+    fx[i] = fy[i] = 0;
+    jx[i] = jy[i] = 0;
+  }
+}
+
+void body_store_integrate(body_store_t *store, double dt) {
+  body_store_integrate_range(store, 0, store->size, dt);
+}
+
+/**
+ * Allocates a body with a shape prototype, at rest at a centroid in a store
+ * of its own, with every other field at its default.
+ */
+body_t *body_alloc(shape_t *shape, vector_t centroid, double mass,
+                   rgb_color_t color) {
   body_t *b_new = malloc(sizeof(body_t));
   assert(b_new != NULL);
   b_new->shape = shape;
+  b_new->world_points = NULL;
+  b_new->world_pieces = NULL;
+  b_new->world_dirty = true;
+  b_new->sleep_ticks = 0;
+  b_new->proxy = 0;
+  b_new->slot = 0;
+  b_new->moves = 0;
+  b_new->fast = false;
+  b_new->field_mask = UINT32_MAX;
   b_new->mass = mass;
   b_new->color = color;
-  b_new->centroid = (vector_t)(polygon_centroid(shape));
   b_new->curr_angle = 0;
-  b_new->velocity = VEC_ZERO;
-  b_new->acceleration = VEC_ZERO;
-  b_new->total_force = VEC_ZERO;
-  b_new->total_impulse = VEC_ZERO;
+  b_new->info = NULL;
   b_new->info_freer = NULL;
   b_new->body_remove = false;
+  b_new->width = 0;
+  b_new->height = 0;
   b_new->lose = false;
   b_new->win = false;
   b_new->fan = false;
-  b_new->texture = NULL;
   b_new->ground = false;
   b_new->pull_mass = 0.0;
+  b_new->texture = NULL;
+  b_new->extras_refs = NULL;
+  body_own_store(b_new, centroid);
   return b_new;
 }
 
+body_t *body_init(list_t *shape, double mass, rgb_color_t color) {
+  shape_t *prototype = shape_init(shape);
+  return body_alloc(prototype, shape_get_origin(prototype), mass, color);
+}
+
+/**
+ * Gives up the body's share of its texture and info, returning whether it
+ * was the last body holding them.
+ */
+bool body_release_extras(body_t *body) {
+  if (body->extras_refs == NULL) {
+    return true;
+  }
+  assert(*body->extras_refs > 0);
+  (*body->extras_refs)--;
+  if (*body->extras_refs > 0) {
+    return false;
+  }
+  free(body->extras_refs);
+  return true;
+}
+
 void body_free(body_t *body) {
-  if(body->texture!=NULL){
-    SDL_DestroyTexture(body->texture);
+  if (body_release_extras(body)) {
+    if (body->texture != NULL) {
+      SDL_DestroyTexture(body->texture);
+    }
+    if (body->info_freer != NULL) {
+      body->info_freer(body->info);
+    }
+  }
+  if (body->world_points != NULL) {
+    list_free(body->world_points);
+  }
+  if (body->world_pieces != NULL) {
+    list_free(body->world_pieces);
   }
-  if (body->info_freer != NULL) {
-    body->info_freer(body->info);
+  if (body->owns_store) {
+    body_store_free(body->store);
   }
-  list_free(body->shape);
+  shape_release(body->shape);
   free(body);
 }
 
+/**
+ * Copies a body's fields, sharing its shape, texture and info.
+ * The copy still points at the original's store.
+ */
+body_t *body_copy_fields(body_t *body) {
+  if (body->extras_refs == NULL) {
+    body->extras_refs = malloc(sizeof(size_t));
+    assert(body->extras_refs != NULL);
+    *body->extras_refs = 1;
+  }
+  (*body->extras_refs)++;
+  body_t *clone = malloc(sizeof(body_t));
+  assert(clone != NULL);
+  *clone = *body;
+  clone->shape = shape_acquire(body->shape);
+  clone->world_points = NULL;
+  clone->world_pieces = NULL;
+  clone->world_dirty = true;
+  return clone;
+}
+
+body_t *body_clone(body_t *body) {
+  body_t *clone = body_copy_fields(body);
+  // Copies the body's state out of its store into one of the clone's own
+  body_store_append(body_store_init(1), clone);
+  clone->owns_store = true;
+  return clone;
+}
+
+void body_store_copy_state(body_store_t *store, body_store_t *from) {
+  assert(store->size == 0);
+  body_store_reserve(store, from->size);
+  for (size_t i = 0; i < NUM_STORE_ARRAYS; i++) {
+    memcpy(store->data + i * store->capacity, from->data + i * from->capacity,
+           from->size * sizeof(double));
+  }
+  memcpy(store->asleep, from->asleep, from->size * sizeof(bool));
+  store->size = from->size;
+}
+
+body_t *body_clone_into(body_t *body, body_store_t *store) {
+  assert(!body->owns_store && body->index < store->size);
+  body_t *clone = body_copy_fields(body);
+  clone->store = store;
+  store->bodies[clone->index] = clone;
+  return clone;
+}
+
 list_t *body_get_shape(body_t *body) {
-  list_t *return_shape = list_init(list_size(body->shape), free);
-  for (int i = 0; i < list_size(body->shape); i++) {
-    vector_t *v = malloc(sizeof(vector_t));
-    v->x = ((vector_t *)list_get(body->shape, i))->x;
-    v->y = ((vector_t *)list_get(body->shape, i))->y;
-    list_add(return_shape, v);
+  return shape_place(shape_get_points(body->shape), body_get_centroid(body),
+                     body->curr_angle);
+}
+
+/**
+ * Brings the cached world-space vertices up to date with the body's transform.
+ * The caches are allocated the first time they are needed and then
+ * overwritten in place.
+ */
+void body_update_world(body_t *body) {
+  if (!body->world_dirty) {
+    return;
   }
-  return return_shape;
+  list_t *points = shape_get_points(body->shape);
+  list_t *pieces = shape_get_pieces(body->shape);
+  vector_t centroid = body_get_centroid(body);
+  if (body->world_points == NULL) {
+    body->world_points = shape_place(points, centroid, body->curr_angle);
+    if (pieces != NULL) {
+      body->world_pieces =
+          list_init(list_size(pieces), (free_func_t)list_free);
+      for (size_t i = 0; i < list_size(pieces); i++) {
+        list_add(body->world_pieces,
+                 shape_place(list_get(pieces, i), centroid,
+                             body->curr_angle));
+      }
+    }
+  } else {
+    shape_place_into(points, centroid, body->curr_angle,
+                     body->world_points);
+    if (pieces != NULL) {
+      for (size_t i = 0; i < list_size(pieces); i++) {
+        shape_place_into(list_get(pieces, i), centroid,
+                         body->curr_angle, list_get(body->world_pieces, i));
+      }
+    }
+  }
+  body->world_dirty = false;
+}
+
+list_t *body_borrow_shape(body_t *body) {
+  body_update_world(body);
+  return body->world_points;
+}
+
+list_t *body_get_pieces(body_t *body) {
+  body_update_world(body);
+  return body->world_pieces;
 }
 
 void body_set_color(body_t *body, rgb_color_t col) { body->color = col; }
 
 double body_get_mass(body_t *body) { return body->mass; }
 
-vector_t body_get_centroid(body_t *body) { return body->centroid; }
+vector_t body_get_centroid(body_t *body) {
+  return (vector_t){body->store->x[body->index], body->store->y[body->index]};
+}
+
+vector_t body_get_velocity(body_t *body) {
+  return (vector_t){body->store->vx[body->index],
+                    body->store->vy[body->index]};
+}
 
-vector_t body_get_velocity(body_t *body) { return body->velocity; }
+vector_t body_get_acceleration(body_t *body) {
+  return (vector_t){body->store->ax[body->index],
+                    body->store->ay[body->index]};
+}
 
-vector_t body_get_acceleration(body_t *body) { return body->acceleration; }
+vector_t body_get_total_force(body_t *body) {
+  return (vector_t){body->store->fx[body->index],
+                    body->store->fy[body->index]};
+}
 
-vector_t body_get_total_force(body_t *body) { return body->total_force; }
+vector_t body_get_total_impulse(body_t *body) {
+  return (vector_t){body->store->jx[body->index],
+                    body->store->jy[body->index]};
+}
 
-vector_t body_get_total_impulse(body_t *body) { return body->total_impulse; }
+vector_t body_get_tick_start(body_t *body) {
+  return (vector_t){body->store->start_x[body->index],
+                    body->store->start_y[body->index]};
+}
 
 rgb_color_t body_get_color(body_t *body) { return body->color; }
 
 void body_set_centroid(body_t *body, vector_t x) {
-  polygon_translate(body->shape, vec_subtract(x, body->centroid));
-  body->centroid = x;
+  body_store_t *store = body->store;
+  size_t i = body->index;
+  if (x.x != store->x[i] || x.y != store->y[i]) {
+    store->x[i] = x.x;
+    store->y[i] = x.y;
+    body->world_dirty = true;
+    body->moves++;
+    body_wake(body);
+  }
 }
 
-void body_set_velocity(body_t *body, vector_t v) { body->velocity = v; }
+void body_set_velocity(body_t *body, vector_t v) {
+  body_store_t *store = body->store;
+  size_t i = body->index;
+  if (v.x != store->vx[i] || v.y != store->vy[i]) {
+    store->vx[i] = v.x;
+    store->vy[i] = v.y;
+    body_wake(body);
+  }
+}
 
-void body_set_xvelocity(body_t *body, double x) { body->velocity.x = x; }
+void body_set_xvelocity(body_t *body, double x) {
+  body_set_velocity(body, (vector_t){x, body->store->vy[body->index]});
+}
 
-void body_set_yvelocity(body_t *body, double y) { body->velocity.y = y; }
+void body_set_yvelocity(body_t *body, double y) {
+  body_set_velocity(body, (vector_t){body->store->vx[body->index], y});
+}
 
-void body_set_acceleration(body_t *body, vector_t a) { body->acceleration = a; }
+void body_set_acceleration(body_t *body, vector_t a) {
+  body_store_t *store = body->store;
+  size_t i = body->index;
+  if (a.x != store->ax[i] || a.y != store->ay[i]) {
+    store->ax[i] = a.x;
+    store->ay[i] = a.y;
+    body_wake(body);
+  }
+}
 
 void body_set_rotation(body_t *body, double angle) {
-  double delta_angle = angle - body->curr_angle;
-  body->curr_angle = angle;
-  polygon_rotate(body->shape, delta_angle, body->centroid);
+  if (angle != body->curr_angle) {
+    body->curr_angle = angle;
+    body->world_dirty = true;
+    body->moves++;
+    body_wake(body);
+  }
 }
 
-void body_tick(body_t *body, double dt) {
-
-  vector_t v_initial = body->velocity;
+bool body_is_asleep(body_t *body) {
+  return body->store->asleep[body->index];
+}
 
-  vector_t imp_v = vec_multiply(1 / body->mass, body->total_impulse);
+void body_wake(body_t *body) {
+  if (body->store->asleep[body->index]) {
+    body->store->asleep[body->index] = false;
+    body->sleep_ticks = 0;
+  }
+}
 
-  vector_t v_final = v_initial;
-  
-  v_final = vec_add(v_final, vec_multiply(dt, body->acceleration));
+void body_sleep(body_t *body) {
+  body->store->asleep[body->index] = true;
+  body->store->vx[body->index] = 0;
+  body->store->vy[body->index] = 0;
+}
 
-  v_final = vec_add(v_final, imp_v);
+bool body_is_resting(body_t *body) {
+  return body_is_asleep(body) || body->sleep_ticks > 0;
+}
 
-  vector_t move = vec_multiply(0.5, vec_add(v_initial, v_final));
-  move = vec_multiply(dt, move);
+/**
+ * Counts how long a body has been at rest and puts it to sleep once it has
+ * stayed at rest for SLEEP_TICKS ticks.
+ * The acceleration used is the change in velocity over the tick, so a body
+ * held still by a contact (e.g. resting on a platform under gravity) counts
+ * as at rest.
+ */
+void body_update_sleep(body_t *body, vector_t v_initial, double dt) {
+  vector_t velocity = body_get_velocity(body);
+  vector_t dv = vec_subtract(velocity, v_initial);
+  double speed_sq = vec_dot(velocity, velocity);
+  if (dt <= 0 || speed_sq > SLEEP_SPEED * SLEEP_SPEED ||
+      vec_dot(dv, dv) > SLEEP_ACCELERATION * SLEEP_ACCELERATION * dt * dt) {
+    body->sleep_ticks = 0;
+    return;
+  }
+  body->sleep_ticks++;
+  if (body->sleep_ticks >= SLEEP_TICKS) {
+    body_sleep(body);
+  }
+}
 
-  body_set_centroid(body, vec_add(body->centroid, move));
-  body_set_velocity(body, v_final);
-  body->total_force = VEC_ZERO;
-  body->total_impulse = VEC_ZERO;
+void body_finish_tick(body_t *body, double dt) {
+  body_store_t *store = body->store;
+  size_t i = body->index;
   body->ground = false;
   body->pull_mass = 0.0;
+  if (store->asleep[i]) {
+    return;
+  }
+  if (store->x[i] != store->start_x[i] || store->y[i] != store->start_y[i]) {
+    body->world_dirty = true;
+    body->moves++;
+  }
+  body_update_sleep(body, (vector_t){store->start_vx[i], store->start_vy[i]},
+                    dt);
+}
+
+void body_tick(body_t *body, double dt) {
+  body_store_integrate_range(body->store, body->index, body->index + 1, dt);
+  body_finish_tick(body, dt);
 }
 
 void body_add_force(body_t *body, vector_t force) {
-  body->total_force = vec_add(body->total_force, force);
-  
-  double accel_x = body->total_force.x / body->mass;
-  double accel_y = body->total_force.y / body->mass;
-  body->acceleration = (vector_t){accel_x, accel_y};
+  if (force.x != 0.0 || force.y != 0.0) {
+    body_wake(body);
+  }
+  body_store_t *store = body->store;
+  size_t i = body->index;
+  store->fx[i] += force.x;
+  store->fy[i] += force.y;
+
+  store->ax[i] = store->fx[i] / body->mass;
+  store->ay[i] = store->fy[i] / body->mass;
 }
 
 void body_add_impulse(body_t *body, vector_t impulse) {
-  body->total_impulse = vec_add(body->total_impulse, impulse);
+  if (impulse.x != 0.0 || impulse.y != 0.0) {
+    body_wake(body);
+  }
+  body->store->jx[body->index] += impulse.x;
+  body->store->jy[body->index] += impulse.y;
 }
 
 body_t *body_init_with_info(list_t *shape, double mass, rgb_color_t color,
                             void *info, free_func_t info_freer) {
-  body_t *b_new = malloc(sizeof(body_t));
-  assert(b_new != NULL);
-  b_new->shape = shape;
-  b_new->mass = mass;
-  b_new->color = color;
-  b_new->centroid = (vector_t)(polygon_centroid(shape));
-  b_new->curr_angle = 0;
-  b_new->velocity = VEC_ZERO;
-  b_new->acceleration = VEC_ZERO;
-  b_new->total_force = VEC_ZERO;
-  b_new->total_impulse = VEC_ZERO;
+  body_t *b_new = body_init(shape, mass, color);
   b_new->info = info;
   b_new->info_freer = info_freer;
-  b_new->body_remove = false;
-  b_new->lose = false;
-  b_new->win = false;
-  b_new->fan = false;
-  b_new->ground = false;
-  b_new->pull_mass = 0.0;
-  b_new->texture = NULL;
   return b_new;
 }
 
 body_t *body_init_more_info(list_t *shape, double mass, rgb_color_t color, double width, double height) {
-  body_t *b_new = malloc(sizeof(body_t));
-  assert(b_new != NULL);
-  b_new->shape = shape;
-  b_new->mass = mass;
-  b_new->color = color;
-  b_new->centroid = (vector_t)(polygon_centroid(shape));
-  b_new->curr_angle = 0;
-  b_new->velocity = VEC_ZERO;
-  b_new->acceleration = VEC_ZERO;
-  b_new->total_force = VEC_ZERO;
-  b_new->total_impulse = VEC_ZERO;
-  b_new->info_freer = NULL;
-  b_new->body_remove = false;
+  body_t *b_new = body_init(shape, mass, color);
+  b_new->width = width;
+  b_new->height = height;
+  return b_new;
+}
+
+body_t *body_init_with_shape(shape_t *shape, vector_t centroid, double mass,
+                             rgb_color_t color, double width, double height) {
+  body_t *b_new = body_alloc(shape_acquire(shape), centroid, mass, color);
   b_new->width = width;
   b_new->height = height;
-  b_new->lose = false;
-  b_new->win = false;
-  b_new->fan = false;
-  b_new->ground = false;
-  b_new->pull_mass = 0.0;
-  b_new->texture = NULL;
   return b_new;
 }
 
@@ -230,4 +679,105 @@ double body_get_width(body_t *body) { return body->width; }
 
 free_func_t body_get_info_freer(body_t *body) { return body->info_freer; }
 
+size_t body_get_proxy(body_t *body) { return body->proxy; }
+
+void body_set_proxy(body_t *body, size_t proxy) { body->proxy = proxy; }
 
+size_t body_get_slot(body_t *body) { return body->slot; }
+
+void body_set_slot(body_t *body, size_t slot) { body->slot = slot; }
+
+size_t body_get_moves(body_t *body) { return body->moves; }
+
+void body_set_fast(body_t *body, bool fast) { body->fast = fast; }
+
+bool body_is_fast(body_t *body) { return body->fast; }
+
+void body_set_field_mask(body_t *body, uint32_t mask) {
+  body->field_mask = mask;
+}
+
+uint32_t body_get_field_mask(body_t *body) { return body->field_mask; }
+
+body_state_t body_get_state(body_t *body) {
+  return (body_state_t){.centroid = body_get_centroid(body),
+                        .velocity = body_get_velocity(body),
+                        .acceleration = body_get_acceleration(body),
+                        .angle = body->curr_angle,
+                        .total_force = body_get_total_force(body),
+                        .total_impulse = body_get_total_impulse(body),
+                        .asleep = body_is_asleep(body),
+                        .sleep_ticks = body->sleep_ticks,
+                        .removed = body->body_remove,
+                        .lose = body->lose,
+                        .win = body->win,
+                        .fan = body->fan,
+                        .ground = body->ground,
+                        .pull_mass = body->pull_mass,
+                        .field_mask = body->field_mask};
+}
+
+void body_set_state(body_t *body, body_state_t state) {
+  body_store_t *store = body->store;
+  size_t i = body->index;
+  if (state.centroid.x != store->x[i] || state.centroid.y != store->y[i] ||
+      state.angle != body->curr_angle) {
+    body->world_dirty = true;
+    body->moves++;
+  }
+  store->x[i] = state.centroid.x;
+  store->y[i] = state.centroid.y;
+  store->vx[i] = state.velocity.x;
+  store->vy[i] = state.velocity.y;
+  store->ax[i] = state.acceleration.x;
+  store->ay[i] = state.acceleration.y;
+  body->curr_angle = state.angle;
+  store->fx[i] = state.total_force.x;
+  store->fy[i] = state.total_force.y;
+  store->jx[i] = state.total_impulse.x;
+  store->jy[i] = state.total_impulse.y;
+  store->asleep[i] = state.asleep;
+  body->sleep_ticks = state.sleep_ticks;
+  body->body_remove = state.removed;
+  body->lose = state.lose;
+  body->win = state.win;
+  body->fan = state.fan;
+  body->ground = state.ground;
+  body->pull_mass = state.pull_mass;
+  body->field_mask = state.field_mask;
+}
+
+uint64_t hash_bytes(uint64_t hash, const void *bytes, size_t size) {
+  const unsigned char *data = bytes;
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ data[i]) * HASH_PRIME;
+  }
+  return hash;
+}
+
+/**
+ * Mixes a vector's exact bits into a hash.
+ */
+uint64_t hash_vector(uint64_t hash, vector_t v) {
+  hash = hash_bytes(hash, &v.x, sizeof(double));
+  return hash_bytes(hash, &v.y, sizeof(double));
+}
+
+uint64_t body_hash(body_t *body) {
+  // Hash field by field, since the state struct has padding
+  body_state_t state = body_get_state(body);
+  uint64_t hash = HASH_SEED;
+  hash = hash_vector(hash, state.centroid);
+  hash = hash_vector(hash, state.velocity);
+  hash = hash_vector(hash, state.acceleration);
+  hash = hash_bytes(hash, &state.angle, sizeof(double));
+  hash = hash_vector(hash, state.total_force);
+  hash = hash_vector(hash, state.total_impulse);
+  uint8_t flags[] = {state.asleep, state.removed, state.lose,
+                     state.win,    state.fan,     state.ground};
+  hash = hash_bytes(hash, flags, sizeof(flags));
+  uint64_t sleep_ticks = state.sleep_ticks;
+  hash = hash_bytes(hash, &sleep_ticks, sizeof(sleep_ticks));
+  hash = hash_bytes(hash, &state.pull_mass, sizeof(double));
+  return hash_bytes(hash, &state.field_mask, sizeof(uint32_t));
+}
@@ -33,69 +33,145 @@ vector_t calculate_projection(vector_t perp, list_t *body) {
   return projection;
 }
 
-list_t *calculate_axes(list_t *shape) {
-  list_t *axes = list_init(list_size(shape), free);
+/**
+ * Appends the unit normal of each edge of a shape to an array of axes.
+ */
+void calculate_axes(list_t *shape, vector_array_t *axes) {
+  vector_array_reserve(axes, vector_array_size(axes) + list_size(shape));
   for (size_t i = 0; i < list_size(shape); i++) {
     vector_t *p1 = (vector_t *)list_get(shape, i);
     vector_t *p2 = (vector_t *)list_get(shape, (i + 1) % list_size(shape));
     vector_t new_perp = vec_perpendicular(vec_subtract(*p1, *p2));
-    vector_t *vp = malloc(sizeof(vector_t));
     double length = sqrt(new_perp.x * new_perp.x + new_perp.y * new_perp.y);
-    vp->x = new_perp.x / length;
-    vp->y = new_perp.y / length;
-    list_add(axes, vp);
+    vector_array_add(axes, (vector_t){.x = new_perp.x / length,
+                                      .y = new_perp.y / length});
   }
-  return axes;
 }
 
 collision_info_t find_collision(list_t *shape1, list_t *shape2) {
   bool collision = true;
 
-  list_t *axis1 = calculate_axes(shape1);
-  list_t *axis2 = calculate_axes(shape2);
-
-  vector_t projection1;
-  vector_t projection2;
+  // The axes of both shapes, shape1's first
+  vector_array_t axes;
+  vector_array_init(&axes, list_size(shape1) + list_size(shape2));
+  calculate_axes(shape1, &axes);
+  calculate_axes(shape2, &axes);
 
   double min_overlap = INFINITY;
   vector_t min = VEC_ZERO;
 
-  for (size_t i = 0; i < list_size(axis1);
-       i++) {
-    projection1 = calculate_projection(*(vector_t *)list_get(axis1, i), shape1);
-    projection2 = calculate_projection(*(vector_t *)list_get(axis1, i), shape2);
+  for (vector_t *axis = vector_array_begin(&axes);
+       axis != vector_array_end(&axes); axis++) {
+    vector_t projection1 = calculate_projection(*axis, shape1);
+    vector_t projection2 = calculate_projection(*axis, shape2);
     double ov = overlap(projection1, projection2);
     if (ov < 0) {
       collision = false;
       break;
     } else if (ov < min_overlap) {
       min_overlap = ov;
-      min = *(vector_t *)list_get(axis1, i);
+      min = *axis;
     }
   }
+  collision_info_t collide = {.collided = false};
   if (collision) {
-    for (size_t i = 0; i < list_size(axis2);
-         i++) { // calculating projections for shape 1, checking for overlap
-      projection1 =
-          calculate_projection(*(vector_t *)list_get(axis2, i), shape1);
-      projection2 =
-          calculate_projection(*(vector_t *)list_get(axis2, i), shape2);
-      double ov = overlap(projection1, projection2);
-      if (ov < 0) {
-        collision = false;
-        break;
-      } else if (ov < min_overlap) {
-        min_overlap = ov;
-        min = *(vector_t *)list_get(axis2, i);
+    collide = (collision_info_t){
+        .collided = true, .axis = min, .depth = min_overlap};
+  }
+
+  vector_array_free(&axes);
+  return collide;
+}
+
+aabb_t find_bounds(list_t *shape) {
+  vector_t first = *(vector_t *)list_get(shape, 0);
+  aabb_t box = {.min = first, .max = first};
+  for (size_t i = 1; i < list_size(shape); i++) {
+    vector_t *v = list_get(shape, i);
+    box.min.x = fmin(box.min.x, v->x);
+    box.min.y = fmin(box.min.y, v->y);
+    box.max.x = fmax(box.max.x, v->x);
+    box.max.y = fmax(box.max.y, v->y);
+  }
+  return box;
+}
+
+bool aabb_overlap(aabb_t box1, aabb_t box2) {
+  return box1.min.x <= box2.max.x && box2.min.x <= box1.max.x &&
+         box1.min.y <= box2.max.y && box2.min.y <= box1.max.y;
+}
+
+sweep_info_t aabb_sweep(aabb_t moving, vector_t displacement, aabb_t fixed) {
+  sweep_info_t sweep = {.hit = false};
+  double deltas[2] = {displacement.x, displacement.y};
+  double moving_mins[2] = {moving.min.x, moving.min.y};
+  double moving_maxes[2] = {moving.max.x, moving.max.y};
+  double fixed_mins[2] = {fixed.min.x, fixed.min.y};
+  double fixed_maxes[2] = {fixed.max.x, fixed.max.y};
+  // The boxes overlap while the times on both axes overlap
+  double entry = -INFINITY;
+  double exit = INFINITY;
+  size_t entry_axis = 0;
+  for (size_t i = 0; i < 2; i++) {
+    double axis_entry;
+    double axis_exit;
+    if (deltas[i] == 0) {
+      if (moving_maxes[i] <= fixed_mins[i] ||
+          moving_mins[i] >= fixed_maxes[i]) {
+        return sweep;
       }
+      continue;
+    } else if (deltas[i] > 0) {
+      axis_entry = (fixed_mins[i] - moving_maxes[i]) / deltas[i];
+      axis_exit = (fixed_maxes[i] - moving_mins[i]) / deltas[i];
+    } else {
+      axis_entry = (fixed_maxes[i] - moving_mins[i]) / deltas[i];
+      axis_exit = (fixed_mins[i] - moving_maxes[i]) / deltas[i];
+    }
+    if (axis_entry > entry) {
+      entry = axis_entry;
+      entry_axis = i;
     }
+    exit = fmin(exit, axis_exit);
   }
-  collision_info_t collide = {.collided = false};
-  if (collision) {
-    collide = (collision_info_t){.collided = true, .axis = min};
+  if (entry >= exit || entry < 0 || entry >= 1) {
+    return sweep;
   }
+  sweep.hit = true;
+  sweep.time = entry;
+  double away = deltas[entry_axis] > 0 ? -1 : 1;
+  sweep.normal = entry_axis == 0 ? (vector_t){away, 0} : (vector_t){0, away};
+  return sweep;
+}
 
-  list_free(axis1);
-  list_free(axis2);
-  return collide;
+collision_info_t find_body_collision(body_t *body1, body_t *body2) {
+  list_t *pieces1 = body_get_pieces(body1);
+  list_t *pieces2 = body_get_pieces(body2);
+  list_t *shape1 = pieces1 == NULL ? body_borrow_shape(body1) : NULL;
+  list_t *shape2 = pieces2 == NULL ? body_borrow_shape(body2) : NULL;
+
+  collision_info_t deepest = {.collided = false};
+  if (shape1 != NULL && shape2 != NULL) {
+    deepest = find_collision(shape1, shape2);
+  } else {
+    size_t count1 = pieces1 == NULL ? 1 : list_size(pieces1);
+    size_t count2 = pieces2 == NULL ? 1 : list_size(pieces2);
+    for (size_t i = 0; i < count1; i++) {
+      list_t *piece1 = pieces1 == NULL ? shape1 : list_get(pieces1, i);
+      aabb_t box1 = find_bounds(piece1);
+      for (size_t j = 0; j < count2; j++) {
+        list_t *piece2 = pieces2 == NULL ? shape2 : list_get(pieces2, j);
+        if (!aabb_overlap(box1, find_bounds(piece2))) {
+          continue;
+        }
+        collision_info_t collide = find_collision(piece1, piece2);
+        if (collide.collided &&
+            (!deepest.collided || collide.depth > deepest.depth)) {
+          deepest = collide;
+        }
+      }
+    }
+  }
+
+  return deepest;
 }
@@ -0,0 +1,286 @@
+#include "contact_cache.h"
+#include "body.h"
+#include "collision.h"
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+const size_t INITIAL_PAIRS_GUESS = 16;
+
+/**
+ * What is known about one pair of bodies. The pair is stored with the body
+ * at the lower address first, and the collision axis points from that body
+ * towards the other.
+ */
+typedef struct pair_entry {
+  body_t *body1;
+  body_t *body2;
+  // The bodies' move counters when the collision was computed
+  size_t moves1;
+  size_t moves2;
+  bool computed;
+  collision_info_t collision;
+  bool touching;
+  // Whether the bodies were touching when the tick began
+  bool was_touching;
+  size_t checked_tick;
+  double impulse;
+  size_t impulse_tick;
+} pair_entry_t;
+
+typedef struct contact_cache {
+  // Sorted by body pair
+  pair_entry_t *pairs;
+  size_t num_pairs;
+  size_t capacity;
+  // Starts at 1, so that a stamp of 0 means never
+  size_t tick;
+  size_t reused;
+} contact_cache_t;
+
+contact_cache_t *contact_cache_init(void) {
+  contact_cache_t *cache = malloc(sizeof(contact_cache_t));
+  assert(cache != NULL);
+  cache->capacity = INITIAL_PAIRS_GUESS;
+  cache->pairs = malloc(cache->capacity * sizeof(pair_entry_t));
+  assert(cache->pairs != NULL);
+  cache->num_pairs = 0;
+  cache->tick = 1;
+  cache->reused = 0;
+  return cache;
+}
+
+void contact_cache_free(contact_cache_t *cache) {
+  free(cache->pairs);
+  free(cache);
+}
+
+void contact_cache_clear(contact_cache_t *cache) {
+  cache->num_pairs = 0;
+  cache->reused = 0;
+}
+
+void contact_cache_begin_tick(contact_cache_t *cache) {
+  size_t kept = 0;
+  for (size_t i = 0; i < cache->num_pairs; i++) {
+    pair_entry_t *pair = &cache->pairs[i];
+    if (pair->touching || pair->checked_tick == cache->tick ||
+        pair->impulse_tick == cache->tick) {
+      cache->pairs[kept++] = *pair;
+    }
+  }
+  cache->num_pairs = kept;
+  cache->tick++;
+  cache->reused = 0;
+}
+
+/**
+ * Compares the pair (body1, body2) with an entry's pair, returning a
+ * negative, zero or positive value like strcmp().
+ * The first body of the pair must be at the lower address.
+ */
+int pair_compare(body_t *body1, body_t *body2, pair_entry_t *pair) {
+  uintptr_t keys1[2] = {(uintptr_t)body1, (uintptr_t)body2};
+  uintptr_t keys2[2] = {(uintptr_t)pair->body1, (uintptr_t)pair->body2};
+  for (size_t i = 0; i < 2; i++) {
+    if (keys1[i] != keys2[i]) {
+      return keys1[i] < keys2[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Orders entries by body pair, for sorting a cache whose bodies were
+ * replaced.
+ */
+int pair_entry_compare(const void *a, const void *b) {
+  pair_entry_t *pair = (pair_entry_t *)b;
+  return pair_compare(((const pair_entry_t *)a)->body1,
+                      ((const pair_entry_t *)a)->body2, pair);
+}
+
+void contact_cache_copy(contact_cache_t *cache, contact_cache_t *from,
+                        item_mapper_t mapper, void *context) {
+  if (cache->capacity < from->num_pairs) {
+    cache->capacity = from->num_pairs;
+    cache->pairs =
+        realloc(cache->pairs, cache->capacity * sizeof(pair_entry_t));
+    assert(cache->pairs != NULL);
+  }
+  cache->num_pairs = 0;
+  cache->tick = from->tick;
+  cache->reused = from->reused;
+  for (size_t i = 0; i < from->num_pairs; i++) {
+    pair_entry_t pair = from->pairs[i];
+    pair.body1 = mapper(context, pair.body1);
+    pair.body2 = mapper(context, pair.body2);
+    if (pair.body1 == NULL || pair.body2 == NULL) {
+      continue;
+    }
+    // The copies may lie the other way around in memory
+    if ((uintptr_t)pair.body1 > (uintptr_t)pair.body2) {
+      body_t *temp = pair.body1;
+      pair.body1 = pair.body2;
+      pair.body2 = temp;
+      size_t moves = pair.moves1;
+      pair.moves1 = pair.moves2;
+      pair.moves2 = moves;
+      pair.collision.axis = vec_negate(pair.collision.axis);
+    }
+    cache->pairs[cache->num_pairs++] = pair;
+  }
+  qsort(cache->pairs, cache->num_pairs, sizeof(pair_entry_t),
+        pair_entry_compare);
+}
+
+/**
+ * Finds where a pair is, or would be inserted, with a binary search.
+ * The first body of the pair must be at the lower address.
+ */
+size_t contact_cache_search(contact_cache_t *cache, body_t *body1,
+                            body_t *body2) {
+  size_t low = 0;
+  size_t high = cache->num_pairs;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (pair_compare(body1, body2, &cache->pairs[mid]) > 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+/**
+ * Finds the entry for two bodies given in either order, or NULL.
+ */
+pair_entry_t *contact_cache_find(contact_cache_t *cache, body_t *body1,
+                                 body_t *body2) {
+  if ((uintptr_t)body1 > (uintptr_t)body2) {
+    body_t *temp = body1;
+    body1 = body2;
+    body2 = temp;
+  }
+  size_t index = contact_cache_search(cache, body1, body2);
+  if (index == cache->num_pairs ||
+      pair_compare(body1, body2, &cache->pairs[index]) != 0) {
+    return NULL;
+  }
+  return &cache->pairs[index];
+}
+
+/**
+ * Finds the entry for two bodies given in either order,
+ * adding an empty one if the pair is new.
+ */
+pair_entry_t *contact_cache_find_or_add(contact_cache_t *cache, body_t *body1,
+                                        body_t *body2) {
+  if ((uintptr_t)body1 > (uintptr_t)body2) {
+    body_t *temp = body1;
+    body1 = body2;
+    body2 = temp;
+  }
+  size_t index = contact_cache_search(cache, body1, body2);
+  if (index < cache->num_pairs &&
+      pair_compare(body1, body2, &cache->pairs[index]) == 0) {
+    return &cache->pairs[index];
+  }
+  if (cache->num_pairs == cache->capacity) {
+    cache->capacity *= 2;
+    cache->pairs =
+        realloc(cache->pairs, cache->capacity * sizeof(pair_entry_t));
+    assert(cache->pairs != NULL);
+  }
+  memmove(&cache->pairs[index + 1], &cache->pairs[index],
+          (cache->num_pairs - index) * sizeof(pair_entry_t));
+  cache->num_pairs++;
+  cache->pairs[index] = (pair_entry_t){.body1 = body1, .body2 = body2};
+  return &cache->pairs[index];
+}
+
+/**
+ * Compares whether a pair is touching now with whether it was when the tick
+ * began.
+ */
+contact_event_t pair_event(pair_entry_t *pair) {
+  if (pair->touching) {
+    return pair->was_touching ? CONTACT_STAY : CONTACT_ENTER;
+  }
+  return pair->was_touching ? CONTACT_EXIT : CONTACT_NONE;
+}
+
+contact_result_t contact_cache_collide(contact_cache_t *cache, body_t *body1,
+                                       body_t *body2) {
+  pair_entry_t *pair = contact_cache_find_or_add(cache, body1, body2);
+  if (pair->checked_tick != cache->tick) {
+    pair->was_touching = pair->touching;
+    pair->checked_tick = cache->tick;
+  }
+  size_t moves1 = body_get_moves(pair->body1);
+  size_t moves2 = body_get_moves(pair->body2);
+  if (pair->computed && pair->moves1 == moves1 && pair->moves2 == moves2) {
+    cache->reused++;
+  } else {
+    pair->collision = find_body_collision(pair->body1, pair->body2);
+    pair->moves1 = moves1;
+    pair->moves2 = moves2;
+    pair->computed = true;
+  }
+  pair->touching = pair->collision.collided;
+
+  contact_result_t result = {.collision = pair->collision,
+                             .event = pair_event(pair)};
+  if (pair->touching && body1 != pair->body1) {
+    result.collision.axis = vec_negate(result.collision.axis);
+  }
+  return result;
+}
+
+contact_event_t contact_cache_event(contact_cache_t *cache, body_t *body1,
+                                    body_t *body2) {
+  pair_entry_t *pair = contact_cache_find(cache, body1, body2);
+  if (pair == NULL || pair->checked_tick != cache->tick) {
+    return CONTACT_NONE;
+  }
+  return pair_event(pair);
+}
+
+size_t contact_cache_reused(contact_cache_t *cache) { return cache->reused; }
+
+size_t contact_cache_size(contact_cache_t *cache) { return cache->num_pairs; }
+
+void contact_cache_set_impulse(contact_cache_t *cache, body_t *body1,
+                               body_t *body2, double impulse) {
+  pair_entry_t *pair = contact_cache_find_or_add(cache, body1, body2);
+  pair->impulse = impulse;
+  pair->impulse_tick = cache->tick;
+}
+
+double contact_cache_get_impulse(contact_cache_t *cache, body_t *body1,
+                                 body_t *body2) {
+  pair_entry_t *pair = contact_cache_find(cache, body1, body2);
+  return pair == NULL || pair->impulse_tick != cache->tick ? 0
+                                                           : pair->impulse;
+}
+
+double contact_cache_previous_impulse(contact_cache_t *cache, body_t *body1,
+                                      body_t *body2) {
+  pair_entry_t *pair = contact_cache_find(cache, body1, body2);
+  return pair == NULL || pair->impulse_tick + 1 != cache->tick
+             ? 0
+             : pair->impulse;
+}
+
+void contact_cache_forget(contact_cache_t *cache, body_t *body) {
+  size_t kept = 0;
+  for (size_t i = 0; i < cache->num_pairs; i++) {
+    pair_entry_t *pair = &cache->pairs[i];
+    if (pair->body1 != body && pair->body2 != body) {
+      cache->pairs[kept++] = *pair;
+    }
+  }
+  cache->num_pairs = kept;
+}
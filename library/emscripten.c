@@ -1,13 +1,113 @@
 #include "math.h"
+#include "replay.h"
 #include "sdl_wrapper.h"
 #include "state.h"
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
 #endif
 
 state_t *state;
+/**
+ * The session being recorded or replayed, or NULL.
+ */
+replay_t *session = NULL;
+/**
+ * Where to save the session being recorded, or NULL if it is being replayed.
+ */
+char *session_path = NULL;
+/**
+ * The value of clock() when the replay started.
+ */
+clock_t replay_start;
+/**
+ * While replaying, the trace of the scene's hashes being written or checked
+ * against, or NULL, and the index of the next tick.
+ */
+FILE *hash_trace = NULL;
+bool checking_hashes = false;
+size_t session_tick = 0;
+
+/**
+ * Adds the tick that just ran to the hash trace, or checks it against the
+ * trace and exits at the first tick that differs.
+ */
+void trace_tick() {
+  scene_t *scene = hash_trace == NULL ? NULL : emscripten_get_scene(state);
+  size_t tick = session_tick++;
+  if (scene == NULL) {
+    return;
+  }
+  if (!checking_hashes) {
+    replay_write_hashes(hash_trace, tick, scene);
+    return;
+  }
+  size_t body;
+  switch (replay_check_hashes(hash_trace, tick, scene, &body)) {
+  case TRACE_MATCH:
+    return;
+  case TRACE_MISSING:
+    fprintf(stderr, "Diverged at tick %zu: the bodies or ticks differ\n",
+            tick);
+    break;
+  case TRACE_BODY:
+    fprintf(stderr, "Diverged at tick %zu: body %zu differs\n", tick, body);
+    break;
+  case TRACE_COUNTER:
+    fprintf(stderr, "Diverged at tick %zu: the counter differs\n", tick);
+    break;
+  case TRACE_WIN:
+    fprintf(stderr, "Diverged at tick %zu: the win flag differs\n", tick);
+    break;
+  case TRACE_LOSE:
+    fprintf(stderr, "Diverged at tick %zu: the lose flag differs\n", tick);
+    break;
+  case TRACE_OTHER_BODIES:
+    fprintf(stderr, "Diverged at tick %zu: hidden or static bodies differ\n",
+            tick);
+    break;
+  }
+  exit(1);
+}
+
+/**
+ * Saves the session being recorded, or reports how fast the replay ran
+ * and exits if it did not reach the end of the trace being checked.
+ */
+void finish_session() {
+  if (session == NULL) {
+    return;
+  }
+  if (session_path != NULL) {
+    FILE *file = fopen(session_path, "wb");
+    if (file == NULL || !replay_write(session, file)) {
+      fprintf(stderr, "Could not save the recording to %s\n", session_path);
+    }
+    if (file != NULL) {
+      fclose(file);
+    }
+  } else {
+    double seconds = (double)(clock() - replay_start) / CLOCKS_PER_SEC;
+    printf("Replayed %zu ticks in %.3f s\n", replay_ticks(session), seconds);
+  }
+  // A replay that stops short of the trace did not run the same session
+  char next;
+  bool unchecked = checking_hashes && fscanf(hash_trace, " %c", &next) == 1;
+  if (hash_trace != NULL) {
+    fclose(hash_trace);
+  }
+  replay_free(session);
+  session = NULL;
+  if (unchecked) {
+    fprintf(stderr, "Diverged at tick %zu: the trace has more ticks\n",
+            session_tick);
+    exit(1);
+  }
+}
 
 void loop() {
   // If needed, generate a pointer to our initial state
@@ -16,9 +116,11 @@ void loop() {
   }
 
   emscripten_main(state);
+  trace_tick();
 
   if (sdl_is_done(state)) { // Once our demo exits...
     emscripten_free(state); // Free any state variables we've been using
+    finish_session();
 #ifdef __EMSCRIPTEN__ // Clean up emscripten environment (if we're using it)
     emscripten_cancel_main_loop();
     emscripten_force_exit(0);
@@ -29,7 +131,53 @@ void loop() {
   }
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+#ifndef __EMSCRIPTEN__
+  // "--record <file>" saves the session's input when the window is closed;
+  // "--replay <file>" re-runs a saved session without a window, as fast as
+  // it can. Either can also write the scene's hashes after every tick with
+  // "--hashes <trace>", and a replay can instead stop at the first tick that
+  // differs from an earlier trace with "--check <trace>".
+  bool recording = argc >= 3 && strcmp(argv[1], "--record") == 0;
+  bool replaying = argc >= 3 && strcmp(argv[1], "--replay") == 0;
+  if ((recording || replaying) && argc == 5) {
+    checking_hashes = strcmp(argv[3], "--check") == 0;
+    if (strcmp(argv[3], "--hashes") != 0 &&
+        !(replaying && checking_hashes)) {
+      fprintf(stderr, "Expected --hashes%s, not %s\n",
+              replaying ? " or --check" : "", argv[3]);
+      return 1;
+    }
+    hash_trace = fopen(argv[4], checking_hashes ? "r" : "w");
+    if (hash_trace == NULL) {
+      fprintf(stderr, "Could not open the trace %s\n", argv[4]);
+      return 1;
+    }
+  } else if ((recording || replaying) && argc != 3) {
+    fprintf(stderr, "Usage: %s --record|--replay <file> "
+                    "[--hashes|--check <trace>]\n",
+            argv[0]);
+    return 1;
+  }
+  if (recording) {
+    session = replay_init();
+    session_path = argv[2];
+    sdl_record(session);
+  } else if (replaying) {
+    FILE *file = fopen(argv[2], "rb");
+    if (file != NULL) {
+      session = replay_read(file);
+      fclose(file);
+    }
+    if (session == NULL) {
+      fprintf(stderr, "Could not read a recording from %s\n", argv[2]);
+      return 1;
+    }
+    sdl_set_headless(true);
+    sdl_replay(session);
+    replay_start = clock();
+  }
+#endif
 #ifdef __EMSCRIPTEN__
   // Set loop as the function emscripten calls to request a new frame
   emscripten_set_main_loop_arg(loop, NULL, 0, 1);
@@ -1,5 +1,6 @@
 #include "force.h"
 #include "list.h"
+#include "pool.h"
 #include "scene.h"
 #include <stdlib.h>
 
@@ -7,25 +8,60 @@ typedef struct force {
   force_creator_t forcer;
   void *aux;
   free_func_t freer;
-  list_t *relevant_bodies;
+  // The bodies the force was registered with, if any. The items come from
+  // the size-class pools and the array is never grown.
+  body_array_t relevant_bodies;
+  bool has_bodies;
+  size_t tag;
+  bool enabled;
+  aux_cloner_t cloner;
 } force_t;
 
 force_t *force_init(force_creator_t forcer, void *aux, free_func_t freer) {
-  force_t *f = malloc(sizeof(force_t));
+  force_t *f = pool_alloc_sized(sizeof(force_t));
   f->forcer = forcer;
   f->aux = aux;
   f->freer = freer;
-  f->relevant_bodies = NULL;
+  f->has_bodies = false;
+  f->tag = 0;
+  f->enabled = true;
+  f->cloner = NULL;
+  return f;
+}
+
+/**
+ * Gives a force room for the bodies it acts on and returns it.
+ */
+body_t **force_reserve_bodies(force_t *force, size_t num_bodies) {
+  force->has_bodies = true;
+  force->relevant_bodies = (body_array_t){
+      .items = pool_alloc_sized(num_bodies * sizeof(body_t *)),
+      .size = num_bodies,
+      .capacity = num_bodies};
+  return force->relevant_bodies.items;
+}
+
+force_t *force_init_with_body_array(force_creator_t forcer, void *aux,
+                                    body_t **bodies, size_t num_bodies,
+                                    free_func_t freer) {
+  force_t *f = force_init(forcer, aux, freer);
+  body_t **items = force_reserve_bodies(f, num_bodies);
+  for (size_t i = 0; i < num_bodies; i++) {
+    items[i] = bodies[i];
+  }
   return f;
 }
 
 force_t *force_init_with_bodies(force_creator_t forcer, void *aux,
                                 list_t *relevant_bodies, free_func_t freer) {
-  force_t *f = malloc(sizeof(force_t));
-  f->forcer = forcer;
-  f->aux = aux;
-  f->freer = freer;
-  f->relevant_bodies = relevant_bodies;
+  force_t *f = force_init(forcer, aux, freer);
+  if (relevant_bodies != NULL) {
+    body_t **items = force_reserve_bodies(f, list_size(relevant_bodies));
+    for (size_t i = 0; i < list_size(relevant_bodies); i++) {
+      items[i] = list_get(relevant_bodies, i);
+    }
+    list_free(relevant_bodies);
+  }
   return f;
 }
 
@@ -33,10 +69,11 @@ void force_free(force_t *force) {
   if (force->freer != NULL) {
     force->freer(force->aux);
   }
-  if (force->relevant_bodies != NULL) {
-    list_free(force->relevant_bodies);
+  if (force->has_bodies) {
+    pool_release_sized(force->relevant_bodies.items,
+                       force->relevant_bodies.capacity * sizeof(body_t *));
   }
-  free(force);
+  pool_release_sized(force, sizeof(force_t));
 }
 
 force_creator_t get_force_creator(force_t *force) { return force->forcer; }
@@ -45,4 +82,23 @@ void *get_aux(force_t *force) { return force->aux; }
 
 free_func_t get_freer(force_t *force) { return force->freer; }
 
-list_t *get_relevant_bodies(force_t *force) { return force->relevant_bodies; }
+body_array_t *get_relevant_bodies(force_t *force) {
+  return force->has_bodies ? &force->relevant_bodies : NULL;
+}
+
+
+void force_set_tag(force_t *force, size_t tag) { force->tag = tag; }
+
+size_t force_get_tag(force_t *force) { return force->tag; }
+
+void force_set_enabled(force_t *force, bool enabled) {
+  force->enabled = enabled;
+}
+
+bool force_is_enabled(force_t *force) { return force->enabled; }
+
+void force_set_cloner(force_t *force, aux_cloner_t cloner) {
+  force->cloner = cloner;
+}
+
+aux_cloner_t get_cloner(force_t *force) { return force->cloner; }
@@ -0,0 +1,261 @@
+#include "force_batch.h"
+#include "body.h"
+#include "forces.h"
+#include "islands.h"
+#include "list.h"
+#include "scene.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+const size_t NUM_FORCE_KINDS = FORCE_STATIC_PLAT + 1;
+const size_t INITIAL_BATCH_GUESS = 8;
+const size_t INITIAL_STATIC_NEARBY_GUESS = 4;
+
+typedef struct batch_entry {
+  double constant;
+  body_t *body1;
+  body_t *body2;
+} batch_entry_t;
+
+/**
+ * The forces of one kind.
+ */
+typedef struct batch_array {
+  batch_entry_t *entries;
+  size_t size;
+  size_t capacity;
+} batch_array_t;
+
+typedef struct force_batch {
+  // Indexed by force_kind_t
+  batch_array_t *kinds;
+} force_batch_t;
+
+force_batch_t *force_batch_init(void) {
+  force_batch_t *batch = malloc(sizeof(force_batch_t));
+  assert(batch != NULL);
+  batch->kinds = calloc(NUM_FORCE_KINDS, sizeof(batch_array_t));
+  assert(batch->kinds != NULL);
+  return batch;
+}
+
+void force_batch_free(force_batch_t *batch) {
+  for (size_t i = 0; i < NUM_FORCE_KINDS; i++) {
+    free(batch->kinds[i].entries);
+  }
+  free(batch->kinds);
+  free(batch);
+}
+
+force_batch_t *force_batch_clone(force_batch_t *batch, scene_t *clone) {
+  force_batch_t *copy = force_batch_init();
+  for (size_t i = 0; i < NUM_FORCE_KINDS; i++) {
+    batch_array_t *array = &batch->kinds[i];
+    for (size_t j = 0; j < array->size; j++) {
+      batch_entry_t entry = array->entries[j];
+      body_t *body1 = scene_find_clone(clone, entry.body1);
+      body_t *body2 =
+          entry.body2 == NULL ? NULL : scene_find_clone(clone, entry.body2);
+      if (body1 == NULL || (entry.body2 != NULL && body2 == NULL)) {
+        force_batch_free(copy);
+        return NULL;
+      }
+      force_batch_add(copy, i, entry.constant, body1, body2);
+    }
+  }
+  return copy;
+}
+
+void force_batch_add(force_batch_t *batch, force_kind_t kind, double constant,
+                     body_t *body1, body_t *body2) {
+  assert((size_t)kind < NUM_FORCE_KINDS);
+  assert(body1 != NULL);
+  batch_array_t *array = &batch->kinds[kind];
+  if (array->size == array->capacity) {
+    array->capacity =
+        array->capacity == 0 ? INITIAL_BATCH_GUESS : 2 * array->capacity;
+    array->entries =
+        realloc(array->entries, array->capacity * sizeof(batch_entry_t));
+    assert(array->entries != NULL);
+  }
+  array->entries[array->size++] =
+      (batch_entry_t){.constant = constant, .body1 = body1, .body2 = body2};
+}
+
+size_t force_batch_size(force_batch_t *batch, force_kind_t kind) {
+  assert((size_t)kind < NUM_FORCE_KINDS);
+  return batch->kinds[kind].size;
+}
+
+void force_batch_remove_with(force_batch_t *batch, body_t *body) {
+  for (size_t i = 0; i < NUM_FORCE_KINDS; i++) {
+    batch_array_t *array = &batch->kinds[i];
+    size_t kept = 0;
+    for (size_t j = 0; j < array->size; j++) {
+      batch_entry_t entry = array->entries[j];
+      if (entry.body1 != body && entry.body2 != body) {
+        array->entries[kept++] = entry;
+      }
+    }
+    array->size = kept;
+  }
+}
+
+/**
+ * Returns whether a body can be moved by a force this tick.
+ */
+bool batch_body_can_move(body_t *body) {
+  return body != NULL && !body_is_asleep(body) &&
+         body_get_mass(body) != INFINITY;
+}
+
+/**
+ * Returns whether a force can be skipped because none of its bodies can move.
+ */
+bool batch_entry_is_idle(batch_entry_t *entry) {
+  return !batch_body_can_move(entry->body1) &&
+         !batch_body_can_move(entry->body2);
+}
+
+size_t batch_apply_drags(batch_array_t *array, size_t *skipped) {
+  size_t run = 0;
+  for (size_t i = 0; i < array->size; i++) {
+    batch_entry_t *entry = &array->entries[i];
+    if (batch_entry_is_idle(entry)) {
+      (*skipped)++;
+      continue;
+    }
+    vector_t velocity = body_get_velocity(entry->body1);
+    body_add_force(entry->body1, vec_multiply(-entry->constant, velocity));
+    run++;
+  }
+  return run;
+}
+
+size_t batch_apply_springs(batch_array_t *array, size_t *skipped) {
+  size_t run = 0;
+  for (size_t i = 0; i < array->size; i++) {
+    batch_entry_t *entry = &array->entries[i];
+    if (batch_entry_is_idle(entry)) {
+      (*skipped)++;
+      continue;
+    }
+    vector_t stretch = vec_subtract(body_get_centroid(entry->body1),
+                                    body_get_centroid(entry->body2));
+    body_add_force(entry->body1, vec_multiply(-entry->constant, stretch));
+    run++;
+  }
+  return run;
+}
+
+size_t batch_apply_gravity(batch_array_t *array, size_t *skipped) {
+  size_t run = 0;
+  for (size_t i = 0; i < array->size; i++) {
+    batch_entry_t *entry = &array->entries[i];
+    if (batch_entry_is_idle(entry)) {
+      (*skipped)++;
+      continue;
+    }
+    run++;
+    vector_t between = vec_subtract(body_get_centroid(entry->body1),
+                                    body_get_centroid(entry->body2));
+    double dist = sqrt(vec_dot(between, between));
+    if (dist < GRAVITY_MIN_DIST) {
+      continue;
+    }
+    double strength = entry->constant * body_get_mass(entry->body1) *
+                      body_get_mass(entry->body2) / (dist * dist * dist);
+    vector_t gravity = vec_multiply(strength, between);
+    body_add_force(entry->body1, vec_negate(gravity));
+    body_add_force(entry->body2, gravity);
+  }
+  return run;
+}
+
+size_t batch_apply_falls(batch_array_t *array, size_t *skipped) {
+  size_t run = 0;
+  for (size_t i = 0; i < array->size; i++) {
+    batch_entry_t *entry = &array->entries[i];
+    if (batch_entry_is_idle(entry)) {
+      (*skipped)++;
+      continue;
+    }
+    double weight = entry->constant * body_get_mass(entry->body1);
+    body_add_force(entry->body1, (vector_t){0, -weight});
+    run++;
+  }
+  return run;
+}
+
+size_t batch_apply_plats(batch_array_t *array, scene_t *scene,
+                         size_t *skipped) {
+  size_t run = 0;
+  for (size_t i = 0; i < array->size; i++) {
+    batch_entry_t *entry = &array->entries[i];
+    if (batch_entry_is_idle(entry)) {
+      (*skipped)++;
+      continue;
+    }
+    add_plat_contact(scene, entry->body1, entry->body2);
+    run++;
+  }
+  return run;
+}
+
+size_t batch_apply_static_plats(batch_array_t *array, scene_t *scene,
+                                size_t *skipped) {
+  size_t run = 0;
+  // One list serves every body; it is emptied after each
+  list_t *nearby = list_init(INITIAL_STATIC_NEARBY_GUESS, NULL);
+  for (size_t i = 0; i < array->size; i++) {
+    batch_entry_t *entry = &array->entries[i];
+    if (batch_entry_is_idle(entry)) {
+      (*skipped)++;
+      continue;
+    }
+    scene_query_static_near(scene, entry->body1, nearby);
+    for (size_t j = 0; j < list_size(nearby); j++) {
+      add_plat_contact(scene, entry->body1, list_get(nearby, j));
+    }
+    while (list_size(nearby) > 0) {
+      list_remove(nearby, list_size(nearby) - 1);
+    }
+    run++;
+  }
+  list_free(nearby);
+  return run;
+}
+
+size_t force_batch_apply(force_batch_t *batch, force_kind_t kind,
+                         scene_t *scene, size_t *skipped) {
+  assert((size_t)kind < NUM_FORCE_KINDS);
+  batch_array_t *array = &batch->kinds[kind];
+  switch (kind) {
+  case FORCE_DRAG:
+    return batch_apply_drags(array, skipped);
+  case FORCE_SPRING:
+    return batch_apply_springs(array, skipped);
+  case FORCE_GRAVITY:
+    return batch_apply_gravity(array, skipped);
+  case FORCE_FALL:
+    return batch_apply_falls(array, skipped);
+  case FORCE_PLAT:
+    return batch_apply_plats(array, scene, skipped);
+  case FORCE_STATIC_PLAT:
+    return batch_apply_static_plats(array, scene, skipped);
+  }
+  return 0;
+}
+
+void force_batch_connect(force_batch_t *batch, islands_t *islands) {
+  for (size_t i = 0; i < NUM_FORCE_KINDS; i++) {
+    batch_array_t *array = &batch->kinds[i];
+    for (size_t j = 0; j < array->size; j++) {
+      batch_entry_t *entry = &array->entries[j];
+      if (entry->body2 != NULL) {
+        islands_connect(islands, entry->body1, entry->body2);
+      }
+    }
+  }
+}
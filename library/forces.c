@@ -3,12 +3,13 @@
 #include "collision.h"
 #include "info.h"
 #include "list.h"
+#include "pool.h"
 #include "scene.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 
-const size_t MIN_DIST = 5;
+const double GRAVITY_MIN_DIST = 5;
 const size_t HITS = 3;
 
 typedef struct two_body_param {
@@ -18,11 +19,13 @@ typedef struct two_body_param {
 } two_body_param_t;
 
 typedef struct two_bodies_param {
+  scene_t *scene;
   body_t *body1;
   body_t *body2;
   collision_handler_t handler;
   void *aux;
   free_func_t freer;
+  aux_cloner_t aux_cloner;
 } two_bodies_param_t;
 
 typedef struct one_body_param {
@@ -39,7 +42,6 @@ typedef struct door_param {
 typedef struct handle_param {
   size_t hits;
   double constant;
-  bool collided;
 } handle_param_t;
 
 typedef struct pulley_param {
@@ -47,6 +49,7 @@ typedef struct pulley_param {
   body_t *pulley1;
   body_t *pulley2;
   double constant;
+  scene_t *scene;
 } pulley_param_t;
 
 void crt_gravity(void *aux) {
@@ -63,7 +66,7 @@ void crt_gravity(void *aux) {
                   body_get_mass(((two_body_param_t *)aux)->body2) /
                   (dist * dist) * dist_vec.y / dist;
   vector_t gravity = {x_grav, y_grav};
-  if (dist >= MIN_DIST) {
+  if (dist >= GRAVITY_MIN_DIST) {
     body_add_force(((two_body_param_t *)aux)->body1, vec_negate(gravity));
     body_add_force(((two_body_param_t *)aux)->body2, gravity);
   }
@@ -89,130 +92,43 @@ void crt_drag(void *aux) {
 }
 
 void crt_collision(void *aux) {
-  list_t *l1 = body_get_shape(((two_bodies_param_t *)aux)->body1);
-  list_t *l2 = body_get_shape(((two_bodies_param_t *)aux)->body2);
-
-  collision_info_t collide = find_collision(l1, l2);
-  bool collision = collide.collided;
-  vector_t axis = collide.axis;
-
-  list_free(l1);
-  list_free(l2);
-
-  if (!collision &&
-      ((handle_param_t *)((two_bodies_param_t *)aux)->aux)->collided) {
-    ((handle_param_t *)((two_bodies_param_t *)aux)->aux)->collided = false;
-  }
-  if (collision &&
-      !((handle_param_t *)((two_bodies_param_t *)aux)->aux)->collided) {
-    ((two_bodies_param_t *)aux)
-        ->handler(((two_bodies_param_t *)aux)->body1,
-                  ((two_bodies_param_t *)aux)->body2, axis,
-                  ((two_bodies_param_t *)aux)->aux);
-    ((handle_param_t *)((two_bodies_param_t *)aux)->aux)->collided = true;
+  two_bodies_param_t *param = aux;
+  contact_result_t contact =
+      scene_collide(param->scene, param->body1, param->body2);
+  // The handler runs once per contact, not every tick the bodies overlap
+  if (contact.event == CONTACT_ENTER) {
+    param->handler(param->body1, param->body2, contact.collision.axis,
+                   param->aux);
   }
 }
 
-void crt_plat(void *aux) {
-  list_t *l1 = body_get_shape(((two_body_param_t *)aux)->body1);
-  list_t *l2 = body_get_shape(((two_body_param_t *)aux)->body2);
-
-  collision_info_t collide = find_collision(l1, l2);
-  bool collision = collide.collided;
-  
-  vector_t axis = collide.axis;
-
-  list_free(l1);
-  list_free(l2);
-  
-  if (collision) {
-    if (axis.x == 0.0 && axis.y == -1.0) {
-      vector_t player_centroid = body_get_centroid(((two_body_param_t *)aux)->body1);
-      vector_t platform_centroid = body_get_centroid(((two_body_param_t *)aux)->body2);
-
-      if ((platform_centroid.y + body_get_height(((two_body_param_t *)aux)->body2)/2) > (player_centroid.y - body_get_height(((two_body_param_t *)aux)->body1)/2) + 1) {
-        double y_offset = (platform_centroid.y + body_get_height(((two_body_param_t *)aux)->body2)/2) - (player_centroid.y - body_get_height(((two_body_param_t *)aux)->body1)/2);
-        body_set_centroid(((two_body_param_t *)aux)->body1, (vector_t) {player_centroid.x, player_centroid.y + y_offset + 1});
-      }
-      if (body_get_mass(((two_body_param_t *)aux)->body2) == INFINITY || body_get_velocity(((two_body_param_t *)aux)->body2).y == 0.0){
-        vector_t body1_a = body_get_acceleration(((two_body_param_t *)aux)->body1);
-        body_set_acceleration(((two_body_param_t *)aux)->body1, (vector_t){.x = body1_a.x, 0.0});
-        body_set_yvelocity(((two_body_param_t *)aux)->body1, 0.0);
-      }
-      else {
-        double mass = body_get_mass(((two_body_param_t *)aux)->body1) + body_get_mass(((two_body_param_t *)aux)->body2); 
-        double accel = mass * ((two_body_param_t *)aux)->constant;
-        vector_t a1 = (vector_t) {.x = body_get_acceleration(((two_body_param_t *)aux)->body1).x, accel};
-        vector_t a2 = (vector_t) {.x = body_get_acceleration(((two_body_param_t *)aux)->body2).x, accel};
-        body_set_acceleration(((two_body_param_t *)aux)->body1, a1);
-        body_set_acceleration(((two_body_param_t *)aux)->body2, a2);
-      }
-    }
-    if ((axis.x == -1.0 && axis.y == 0.0) || (axis.x == 1.0 && axis.y == 0.0)) {
-      vector_t player_centroid = body_get_centroid(((two_body_param_t *)aux)->body1);
-      vector_t platform_centroid = body_get_centroid(((two_body_param_t *)aux)->body2);
-      if (axis.x < 0.0) {
-        double x_offset = (platform_centroid.x + body_get_width(((two_body_param_t *)aux)->body2)/2) - (player_centroid.x - body_get_width(((two_body_param_t *)aux)->body1)/2);
-        body_set_centroid(((two_body_param_t *)aux)->body1, (vector_t) {player_centroid.x + x_offset + 1, player_centroid.y});
-      }
-      if (axis.x > 0.0) {
-        double x_offset = (player_centroid.x + body_get_width(((two_body_param_t *)aux)->body1)/2) - (platform_centroid.x - body_get_width(((two_body_param_t *)aux)->body2)/2);
-        body_set_centroid(((two_body_param_t *)aux)->body1, (vector_t) {player_centroid.x - x_offset - 1, player_centroid.y}); 
-      }
-      if (body_get_mass(((two_body_param_t *)aux)->body2) == INFINITY) {
-        if ((body_get_velocity(((two_body_param_t *)aux)->body1).x < 0 && axis.x < 0) || 
-            (body_get_velocity(((two_body_param_t *)aux)->body1).x > 0 && axis.x > 0))
-        body_set_xvelocity(((two_body_param_t *)aux)->body1, 0);
-      }
-      else {
-        double vel1 = body_get_velocity(((two_body_param_t *)aux)->body1).x;
-        body_set_xvelocity(((two_body_param_t *)aux)->body1, vel1/2);
-        body_set_xvelocity(((two_body_param_t *)aux)->body2, vel1/2);
-      }
-    }
-    if (axis.x == 0.0 && axis.y == 1.0) {
-      double mass1 = body_get_mass(((two_body_param_t *)aux)->body1);
-      double mass2 = body_get_mass(((two_body_param_t *)aux)->body2);
-      double masses = mass1 * mass2 / (mass1 + mass2);
-      if (mass2 == INFINITY) {
-        masses = mass1;
-      }
-      double constant = masses * (1.0 + 1.0);
-      double components = vec_dot(body_get_velocity(((two_body_param_t *)aux)->body2), axis) -
-                          vec_dot(body_get_velocity(((two_body_param_t *)aux)->body1), axis);
-      body_add_impulse(((two_body_param_t *)aux)->body1, vec_multiply(constant * components, axis));
-      if (mass2 != INFINITY) {
-        body_add_impulse(((two_body_param_t *)aux)->body2, vec_multiply(-1 * constant * components, axis));
-      }
-      vector_t player_centroid = body_get_centroid(((two_body_param_t *)aux)->body1);
-      vector_t platform_centroid = body_get_centroid(((two_body_param_t *)aux)->body2);
-      if ((platform_centroid.y - body_get_height(((two_body_param_t *)aux)->body2)/2) < (player_centroid.y + body_get_height(((two_body_param_t *)aux)->body1)/2) + 1) {
-        double y_offset = (platform_centroid.y - body_get_height(((two_body_param_t *)aux)->body2)/2) - (player_centroid.y + body_get_height(((two_body_param_t *)aux)->body1)/2);
-        body_set_centroid(((two_body_param_t *)aux)->body1, (vector_t) {player_centroid.x, player_centroid.y + y_offset - 1});
-      }
-    }
+/**
+ * Adds the contact between two bodies, if they overlap, to the scene's
+ * contact solver, with the normal pointing from body1 towards body2.
+ */
+void add_plat_contact(scene_t *scene, body_t *body1, body_t *body2) {
+  collision_info_t collide = scene_collide(scene, body1, body2).collision;
+  if (!collide.collided) {
+    return;
+  }
+  vector_t normal = collide.axis;
+  vector_t between =
+      vec_subtract(body_get_centroid(body2), body_get_centroid(body1));
+  if (vec_dot(normal, between) < 0) {
+    normal = vec_negate(normal);
   }
+  scene_add_contact(scene, body1, body2, normal, collide.depth);
 }
 
 void crt_door(void *aux) {
-  list_t *l1 = body_get_shape(((door_param_t *)aux)->player1);
-  list_t *l2 = body_get_shape(((door_param_t *)aux)->check_door1);
-
-  collision_info_t collide1 = find_collision(l1, l2);
+  collision_info_t collide1 = find_body_collision(
+      ((door_param_t *)aux)->player1, ((door_param_t *)aux)->check_door1);
   bool collision1 = collide1.collided;
 
-  list_free(l1);
-  list_free(l2);
-
-  list_t *l3 = body_get_shape(((door_param_t *)aux)->player2);
-  list_t *l4 = body_get_shape(((door_param_t *)aux)->check_door2);
-
-  collision_info_t collide2 = find_collision(l3, l4);
+  collision_info_t collide2 = find_body_collision(
+      ((door_param_t *)aux)->player2, ((door_param_t *)aux)->check_door2);
   bool collision2 = collide2.collided;
 
-  list_free(l3);
-  list_free(l4);
-
   if (collision1 && collision2) {
     body_win(((door_param_t *)aux)->player1);
     body_win(((door_param_t *)aux)->player2);
@@ -220,118 +136,109 @@ void crt_door(void *aux) {
 }
 
 void crt_pulley(void *aux) {
-  list_t *l1 = body_get_shape(((pulley_param_t *)aux)->body);
-  list_t *l2 = body_get_shape(((pulley_param_t *)aux)->pulley1);
-  list_t *l3 = body_get_shape(((pulley_param_t *)aux)->pulley2);
-
-  collision_info_t collide1 = find_collision(l1, l2);
-  collision_info_t collide2 = find_collision(l1, l3);
-
-  list_free(l1);
-  list_free(l2);
-  list_free(l3);
+  pulley_param_t *param = aux;
+  body_t *body = param->body;
+  collision_info_t collide1 =
+      scene_collide(param->scene, body, param->pulley1).collision;
+  collision_info_t collide2 =
+      scene_collide(param->scene, body, param->pulley2).collision;
 
   body_t *coll;
   body_t *no_coll;
   vector_t axis;
-  if (collide1.collided) {
-    coll = ((pulley_param_t *)aux)->pulley1;
-    no_coll = ((pulley_param_t *)aux)->pulley2;
-    axis = collide1.axis;
-  }
   if (collide2.collided) {
-    coll = ((pulley_param_t *)aux)->pulley2;
-    no_coll = ((pulley_param_t *)aux)->pulley1;
+    coll = param->pulley2;
+    no_coll = param->pulley1;
     axis = collide2.axis;
   }
-  if (collide1.collided || collide2.collided) {
-    if (axis.x == 0.0 && axis.y == -1.0) {
-      vector_t player_centroid = body_get_centroid(((pulley_param_t *)aux)->body);
-      vector_t platform_centroid = body_get_centroid(coll);
-
-      if ((platform_centroid.y + body_get_height(coll)/2) > (player_centroid.y - body_get_height(((pulley_param_t *)aux)->body)/2) + 1) {
-        double y_offset = (platform_centroid.y + body_get_height(coll)/2) - (player_centroid.y - body_get_height(((pulley_param_t *)aux)->body)/2);
-        body_set_centroid(((pulley_param_t *)aux)->body, (vector_t) {player_centroid.x, player_centroid.y + y_offset + 1});
-      }
+  else if (collide1.collided) {
+    coll = param->pulley1;
+    no_coll = param->pulley2;
+    axis = collide1.axis;
+  }
+  else {
+    return;
+  }
 
-      double mass = body_get_mass(((pulley_param_t *)aux)->body);
-      if (mass == INFINITY) {
-        body_set_yvelocity(((pulley_param_t *)aux)->body, 0.0);
-        body_set_yvelocity(coll, 0.0);
-        body_set_yvelocity(no_coll, 0.0);
-        body_set_ground(coll, true);
-      }
-      else {
-        body_set_pull_mass(coll, body_get_pull_mass(coll) + mass);
-        if (!body_get_ground(coll) && body_get_pull_mass(coll) > body_get_pull_mass(no_coll)) { 
-          vector_t body1_a = body_get_acceleration(((pulley_param_t *)aux)->body);
-          vector_t body2_a = body_get_acceleration(coll);
-          vector_t a = (vector_t) {.x = body2_a.x, body1_a.y};
-          body_set_acceleration(coll, a);
-          body_set_acceleration(no_coll, vec_negate(a));
-        } 
-        else if (body_get_pull_mass(coll) > body_get_pull_mass(no_coll)) {
-          body_set_yvelocity(((pulley_param_t *)aux)->body, 0.0);
-          body_set_acceleration(((pulley_param_t *)aux)->body, VEC_ZERO);
-          body_set_acceleration(coll, VEC_ZERO);
-          body_set_acceleration(no_coll, VEC_ZERO);
-        }
-        else {
-          body_set_yvelocity(((pulley_param_t *)aux)->body, 0.0);
-          body_set_acceleration(((pulley_param_t *)aux)->body, body_get_acceleration(coll));
-        }
-      }
-    }
-    if ((axis.x == -1.0 && axis.y == 0.0) || (axis.x == 1.0 && axis.y == 0.0)) {
-      vector_t player_centroid = body_get_centroid(((pulley_param_t *)aux)->body);
-      vector_t platform_centroid = body_get_centroid(coll);
-      if (axis.x < 0.0) {
-        double x_offset = (platform_centroid.x + body_get_width(coll)/2) - (player_centroid.x - body_get_width(((pulley_param_t *)aux)->body)/2);
-        body_set_centroid(((pulley_param_t *)aux)->body, (vector_t) {player_centroid.x + x_offset + 1, player_centroid.y});
-      }
-      if (axis.x > 0.0) {
-        double x_offset = (player_centroid.x + body_get_width(((pulley_param_t *)aux)->body)/2) - (platform_centroid.x - body_get_width(coll)/2);
-        body_set_centroid(((pulley_param_t *)aux)->body, (vector_t) {player_centroid.x - x_offset - 1, player_centroid.y}); 
-      }
-      body_set_xvelocity(((pulley_param_t *)aux)->body, 0);
+  // The side is taken from the axis' larger component, since the axis of a
+  // corner contact is rarely exactly vertical or horizontal. The body is
+  // moved out of the platform here rather than by the contact solver: the
+  // solver would push the platform with an impulse its partner on the other
+  // end of the pulley never sees, and the two would drift apart.
+  vector_t body_centroid = body_get_centroid(body);
+  vector_t platform_centroid = body_get_centroid(coll);
+  double mass = body_get_mass(body);
+  if (axis.y < -fabs(axis.x)) {
+    double y_offset = (platform_centroid.y + body_get_height(coll)/2) - (body_centroid.y - body_get_height(body)/2);
+    if (y_offset > 1) {
+      body_set_centroid(body, (vector_t) {body_centroid.x, body_centroid.y + y_offset + 1});
     }
-    if (axis.x == 0.0 && axis.y == 1.0) {
 
-      vector_t player_centroid = body_get_centroid(((pulley_param_t *)aux)->body);
-      vector_t platform_centroid = body_get_centroid(coll);
-
-      double mass1 = body_get_mass(((pulley_param_t *)aux)->body);
-
-      if (mass1 != INFINITY && (platform_centroid.y - body_get_height(coll)/2) > (player_centroid.y + body_get_height(((pulley_param_t *)aux)->body)/2) - 1) {
-        double y_offset = (platform_centroid.y - body_get_height(coll)/2) - (player_centroid.y + body_get_height(((pulley_param_t *)aux)->body)/2);
-        body_set_centroid(((pulley_param_t *)aux)->body, (vector_t) {player_centroid.x, player_centroid.y + y_offset - 1});
-      }
-      body_set_yvelocity(((pulley_param_t *)aux)->body, 0.0);
+    if (mass == INFINITY) {
+      body_set_yvelocity(body, 0.0);
       body_set_yvelocity(coll, 0.0);
       body_set_yvelocity(no_coll, 0.0);
-      body_set_acceleration(((pulley_param_t *)aux)->body, VEC_ZERO);
-      body_set_acceleration(coll, VEC_ZERO);
-      body_set_acceleration(no_coll, VEC_ZERO);
       body_set_ground(coll, true);
     }
+    else {
+      body_set_pull_mass(coll, body_get_pull_mass(coll) + mass);
+      if (!body_get_ground(coll) && body_get_pull_mass(coll) > body_get_pull_mass(no_coll)) {
+        vector_t body1_a = body_get_acceleration(body);
+        vector_t body2_a = body_get_acceleration(coll);
+        vector_t a = (vector_t) {.x = body2_a.x, body1_a.y};
+        body_set_acceleration(coll, a);
+        body_set_acceleration(no_coll, vec_negate(a));
+      }
+      else if (body_get_pull_mass(coll) > body_get_pull_mass(no_coll)) {
+        body_set_yvelocity(body, 0.0);
+        body_set_acceleration(body, VEC_ZERO);
+        body_set_acceleration(coll, VEC_ZERO);
+        body_set_acceleration(no_coll, VEC_ZERO);
+      }
+      else {
+        body_set_yvelocity(body, 0.0);
+        body_set_acceleration(body, body_get_acceleration(coll));
+      }
+    }
+  }
+  else if (axis.x < 0.0) {
+    double x_offset = (platform_centroid.x + body_get_width(coll)/2) - (body_centroid.x - body_get_width(body)/2);
+    body_set_centroid(body, (vector_t) {body_centroid.x + x_offset + 1, body_centroid.y});
+    body_set_xvelocity(body, 0);
+  }
+  else if (axis.x > 0.0) {
+    double x_offset = (body_centroid.x + body_get_width(body)/2) - (platform_centroid.x - body_get_width(coll)/2);
+    body_set_centroid(body, (vector_t) {body_centroid.x - x_offset - 1, body_centroid.y});
+    body_set_xvelocity(body, 0);
+  }
+  else {
+    double y_offset = (platform_centroid.y - body_get_height(coll)/2) - (body_centroid.y + body_get_height(body)/2);
+    if (mass != INFINITY && y_offset > -1) {
+      body_set_centroid(body, (vector_t) {body_centroid.x, body_centroid.y + y_offset - 1});
+    }
+    body_set_yvelocity(body, 0.0);
+    body_set_yvelocity(coll, 0.0);
+    body_set_yvelocity(no_coll, 0.0);
+    body_set_acceleration(body, VEC_ZERO);
+    body_set_acceleration(coll, VEC_ZERO);
+    body_set_acceleration(no_coll, VEC_ZERO);
+    body_set_ground(coll, true);
   }
 }
 
 void create_door_collision(scene_t *scene, body_t *door_red, body_t *player1,
                                            body_t *door_blue, body_t *player2)
 {
-  door_param_t *door = malloc(sizeof(door_param_t));
+  door_param_t *door = pool_alloc_sized(sizeof(door_param_t));
   door->check_door1 = door_red;
   door->player1 = player1;
   door->check_door2 = door_blue;
   door->player2 = player2;
-  list_t *bodies = list_init(6, NULL);
-  list_add(bodies, door_red);
-  list_add(bodies, player1);
-  list_add(bodies, door_blue);
-  list_add(bodies, player2);
-  scene_add_bodies_force_creator(scene, (force_creator_t)crt_door, door, bodies,
-                                 (free_func_t)door_free);
+  body_t *bodies[] = {door_red, player1, door_blue, player2};
+  scene_add_phased_force_creator_n(scene, FORCE_PHASE_REACT, 0,
+                                   (force_creator_t)crt_door, door, bodies, 4,
+                                   (free_func_t)door_free,
+                                   (aux_cloner_t)door_clone);
 }
 
 void crt_fall(void *aux) {
@@ -341,15 +248,10 @@ void crt_fall(void *aux) {
 }
 
 void crt_fan(void *aux) {
-  list_t *l1 = body_get_shape(((two_body_param_t *)aux)->body1);
-  list_t *l2 = body_get_shape(((two_body_param_t *)aux)->body2);
-
-  collision_info_t collide = find_collision(l1, l2);
+  collision_info_t collide = find_body_collision(
+      ((two_body_param_t *)aux)->body1, ((two_body_param_t *)aux)->body2);
   bool collision = collide.collided;
 
-  list_free(l1);
-  list_free(l2);
-
   if (collision)
   {
     double net = ((two_body_param_t *)aux)->constant * body_get_mass(((two_body_param_t *)aux)->body1);
@@ -358,130 +260,107 @@ void crt_fan(void *aux) {
 }
 
 void crt_button(void *aux) {
-  list_t *l1 = body_get_shape(((two_body_param_t *)aux)->body1);
-  list_t *l2 = body_get_shape(((two_body_param_t *)aux)->body2);
-
-  collision_info_t collide = find_collision(l1, l2);
+  collision_info_t collide = find_body_collision(
+      ((two_body_param_t *)aux)->body1, ((two_body_param_t *)aux)->body2);
   bool collision = collide.collided;
 
-  list_free(l1);
-  list_free(l2);
-
   body_fan(((two_body_param_t *)aux)->body1, collision);
 }
 
 void create_newtonian_gravity(scene_t *scene, double G, body_t *body1,
                               body_t *body2) {
-  two_body_param_t *grav = malloc(sizeof(two_body_param_t));
-  grav->constant = G;
-  grav->body1 = body1;
-  grav->body2 = body2;
-  list_t *bodies = list_init(2, NULL);
-  list_add(bodies, body1);
-  list_add(bodies, body2);
-  scene_add_bodies_force_creator(scene, (force_creator_t)crt_gravity, grav,
-                                 bodies, (free_func_t)two_free);
+  scene_add_batched_force(scene, FORCE_GRAVITY, G, body1, body2);
 }
 
 void create_spring(scene_t *scene, double k, body_t *body1, body_t *body2) {
-  two_body_param_t *spring = malloc(sizeof(two_body_param_t));
-  spring->constant = k;
-  spring->body1 = body1;
-  spring->body2 = body2;
-  list_t *bodies = list_init(2, NULL);
-  list_add(bodies, body1);
-  list_add(bodies, body2);
-  scene_add_bodies_force_creator(scene, (force_creator_t)crt_spring, spring,
-                                 bodies, (free_func_t)two_free);
+  scene_add_batched_force(scene, FORCE_SPRING, k, body1, body2);
+  if (body_get_mass(body1) != INFINITY) {
+    scene_add_stiffness(scene, k / body_get_mass(body1));
+  }
 }
 
 void create_drag(scene_t *scene, double gamma, body_t *body) {
-  one_body_param_t *drag = malloc(sizeof(one_body_param_t));
-  drag->constant = gamma;
-  drag->body = body;
-  list_t *bodies = list_init(1, NULL);
-  list_add(bodies, body);
-  scene_add_bodies_force_creator(scene, (force_creator_t)crt_drag, drag, bodies,
-                                 (free_func_t)one_free);
+  scene_add_batched_force(scene, FORCE_DRAG, gamma, body, NULL);
 }
 
-void create_collision(scene_t *scene, body_t *body1, body_t *body2,
-                      collision_handler_t handler, void *aux,
-                      free_func_t freer) {
-  two_bodies_param_t *collision = malloc(sizeof(two_bodies_param_t));
+/**
+ * Adds a collision force creator, like create_collision(), in a given phase,
+ * whose handler's auxiliary value can be copied with aux_cloner if the scene
+ * is cloned.
+ */
+void add_collision(scene_t *scene, force_phase_t phase, body_t *body1,
+                   body_t *body2, collision_handler_t handler, void *aux,
+                   free_func_t freer, aux_cloner_t aux_cloner) {
+  two_bodies_param_t *collision = pool_alloc_sized(sizeof(two_bodies_param_t));
+  ((two_bodies_param_t *)collision)->scene = scene;
   ((two_bodies_param_t *)collision)->body1 = body1;
   ((two_bodies_param_t *)collision)->body2 = body2;
   ((two_bodies_param_t *)collision)->handler = handler;
   ((two_bodies_param_t *)collision)->aux = aux;
   ((two_bodies_param_t *)collision)->freer = freer;
-  list_t *bodies = list_init(2, NULL);
-  list_add(bodies, body1);
-  list_add(bodies, body2);
-  scene_add_bodies_force_creator(scene, (force_creator_t)crt_collision,
-                                 collision, bodies,
-                                 (free_func_t)twos_free);
+  ((two_bodies_param_t *)collision)->aux_cloner = aux_cloner;
+  body_t *bodies[] = {body1, body2};
+  scene_add_phased_force_creator_n(scene, phase, 0,
+                                   (force_creator_t)crt_collision, collision,
+                                   bodies, 2, (free_func_t)twos_free,
+                                   (aux_cloner_t)twos_clone);
 }
 
-void create_plat_collision(scene_t *scene, double k, body_t *body1,
-                                  body_t *body2) {
-  two_body_param_t *collision = malloc(sizeof(two_bodies_param_t));
-  collision->constant = k;
-  collision->body1 = body1;
-  collision->body2 = body2;
-  list_t *bodies = list_init(2, NULL);
-  list_add(bodies, body1);
-  list_add(bodies, body2);
-  scene_add_bodies_force_creator(scene, (force_creator_t)crt_plat,
-                                 collision, bodies,
-                                 (free_func_t)two_free);
+void create_collision(scene_t *scene, body_t *body1, body_t *body2,
+                      collision_handler_t handler, void *aux,
+                      free_func_t freer) {
+  add_collision(scene, FORCE_PHASE_REACT, body1, body2, handler, aux, freer,
+                NULL);
 }
 
+void create_plat_collision(scene_t *scene, body_t *body1, body_t *body2) {
+  scene_add_batched_force(scene, FORCE_PLAT, 0, body1, body2);
+}
+
+void create_static_plat_collision(scene_t *scene, body_t *body) {
+  scene_add_batched_force(scene, FORCE_STATIC_PLAT, 0, body, NULL);
+}
 
 void create_fall(scene_t *scene, double G, body_t *body) {
-  one_body_param_t *net = malloc(sizeof(one_body_param_t));
-  net->constant = G;
-  net->body = body;
-  list_t *bodies = list_init(1, NULL);
-  list_add(bodies, body);
-  scene_add_bodies_force_creator(scene, (force_creator_t)crt_fall, net, bodies,
-                                 (free_func_t)one_free);
+  scene_add_batched_force(scene, FORCE_FALL, G, body, NULL);
 }
 
-void create_fan(scene_t *scene, double k, body_t *body1, body_t *body2) {
-  two_body_param_t *fan = malloc(sizeof(two_body_param_t));
+void create_fan(scene_t *scene, double k, body_t *body1, body_t *body2,
+                size_t tag) {
+  two_body_param_t *fan = pool_alloc_sized(sizeof(two_body_param_t));
   fan->constant = k;
   fan->body1 = body1;
   fan->body2 = body2;
-  list_t *bodies = list_init(2, NULL);
-  list_add(bodies, body1);
-  list_add(bodies, body2);
-  scene_add_bodies_force_creator(scene, (force_creator_t)crt_fan, fan, bodies,
-                                 (free_func_t)two_free);
+  body_t *bodies[] = {body1, body2};
+  scene_add_phased_force_creator_n(scene, FORCE_PHASE_IMPULSE, tag,
+                                   (force_creator_t)crt_fan, fan, bodies, 2,
+                                   (free_func_t)two_free,
+                                   (aux_cloner_t)two_clone);
 }
 
 void create_button(scene_t *scene, body_t *body1, body_t *body2) {
-  two_body_param_t *button = malloc(sizeof(two_body_param_t));
+  two_body_param_t *button = pool_alloc_sized(sizeof(two_body_param_t));
   button->body1 = body1;
   button->body2 = body2;
-  list_t *bodies = list_init(2, NULL);
-  list_add(bodies, body1);
-  list_add(bodies, body2);
-  scene_add_bodies_force_creator(scene, (force_creator_t)crt_button, button, bodies,
-                                 (free_func_t)two_free);
+  body_t *bodies[] = {body1, body2};
+  scene_add_phased_force_creator_n(scene, FORCE_PHASE_REACT, 0,
+                                   (force_creator_t)crt_button, button, bodies,
+                                   2, (free_func_t)two_free,
+                                   (aux_cloner_t)two_clone);
 }
 
 void create_pulley_collision(scene_t *scene, body_t *body, double constant, body_t *pulley1, body_t *pulley2){
-  pulley_param_t *pulley = malloc(sizeof(pulley_param_t));
+  pulley_param_t *pulley = pool_alloc_sized(sizeof(pulley_param_t));
   pulley->body = body;
   pulley->pulley1 = pulley1;
   pulley->pulley2 = pulley2;
   pulley->constant = constant;
-  list_t *bodies = list_init(3, NULL);
-  list_add(bodies, body);
-  list_add(bodies, pulley1);
-  list_add(bodies, pulley2);
-  scene_add_bodies_force_creator(scene, (force_creator_t)crt_pulley, pulley, bodies,
-                                 (free_func_t)pulley_free);
+  pulley->scene = scene;
+  body_t *bodies[] = {body, pulley1, pulley2};
+  scene_add_phased_force_creator_n(scene, FORCE_PHASE_REACT, 0,
+                                   (force_creator_t)crt_pulley, pulley, bodies,
+                                   3, (free_func_t)pulley_free,
+                                   (aux_cloner_t)pulley_clone);
 }
 
 void destructive_handler(body_t *body1, body_t *body2, vector_t axis,
@@ -492,10 +371,10 @@ void destructive_handler(body_t *body1, body_t *body2, vector_t axis,
 
 void create_destructive_collision(scene_t *scene, body_t *body1,
                                   body_t *body2) {
-  handle_param_t *collision = malloc(sizeof(handle_param_t));
-  create_collision(scene, body1, body2,
-                   (collision_handler_t)destructive_handler, collision,
-                   (free_func_t)handle_free);
+  handle_param_t *collision = pool_alloc_sized(sizeof(handle_param_t));
+  add_collision(scene, FORCE_PHASE_REACT, body1, body2,
+                (collision_handler_t)destructive_handler, collision,
+                (free_func_t)handle_free, (aux_cloner_t)handle_clone);
 }
 
 void physics_handler(body_t *body1, body_t *body2, vector_t axis, void *aux) {
@@ -526,12 +405,22 @@ void physics_handler(body_t *body1, body_t *body2, vector_t axis, void *aux) {
 
 void create_physics_collision(scene_t *scene, double constant, body_t *body1,
                               body_t *body2) {
-  handle_param_t *collision = malloc(sizeof(handle_param_t));
+  handle_param_t *collision = pool_alloc_sized(sizeof(handle_param_t));
   collision->hits = 0;
   collision->constant = constant;
-  collision->collided = false;
-  create_collision(scene, body1, body2, (collision_handler_t)physics_handler,
-                   collision, (free_func_t)handle_free);
+  // The bounce is an impulse, so it is only looked for once per tick
+  add_collision(scene, FORCE_PHASE_IMPULSE, body1, body2,
+                (collision_handler_t)physics_handler, collision,
+                (free_func_t)handle_free, (aux_cloner_t)handle_clone);
+}
+
+void create_physics_collisions_batch(scene_t *scene, double elasticity,
+                                     body_t *body, body_t **others,
+                                     size_t num_others) {
+  scene_reserve_forces(scene, FORCE_PHASE_IMPULSE, num_others);
+  for (size_t i = 0; i < num_others; i++) {
+    create_physics_collision(scene, elasticity, body, others[i]);
+  }
 }
 
 void disappear_handler(body_t *body1, body_t *body2, vector_t axis,
@@ -541,10 +430,10 @@ void disappear_handler(body_t *body1, body_t *body2, vector_t axis,
 
 void create_disappear_collision(scene_t *scene, body_t *body1,
                                   body_t *body2) {
-  handle_param_t *collision = malloc(sizeof(handle_param_t));
-  create_collision(scene, body1, body2,
-                   (collision_handler_t)disappear_handler, collision,
-                   (free_func_t)handle_free);
+  handle_param_t *collision = pool_alloc_sized(sizeof(handle_param_t));
+  add_collision(scene, FORCE_PHASE_REACT, body1, body2,
+                (collision_handler_t)disappear_handler, collision,
+                (free_func_t)handle_free, (aux_cloner_t)handle_clone);
 }
 
 void exit_handler(body_t *body1, body_t *body2, vector_t axis,
@@ -557,20 +446,97 @@ void create_exit_collision(scene_t *scene, body_t *body1,
   create_collision(scene, body1, body2, exit_handler, NULL, NULL);
 }
 
-void two_free(two_body_param_t *t) { free(t); }
+void two_free(two_body_param_t *t) {
+  pool_release_sized(t, sizeof(two_body_param_t));
+}
 
-void one_free(one_body_param_t *o) { free(o); }
+void one_free(one_body_param_t *o) {
+  pool_release_sized(o, sizeof(one_body_param_t));
+}
 
 void twos_free(two_bodies_param_t *ts) {
   if (ts->freer != NULL) {
     ts->freer(ts->aux);
   }
-  free(ts);
+  pool_release_sized(ts, sizeof(two_bodies_param_t));
+}
+
+void handle_free(handle_param_t *h) {
+  pool_release_sized(h, sizeof(handle_param_t));
 }
 
-void handle_free(handle_param_t *h) { free(h); }
+void door_free(door_param_t *d) {
+  pool_release_sized(d, sizeof(door_param_t));
+}
+
+void pulley_free(pulley_param_t *p) {
+  pool_release_sized(p, sizeof(pulley_param_t));
+}
 
-void door_free(door_param_t *d) { free(d); }
 
-void pulley_free(pulley_param_t *p) { free(p); }
+void *two_clone(two_body_param_t *t, scene_t *clone) {
+  two_body_param_t *copy = pool_alloc_sized(sizeof(two_body_param_t));
+  *copy = *t;
+  copy->body1 = scene_find_clone(clone, t->body1);
+  copy->body2 = scene_find_clone(clone, t->body2);
+  if (copy->body1 == NULL || copy->body2 == NULL) {
+    two_free(copy);
+    return NULL;
+  }
+  return copy;
+}
 
+void *twos_clone(two_bodies_param_t *ts, scene_t *clone) {
+  void *aux = ts->aux;
+  if (aux != NULL) {
+    aux = ts->aux_cloner == NULL ? NULL : ts->aux_cloner(ts->aux, clone);
+    if (aux == NULL) {
+      return NULL;
+    }
+  }
+  two_bodies_param_t *copy = pool_alloc_sized(sizeof(two_bodies_param_t));
+  *copy = *ts;
+  copy->scene = clone;
+  copy->aux = aux;
+  copy->body1 = scene_find_clone(clone, ts->body1);
+  copy->body2 = scene_find_clone(clone, ts->body2);
+  if (copy->body1 == NULL || copy->body2 == NULL) {
+    twos_free(copy);
+    return NULL;
+  }
+  return copy;
+}
+
+void *handle_clone(handle_param_t *h, scene_t *clone) {
+  handle_param_t *copy = pool_alloc_sized(sizeof(handle_param_t));
+  *copy = *h;
+  return copy;
+}
+
+void *door_clone(door_param_t *d, scene_t *clone) {
+  door_param_t *copy = pool_alloc_sized(sizeof(door_param_t));
+  copy->check_door1 = scene_find_clone(clone, d->check_door1);
+  copy->player1 = scene_find_clone(clone, d->player1);
+  copy->check_door2 = scene_find_clone(clone, d->check_door2);
+  copy->player2 = scene_find_clone(clone, d->player2);
+  if (copy->check_door1 == NULL || copy->player1 == NULL ||
+      copy->check_door2 == NULL || copy->player2 == NULL) {
+    door_free(copy);
+    return NULL;
+  }
+  return copy;
+}
+
+void *pulley_clone(pulley_param_t *p, scene_t *clone) {
+  pulley_param_t *copy = pool_alloc_sized(sizeof(pulley_param_t));
+  *copy = *p;
+  copy->body = scene_find_clone(clone, p->body);
+  copy->pulley1 = scene_find_clone(clone, p->pulley1);
+  copy->pulley2 = scene_find_clone(clone, p->pulley2);
+  copy->scene = clone;
+  if (copy->body == NULL || copy->pulley1 == NULL || copy->pulley2 == NULL) {
+    pulley_free(copy);
+    return NULL;
+  }
+  return copy;
+}
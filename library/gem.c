@@ -65,67 +65,79 @@ const vector_t GEM_LVLFOUR8_CENT = (vector_t) {200, 550};
 
 const rgb_color_t BLK = (rgb_color_t){.r = 0.0, .g = 0.0, .b = 0.0};
 
-void add_gem(scene_t *scene, body_t *coll, vector_t center, char *draw){
+shape_t *gem_shape_init(void) {
+  return shape_init(draw_gem(GEM_RADIUS, VEC_ZERO));
+}
+
+void add_gem(scene_t *scene, shape_t *shape, body_t *coll, vector_t center, char *draw){
   double width = GEM_RADIUS * sqrt(3);
   double height = 2 * GEM_RADIUS - GEM_DEC + GEM_INC * sqrt(3)/2;
   double shift = GEM_INC * sqrt(3)/4;
-  body_t *gem = body_init_more_info(draw_gem(GEM_RADIUS, (vector_t) {center.x, center.y + shift}), GEM_MASS, BLK,
-                                    width, height);
+  vector_t centroid = vec_add((vector_t) {center.x, center.y + shift}, shape_get_origin(shape));
+  body_t *gem = body_init_with_shape(shape, centroid, GEM_MASS, BLK, width, height);
   body_set_texture(gem, sdl_load_image(draw));
   scene_add_body(scene, gem);
   create_disappear_collision(scene, gem, coll);
 }
 
 void add_level_one_gems(scene_t *scene, body_t *player1, body_t *player2) {
-  add_gem(scene, player1, GEM_LVLONE1_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLONE2_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLONE3_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLONE4_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLONE5_CENT, "assets/stargem.png");
-  add_gem(scene, player2, GEM_LVLONE6_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLONE7_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLONE8_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLONE9_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLONE10_CENT, "assets/moongem.png");
+  shape_t *shape = gem_shape_init();
+  add_gem(scene, shape, player1, GEM_LVLONE1_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLONE2_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLONE3_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLONE4_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLONE5_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player2, GEM_LVLONE6_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLONE7_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLONE8_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLONE9_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLONE10_CENT, "assets/moongem.png");
+  shape_release(shape);
 }
 
 void add_level_two_gems(scene_t *scene, body_t *player1, body_t *player2) {
-  add_gem(scene, player1, GEM_LVLTWO1_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLTWO2_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLTWO3_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLTWO4_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLTWO5_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLTWO6_CENT, "assets/stargem.png");
-  add_gem(scene, player2, GEM_LVLTWO7_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLTWO8_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLTWO9_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLTWO10_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLTWO11_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLTWO12_CENT, "assets/moongem.png");
+  shape_t *shape = gem_shape_init();
+  add_gem(scene, shape, player1, GEM_LVLTWO1_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLTWO2_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLTWO3_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLTWO4_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLTWO5_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLTWO6_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player2, GEM_LVLTWO7_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLTWO8_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLTWO9_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLTWO10_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLTWO11_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLTWO12_CENT, "assets/moongem.png");
+  shape_release(shape);
 }
 
 void add_level_three_gems(scene_t *scene, body_t *player1, body_t *player2) {
-  add_gem(scene, player1, GEM_LVLTHREE1_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLTHREE2_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLTHREE3_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLTHREE4_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLTHREE5_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLTHREE6_CENT, "assets/stargem.png");
-  add_gem(scene, player2, GEM_LVLTHREE7_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLTHREE8_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLTHREE9_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLTHREE10_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLTHREE11_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLTHREE12_CENT, "assets/moongem.png");
+  shape_t *shape = gem_shape_init();
+  add_gem(scene, shape, player1, GEM_LVLTHREE1_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLTHREE2_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLTHREE3_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLTHREE4_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLTHREE5_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLTHREE6_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player2, GEM_LVLTHREE7_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLTHREE8_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLTHREE9_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLTHREE10_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLTHREE11_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLTHREE12_CENT, "assets/moongem.png");
+  shape_release(shape);
 }
 
 void add_level_four_gems(scene_t *scene, body_t *player1, body_t *player2) {
-  add_gem(scene, player1, GEM_LVLFOUR1_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLFOUR2_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLFOUR3_CENT, "assets/stargem.png");
-  add_gem(scene, player1, GEM_LVLFOUR4_CENT, "assets/stargem.png");
-  add_gem(scene, player2, GEM_LVLFOUR5_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLFOUR6_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLFOUR7_CENT, "assets/moongem.png");
-  add_gem(scene, player2, GEM_LVLFOUR8_CENT, "assets/moongem.png");
+  shape_t *shape = gem_shape_init();
+  add_gem(scene, shape, player1, GEM_LVLFOUR1_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLFOUR2_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLFOUR3_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player1, GEM_LVLFOUR4_CENT, "assets/stargem.png");
+  add_gem(scene, shape, player2, GEM_LVLFOUR5_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLFOUR6_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLFOUR7_CENT, "assets/moongem.png");
+  add_gem(scene, shape, player2, GEM_LVLFOUR8_CENT, "assets/moongem.png");
+  shape_release(shape);
 }
\ No newline at end of file
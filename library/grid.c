@@ -0,0 +1,189 @@
+#include "grid.h"
+#include "body.h"
+#include "collision.h"
+#include "list.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+/**
+ * The cells are stored in compressed form: the bodies overlapping cell c are
+ * entries[cell_starts[c]] up to (but excluding) entries[cell_starts[c + 1]].
+ */
+typedef struct grid {
+  double cell_size;
+  vector_t origin;
+  size_t columns;
+  size_t rows;
+  size_t *cell_starts;
+  size_t *entries;
+  size_t num_bodies;
+  body_t **bodies;
+  aabb_t *bounds;
+  // Last query each body was reported in, to avoid reporting it twice
+  size_t *stamps;
+  size_t query;
+} grid_t;
+
+grid_t *grid_init(double cell_size) {
+  assert(cell_size > 0);
+  grid_t *grid = malloc(sizeof(grid_t));
+  assert(grid != NULL);
+  grid->cell_size = cell_size;
+  grid->origin = VEC_ZERO;
+  grid->columns = 0;
+  grid->rows = 0;
+  grid->cell_starts = NULL;
+  grid->entries = NULL;
+  grid->num_bodies = 0;
+  grid->bodies = NULL;
+  grid->bounds = NULL;
+  grid->stamps = NULL;
+  grid->query = 0;
+  return grid;
+}
+
+void grid_clear(grid_t *grid) {
+  free(grid->cell_starts);
+  free(grid->entries);
+  free(grid->bodies);
+  free(grid->bounds);
+  free(grid->stamps);
+  grid->cell_starts = NULL;
+  grid->entries = NULL;
+  grid->bodies = NULL;
+  grid->bounds = NULL;
+  grid->stamps = NULL;
+  grid->columns = 0;
+  grid->rows = 0;
+  grid->num_bodies = 0;
+}
+
+void grid_free(grid_t *grid) {
+  grid_clear(grid);
+  free(grid);
+}
+
+/**
+ * Converts a coordinate to the index of the cell containing it,
+ * clamped to the grid.
+ */
+size_t grid_cell(double coordinate, double origin, double cell_size,
+                 size_t cells) {
+  double cell = floor((coordinate - origin) / cell_size);
+  if (cell < 0) {
+    return 0;
+  }
+  if (cell >= cells) {
+    return cells - 1;
+  }
+  return (size_t)cell;
+}
+
+void grid_build(grid_t *grid, list_t *bodies) {
+  grid_clear(grid);
+  size_t n = list_size(bodies);
+  if (n == 0) {
+    return;
+  }
+
+  grid->num_bodies = n;
+  grid->bodies = malloc(n * sizeof(body_t *));
+  grid->bounds = malloc(n * sizeof(aabb_t));
+  grid->stamps = calloc(n, sizeof(size_t));
+  assert(grid->bodies != NULL && grid->bounds != NULL && grid->stamps != NULL);
+  aabb_t extent;
+  for (size_t i = 0; i < n; i++) {
+    grid->bodies[i] = list_get(bodies, i);
+    grid->bounds[i] = find_bounds(body_borrow_shape(grid->bodies[i]));
+    if (i == 0) {
+      extent = grid->bounds[i];
+    } else {
+      extent.min.x = fmin(extent.min.x, grid->bounds[i].min.x);
+      extent.min.y = fmin(extent.min.y, grid->bounds[i].min.y);
+      extent.max.x = fmax(extent.max.x, grid->bounds[i].max.x);
+      extent.max.y = fmax(extent.max.y, grid->bounds[i].max.y);
+    }
+  }
+  grid->origin = extent.min;
+  grid->columns = (size_t)((extent.max.x - extent.min.x) / grid->cell_size) + 1;
+  grid->rows = (size_t)((extent.max.y - extent.min.y) / grid->cell_size) + 1;
+
+  // Count the bodies in each cell, then turn the counts into start offsets
+  size_t cells = grid->columns * grid->rows;
+  grid->cell_starts = calloc(cells + 1, sizeof(size_t));
+  assert(grid->cell_starts != NULL);
+  for (size_t i = 0; i < n; i++) {
+    aabb_t box = grid->bounds[i];
+    size_t x0 = grid_cell(box.min.x, grid->origin.x, grid->cell_size,
+                          grid->columns);
+    size_t x1 = grid_cell(box.max.x, grid->origin.x, grid->cell_size,
+                          grid->columns);
+    size_t y0 = grid_cell(box.min.y, grid->origin.y, grid->cell_size,
+                          grid->rows);
+    size_t y1 = grid_cell(box.max.y, grid->origin.y, grid->cell_size,
+                          grid->rows);
+    for (size_t y = y0; y <= y1; y++) {
+      for (size_t x = x0; x <= x1; x++) {
+        grid->cell_starts[y * grid->columns + x + 1]++;
+      }
+    }
+  }
+  for (size_t c = 0; c < cells; c++) {
+    grid->cell_starts[c + 1] += grid->cell_starts[c];
+  }
+
+  grid->entries = malloc(grid->cell_starts[cells] * sizeof(size_t));
+  assert(grid->entries != NULL);
+  size_t *fill = malloc(cells * sizeof(size_t));
+  assert(fill != NULL);
+  for (size_t c = 0; c < cells; c++) {
+    fill[c] = grid->cell_starts[c];
+  }
+  for (size_t i = 0; i < n; i++) {
+    aabb_t box = grid->bounds[i];
+    size_t x0 = grid_cell(box.min.x, grid->origin.x, grid->cell_size,
+                          grid->columns);
+    size_t x1 = grid_cell(box.max.x, grid->origin.x, grid->cell_size,
+                          grid->columns);
+    size_t y0 = grid_cell(box.min.y, grid->origin.y, grid->cell_size,
+                          grid->rows);
+    size_t y1 = grid_cell(box.max.y, grid->origin.y, grid->cell_size,
+                          grid->rows);
+    for (size_t y = y0; y <= y1; y++) {
+      for (size_t x = x0; x <= x1; x++) {
+        grid->entries[fill[y * grid->columns + x]++] = i;
+      }
+    }
+  }
+  free(fill);
+}
+
+void grid_query(grid_t *grid, aabb_t box, list_t *results) {
+  if (grid->num_bodies == 0) {
+    return;
+  }
+  grid->query++;
+  size_t x0 =
+      grid_cell(box.min.x, grid->origin.x, grid->cell_size, grid->columns);
+  size_t x1 =
+      grid_cell(box.max.x, grid->origin.x, grid->cell_size, grid->columns);
+  size_t y0 = grid_cell(box.min.y, grid->origin.y, grid->cell_size, grid->rows);
+  size_t y1 = grid_cell(box.max.y, grid->origin.y, grid->cell_size, grid->rows);
+  for (size_t y = y0; y <= y1; y++) {
+    for (size_t x = x0; x <= x1; x++) {
+      size_t cell = y * grid->columns + x;
+      for (size_t e = grid->cell_starts[cell]; e < grid->cell_starts[cell + 1];
+           e++) {
+        size_t i = grid->entries[e];
+        if (grid->stamps[i] == grid->query) {
+          continue;
+        }
+        grid->stamps[i] = grid->query;
+        if (aabb_overlap(box, grid->bounds[i])) {
+          list_add(results, grid->bodies[i]);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,227 @@
+#include "islands.h"
+#include "body.h"
+#include "list.h"
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+const size_t INITIAL_ISLAND_BODIES_GUESS = 16;
+
+/**
+ * A body in the union-find forest. Roots are their own parent.
+ */
+typedef struct island_node {
+  body_t *body;
+  size_t parent;
+  size_t island;
+  // Whether the body has been freed since the islands were built
+  bool forgotten;
+} island_node_t;
+
+typedef struct islands {
+  // Sorted by body address, for looking bodies up
+  island_node_t *nodes;
+  size_t num_nodes;
+  size_t capacity;
+  size_t num_islands;
+  // Per-island flags for islands_update_sleep(), with room for capacity
+  // islands since there is at most one per node
+  bool *moving;
+  bool *sleepy;
+} islands_t;
+
+islands_t *islands_init(void) {
+  islands_t *islands = malloc(sizeof(islands_t));
+  assert(islands != NULL);
+  islands->capacity = INITIAL_ISLAND_BODIES_GUESS;
+  islands->nodes = malloc(islands->capacity * sizeof(island_node_t));
+  islands->moving = malloc(islands->capacity * sizeof(bool));
+  islands->sleepy = malloc(islands->capacity * sizeof(bool));
+  assert(islands->nodes != NULL && islands->moving != NULL &&
+         islands->sleepy != NULL);
+  islands->num_nodes = 0;
+  islands->num_islands = 0;
+  return islands;
+}
+
+void islands_free(islands_t *islands) {
+  free(islands->nodes);
+  free(islands->moving);
+  free(islands->sleepy);
+  free(islands);
+}
+
+int island_node_compare(const void *a, const void *b) {
+  uintptr_t body1 = (uintptr_t)((const island_node_t *)a)->body;
+  uintptr_t body2 = (uintptr_t)((const island_node_t *)b)->body;
+  return body1 < body2 ? -1 : body1 > body2;
+}
+
+void islands_reset(islands_t *islands, list_t *bodies) {
+  if (list_size(bodies) > islands->capacity) {
+    islands->capacity = list_size(bodies);
+    islands->nodes =
+        realloc(islands->nodes, islands->capacity * sizeof(island_node_t));
+    islands->moving =
+        realloc(islands->moving, islands->capacity * sizeof(bool));
+    islands->sleepy =
+        realloc(islands->sleepy, islands->capacity * sizeof(bool));
+    assert(islands->nodes != NULL && islands->moving != NULL &&
+           islands->sleepy != NULL);
+  }
+  islands->num_nodes = 0;
+  for (size_t i = 0; i < list_size(bodies); i++) {
+    body_t *body = list_get(bodies, i);
+    if (body_get_mass(body) != INFINITY) {
+      islands->nodes[islands->num_nodes++] = (island_node_t){.body = body};
+    }
+  }
+  qsort(islands->nodes, islands->num_nodes, sizeof(island_node_t),
+        island_node_compare);
+  for (size_t i = 0; i < islands->num_nodes; i++) {
+    islands->nodes[i].parent = i;
+  }
+  islands->num_islands = 0;
+}
+
+/**
+ * Finds a body's node, or returns num_nodes if it is not grouped.
+ */
+size_t islands_find_node(islands_t *islands, body_t *body) {
+  island_node_t key = {.body = body};
+  island_node_t *found =
+      bsearch(&key, islands->nodes, islands->num_nodes,
+              sizeof(island_node_t), island_node_compare);
+  return found == NULL ? islands->num_nodes : (size_t)(found - islands->nodes);
+}
+
+/**
+ * Finds the root of a node's tree, halving the path on the way up.
+ */
+size_t islands_find_root(islands_t *islands, size_t node) {
+  while (islands->nodes[node].parent != node) {
+    size_t grandparent = islands->nodes[islands->nodes[node].parent].parent;
+    islands->nodes[node].parent = grandparent;
+    node = grandparent;
+  }
+  return node;
+}
+
+void islands_connect(islands_t *islands, body_t *body1, body_t *body2) {
+  size_t node1 = islands_find_node(islands, body1);
+  size_t node2 = islands_find_node(islands, body2);
+  if (node1 == islands->num_nodes || node2 == islands->num_nodes) {
+    return;
+  }
+  size_t root1 = islands_find_root(islands, node1);
+  size_t root2 = islands_find_root(islands, node2);
+  islands->nodes[root2].parent = root1;
+}
+
+/**
+ * Joins a body to the first grouped body of a set being connected,
+ * or makes it the first if there is none yet.
+ */
+void islands_join_first(islands_t *islands, body_t **first, body_t *body) {
+  if (islands_find_node(islands, body) == islands->num_nodes) {
+    return;
+  }
+  if (*first == NULL) {
+    *first = body;
+  } else {
+    islands_connect(islands, *first, body);
+  }
+}
+
+void islands_connect_all(islands_t *islands, list_t *bodies) {
+  // Join everything to the first body that is grouped
+  body_t *first = NULL;
+  for (size_t i = 0; i < list_size(bodies); i++) {
+    islands_join_first(islands, &first, list_get(bodies, i));
+  }
+}
+
+void islands_connect_n(islands_t *islands, body_t **bodies,
+                       size_t num_bodies) {
+  body_t *first = NULL;
+  for (size_t i = 0; i < num_bodies; i++) {
+    islands_join_first(islands, &first, bodies[i]);
+  }
+}
+
+size_t islands_finish(islands_t *islands) {
+  islands->num_islands = 0;
+  for (size_t i = 0; i < islands->num_nodes; i++) {
+    if (islands->nodes[i].parent == i) {
+      islands->nodes[i].island = islands->num_islands++;
+    }
+  }
+  for (size_t i = 0; i < islands->num_nodes; i++) {
+    size_t root = islands_find_root(islands, i);
+    islands->nodes[i].island = islands->nodes[root].island;
+  }
+  return islands->num_islands;
+}
+
+bool islands_same(islands_t *islands, body_t *body1, body_t *body2) {
+  size_t node1 = islands_find_node(islands, body1);
+  size_t node2 = islands_find_node(islands, body2);
+  if (node1 == islands->num_nodes || node2 == islands->num_nodes ||
+      islands->nodes[node1].forgotten || islands->nodes[node2].forgotten) {
+    return false;
+  }
+  return islands->nodes[node1].island == islands->nodes[node2].island;
+}
+
+void islands_forget(islands_t *islands, body_t *body) {
+  size_t node = islands_find_node(islands, body);
+  if (node < islands->num_nodes) {
+    // Keep the slot so the other nodes' parents stay valid, but leave the
+    // body out of any later sleep decisions
+    islands->nodes[node].forgotten = true;
+  }
+}
+
+size_t islands_update_sleep(islands_t *islands) {
+  if (islands->num_islands == 0) {
+    return 0;
+  }
+  bool *moving = islands->moving;
+  bool *sleepy = islands->sleepy;
+  memset(moving, 0, islands->num_islands * sizeof(bool));
+  memset(sleepy, 0, islands->num_islands * sizeof(bool));
+  for (size_t i = 0; i < islands->num_nodes; i++) {
+    if (islands->nodes[i].forgotten) {
+      continue;
+    }
+    body_t *body = islands->nodes[i].body;
+    size_t island = islands->nodes[i].island;
+    if (!body_is_resting(body)) {
+      moving[island] = true;
+    } else if (body_is_asleep(body)) {
+      sleepy[island] = true;
+    }
+  }
+
+  size_t asleep = 0;
+  for (size_t i = 0; i < islands->num_islands; i++) {
+    if (!moving[i] && sleepy[i]) {
+      asleep++;
+    }
+  }
+  for (size_t i = 0; i < islands->num_nodes; i++) {
+    if (islands->nodes[i].forgotten) {
+      continue;
+    }
+    body_t *body = islands->nodes[i].body;
+    size_t island = islands->nodes[i].island;
+    if (moving[island]) {
+      body_wake(body);
+    } else if (sleepy[island]) {
+      body_sleep(body);
+    }
+  }
+  return asleep;
+}
@@ -6,10 +6,14 @@
 #include <stdlib.h>
 #include <string.h>
 
+const double LIST_GROWTH_FACTOR = 2;
+
 typedef struct list {
   void **items;
   size_t size;
   size_t capacity;
+  // How much the capacity is multiplied by when the list is full
+  double growth;
   free_func_t freer;
 } list_t;
 
@@ -20,6 +24,7 @@ list_t *list_init(size_t initial_size, free_func_t freer) {
   assert(body->items != NULL);
   body->size = 0;
   body->capacity = initial_size;
+  body->growth = LIST_GROWTH_FACTOR;
   body->freer = freer;
   return body;
 }
@@ -43,33 +48,68 @@ void *list_get(list_t *list, size_t index) {
 }
 
 void *list_remove(list_t *list, size_t index) {
-  assert(list_size(list) > 0);
+  assert(index < list_size(list));
   void *store = list->items[index];
-  if (index != list_size(list) - 1) {
-    for (size_t i = index + 1; i < list_size(list); i++) {
-      list->items[i - 1] = list->items[i];
-    }
-    list->items[list_size(list) - 1] = store;
-  }
+  memmove(&list->items[index], &list->items[index + 1],
+          (list->size - index - 1) * sizeof(void *));
+  list->size--;
+  return store;
+}
+
+void *list_swap_remove(list_t *list, size_t index) {
+  assert(index < list_size(list));
+  void *store = list->items[index];
+  list->items[index] = list->items[list_size(list) - 1];
   list->size--;
   return store;
 }
 
+size_t list_remove_if(list_t *list, list_predicate_t predicate, void *aux) {
+  size_t kept = 0;
+  for (size_t i = 0; i < list->size; i++) {
+    void *item = list->items[i];
+    if (!predicate(item, aux)) {
+      list->items[kept++] = item;
+    } else if (list->freer != NULL) {
+      list->freer(item);
+    }
+  }
+  size_t removed = list->size - kept;
+  list->size = kept;
+  return removed;
+}
+
 void list_resize(list_t *list) {
-  if (list->capacity == 0) {
-    free(list->items);
-    list->capacity = 1;
-    void **placeholder = malloc(sizeof(void *));
-    list->items = placeholder;
+  size_t capacity = list->capacity * list->growth;
+  if (capacity <= list->capacity) {
+    capacity = list->capacity + 1;
+  }
+  list_reserve(list, capacity);
+}
+
+void list_set_growth(list_t *list, double factor) {
+  assert(factor > 1);
+  list->growth = factor;
+}
+
+void list_reserve(list_t *list, size_t capacity) {
+  if (capacity <= list->capacity) {
     return;
   }
-  void **placeholder = malloc(list->capacity * sizeof(void *) * 2);
-  for (int i = 0; i < list->capacity; i++) {
-    placeholder[i] = list_get(list, i);
+  list->items = realloc(list->items, capacity * sizeof(void *));
+  assert(list->items != NULL);
+  list->capacity = capacity;
+}
+
+void list_shrink_to_fit(list_t *list) {
+  // Keep room for one element, since realloc() to 0 bytes may free the array
+  size_t capacity = list->size > 0 ? list->size : 1;
+  if (capacity >= list->capacity) {
+    return;
   }
-  list->capacity = list->capacity * 2;
-  free(list->items);
-  list->items = placeholder;
+  list->items = realloc(list->items, capacity * sizeof(void *));
+  assert(list->items != NULL);
+  list->capacity = capacity;
 }
 
 void list_add(list_t *list, void *value) {
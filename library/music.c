@@ -12,11 +12,17 @@
 typedef struct music music_t;
 
 void music_init(){
+  if (sdl_is_headless()) {
+    return;
+  }
   SDL_Init(SDL_INIT_AUDIO);
   Mix_AllocateChannels(3);
 }
 
 void music_play(char * music_file, int repeats){
+  if (sdl_is_headless()) {
+    return;
+  }
   Mix_OpenAudio(MIX_DEFAULT_FREQUENCY,MIX_DEFAULT_FORMAT,2,2048);
   Mix_Chunk *bkgd_music1;
   bkgd_music1 = Mix_LoadWAV(music_file);
@@ -32,6 +38,9 @@ void music_play(char * music_file, int repeats){
 }
 
 void music_bkgd_stop() {
+  if (sdl_is_headless()) {
+    return;
+  }
   Mix_HaltChannel(0);
   if (Mix_GetChunk(0)) {
     Mix_FreeChunk(Mix_GetChunk(0));
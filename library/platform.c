@@ -10,7 +10,6 @@
 const rgb_color_t BLCK = (rgb_color_t){.r = 0.0, .g = 0.0, .b = 0.0};
 
 const double PLAT_MASS = INFINITY;
-const double GRV_CNST = 700;
 const double WLL_HEIGHT = 16;
 
 const vector_t PLAT_LVLONE1_CENT = (vector_t) {600, 660};
@@ -130,78 +129,75 @@ const vector_t PLAT_LVLFOUR13_CENT = (vector_t) {884, 65};
 const double PLAT_LVLFOUR13_LENGTH = 200;
 const double PLAT_LVLFOUR13_HEIGHT = 130;
 
-void add_platform(scene_t *scene, body_t *player1, body_t *player2, body_t *block, vector_t center, double length, double height) {
+void add_platform(scene_t *scene, vector_t center, double length, double height) {
   body_t *plat = body_init_more_info(
       draw_rect((vector_t){center.x, center.y}, length, height),
       PLAT_MASS, BLCK, length, height);
-  scene_add_hidden_body(scene, plat);
-  create_plat_collision(scene, GRV_CNST, player1, plat);
-  create_plat_collision(scene, GRV_CNST, player2, plat);
-  create_plat_collision(scene, GRV_CNST, block, plat);
+  scene_add_static_body(scene, plat);
 }
 
-void add_level_one_platforms(scene_t *scene, body_t *player1, body_t *player2, body_t *block){
+void add_level_one_platforms(scene_t *scene){
   //WINDOW:
-  add_platform(scene, player1, player2, block, PLAT_LVLONE1_CENT, PLAT_LVLONE1_LENGTH, PLAT_LVLONE1_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLONE2_CENT, PLAT_LVLONE2_LENGTH, PLAT_LVLONE2_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLONE3_CENT, PLAT_LVLONE3_LENGTH, PLAT_LVLONE3_LENGTH);
-  add_platform(scene, player1, player2, block, PLAT_LVLONE4_CENT, PLAT_LVLONE4_LENGTH, PLAT_LVLONE4_LENGTH);
-  add_platform(scene, player1, player2, block, PLAT_LVLONE5_CENT, PLAT_LVLONE5_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLONE6_CENT, PLAT_LVLONE6_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLONE7_CENT, PLAT_LVLONE7_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLONE8_CENT, PLAT_LVLONE8_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLONE9_CENT, PLAT_LVLONE9_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLONE10_CENT, WLL_HEIGHT, PLAT_LVLONE10_LENGTH);
-  add_platform(scene, player1, player2, block, PLAT_LVLONE11_CENT, PLAT_LVLONE11_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLONE12_CENT, PLAT_LVLONE12_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLONE13_CENT, WLL_HEIGHT, PLAT_LVLONE13_LENGTH);
-  add_platform(scene, player1, player2, block, PLAT_LVLONE14_CENT, PLAT_LVLONE14_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLONE15_CENT, PLAT_LVLONE15_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLONE1_CENT, PLAT_LVLONE1_LENGTH, PLAT_LVLONE1_HEIGHT);
+  add_platform(scene, PLAT_LVLONE2_CENT, PLAT_LVLONE2_LENGTH, PLAT_LVLONE2_HEIGHT);
+  add_platform(scene, PLAT_LVLONE3_CENT, PLAT_LVLONE3_LENGTH, PLAT_LVLONE3_LENGTH);
+  add_platform(scene, PLAT_LVLONE4_CENT, PLAT_LVLONE4_LENGTH, PLAT_LVLONE4_LENGTH);
+  add_platform(scene, PLAT_LVLONE5_CENT, PLAT_LVLONE5_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLONE6_CENT, PLAT_LVLONE6_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLONE7_CENT, PLAT_LVLONE7_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLONE8_CENT, PLAT_LVLONE8_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLONE9_CENT, PLAT_LVLONE9_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLONE10_CENT, WLL_HEIGHT, PLAT_LVLONE10_LENGTH);
+  add_platform(scene, PLAT_LVLONE11_CENT, PLAT_LVLONE11_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLONE12_CENT, PLAT_LVLONE12_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLONE13_CENT, WLL_HEIGHT, PLAT_LVLONE13_LENGTH);
+  add_platform(scene, PLAT_LVLONE14_CENT, PLAT_LVLONE14_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLONE15_CENT, PLAT_LVLONE15_LENGTH, WLL_HEIGHT);
 }
 
-void add_level_two_platforms(scene_t *scene, body_t *player1, body_t *player2, body_t *block){
+void add_level_two_platforms(scene_t *scene){
   //Walls:
-  add_platform(scene, player1, player2, block, PLAT_LVLTWO1_CENT, PLAT_LVLTWO1_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTWO2_CENT, PLAT_LVLTWO2_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTWO3_CENT, PLAT_LVLTWO3_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTWO4_CENT, PLAT_LVLTWO4_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTWO5_CENT, PLAT_LVLTWO5_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTWO6_CENT, PLAT_LVLTWO6_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTWO7_CENT, PLAT_LVLTWO7_LENGTH, PLAT_LVLTWO7_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTWO8_CENT, PLAT_LVLTWO8_LENGTH, PLAT_LVLTWO8_HEIGHT);
+  add_platform(scene, PLAT_LVLTWO1_CENT, PLAT_LVLTWO1_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLTWO2_CENT, PLAT_LVLTWO2_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLTWO3_CENT, PLAT_LVLTWO3_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLTWO4_CENT, PLAT_LVLTWO4_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLTWO5_CENT, PLAT_LVLTWO5_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLTWO6_CENT, PLAT_LVLTWO6_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLTWO7_CENT, PLAT_LVLTWO7_LENGTH, PLAT_LVLTWO7_HEIGHT);
+  add_platform(scene, PLAT_LVLTWO8_CENT, PLAT_LVLTWO8_LENGTH, PLAT_LVLTWO8_HEIGHT);
 }
 
-void add_level_three_platforms(scene_t *scene, body_t *player1, body_t *player2, body_t *block){
-  add_platform(scene, player1, player2, block, PLAT_LVLTHREE1_CENT, PLAT_LVLTHREE1_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTHREE2_CENT, PLAT_LVLTHREE2_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTHREE3_CENT, PLAT_LVLTHREE3_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTHREE4_CENT, PLAT_LVLTHREE4_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTHREE5_CENT, WLL_HEIGHT, PLAT_LVLTHREE5_LENGTH);
-  add_platform(scene, player1, player2, block, PLAT_LVLTHREE6_CENT, WLL_HEIGHT, PLAT_LVLTHREE6_LENGTH);
-  add_platform(scene, player1, player2, block, PLAT_LVLTHREE7_CENT, PLAT_LVLTHREE7_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTHREE8_CENT, WLL_HEIGHT, PLAT_LVLTHREE8_LENGTH);
-  add_platform(scene, player1, player2, block, PLAT_LVLTHREE9_CENT, WLL_HEIGHT, PLAT_LVLTHREE9_LENGTH);
-  add_platform(scene, player1, player2, block, PLAT_LVLTHREE10_CENT, PLAT_LVLTHREE10_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTHREE11_CENT, PLAT_LVLTHREE11_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTHREE12_CENT, PLAT_LVLTHREE12_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTHREE13_CENT, PLAT_LVLTHREE13_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTHREE14_CENT, PLAT_LVLTHREE14_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLTHREE15_CENT, PLAT_LVLTHREE15_LENGTH, WLL_HEIGHT); 
-  add_platform(scene, player1, player2, block, PLAT_LVLTHREE16_CENT, PLAT_LVLTHREE16_LENGTH, PLAT_LVLTHREE16_HEIGHT);
+void add_level_three_platforms(scene_t *scene){
+  add_platform(scene, PLAT_LVLTHREE1_CENT, PLAT_LVLTHREE1_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLTHREE2_CENT, PLAT_LVLTHREE2_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLTHREE3_CENT, PLAT_LVLTHREE3_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLTHREE4_CENT, PLAT_LVLTHREE4_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLTHREE5_CENT, WLL_HEIGHT, PLAT_LVLTHREE5_LENGTH);
+  add_platform(scene, PLAT_LVLTHREE6_CENT, WLL_HEIGHT, PLAT_LVLTHREE6_LENGTH);
+  add_platform(scene, PLAT_LVLTHREE7_CENT, PLAT_LVLTHREE7_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLTHREE8_CENT, WLL_HEIGHT, PLAT_LVLTHREE8_LENGTH);
+  add_platform(scene, PLAT_LVLTHREE9_CENT, WLL_HEIGHT, PLAT_LVLTHREE9_LENGTH);
+  add_platform(scene, PLAT_LVLTHREE10_CENT, PLAT_LVLTHREE10_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLTHREE11_CENT, PLAT_LVLTHREE11_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLTHREE12_CENT, PLAT_LVLTHREE12_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLTHREE13_CENT, PLAT_LVLTHREE13_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLTHREE14_CENT, PLAT_LVLTHREE14_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLTHREE15_CENT, PLAT_LVLTHREE15_LENGTH, WLL_HEIGHT); 
+  add_platform(scene, PLAT_LVLTHREE16_CENT, PLAT_LVLTHREE16_LENGTH, PLAT_LVLTHREE16_HEIGHT);
 }
 
-void add_level_four_platforms(scene_t *scene, body_t *player1, body_t *player2, body_t *block){
-  add_platform(scene, player1, player2, block, PLAT_LVLFOUR1_CENT, PLAT_LVLFOUR1_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLFOUR2_CENT, PLAT_LVLFOUR2_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLFOUR3_CENT, WLL_HEIGHT, PLAT_LVLFOUR3_LENGTH);
-  add_platform(scene, player1, player2, block, PLAT_LVLFOUR4_CENT, WLL_HEIGHT, PLAT_LVLFOUR4_LENGTH);
-  add_platform(scene, player1, player2, block, PLAT_LVLFOUR5_CENT, PLAT_LVLFOUR5_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLFOUR6_CENT, PLAT_LVLFOUR6_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLFOUR7_CENT, PLAT_LVLFOUR7_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLFOUR8_CENT, PLAT_LVLFOUR8_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLFOUR9_CENT, WLL_HEIGHT, PLAT_LVLFOUR9_LENGTH);
-  add_platform(scene, player1, player2, block, PLAT_LVLFOUR10_CENT, PLAT_LVLFOUR10_LENGTH, WLL_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLFOUR11_CENT, PLAT_LVLFOUR11_LENGTH, PLAT_LVLFOUR11_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLFOUR12_CENT, PLAT_LVLFOUR12_LENGTH, PLAT_LVLFOUR12_HEIGHT);
-  add_platform(scene, player1, player2, block, PLAT_LVLFOUR13_CENT, PLAT_LVLFOUR13_LENGTH, PLAT_LVLFOUR13_HEIGHT);
+void add_level_four_platforms(scene_t *scene){
+  add_platform(scene, PLAT_LVLFOUR1_CENT, PLAT_LVLFOUR1_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLFOUR2_CENT, PLAT_LVLFOUR2_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLFOUR3_CENT, WLL_HEIGHT, PLAT_LVLFOUR3_LENGTH);
+  add_platform(scene, PLAT_LVLFOUR4_CENT, WLL_HEIGHT, PLAT_LVLFOUR4_LENGTH);
+  add_platform(scene, PLAT_LVLFOUR5_CENT, PLAT_LVLFOUR5_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLFOUR6_CENT, PLAT_LVLFOUR6_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLFOUR7_CENT, PLAT_LVLFOUR7_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLFOUR8_CENT, PLAT_LVLFOUR8_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLFOUR9_CENT, WLL_HEIGHT, PLAT_LVLFOUR9_LENGTH);
+  add_platform(scene, PLAT_LVLFOUR10_CENT, PLAT_LVLFOUR10_LENGTH, WLL_HEIGHT);
+  add_platform(scene, PLAT_LVLFOUR11_CENT, PLAT_LVLFOUR11_LENGTH, PLAT_LVLFOUR11_HEIGHT);
+  add_platform(scene, PLAT_LVLFOUR12_CENT, PLAT_LVLFOUR12_LENGTH, PLAT_LVLFOUR12_HEIGHT);
+  add_platform(scene, PLAT_LVLFOUR13_CENT, PLAT_LVLFOUR13_LENGTH, PLAT_LVLFOUR13_HEIGHT);
 }
@@ -3,6 +3,7 @@
 #include "stdlib.h"
 #include "vector.h"
 #include <assert.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -55,3 +56,297 @@ void polygon_rotate(list_t *polygon, double angle, vector_t point) {
     curr_vector->y = curr_vector->y + point.y;
   }
 }
+
+const double CONVEX_EPSILON = 1e-9;
+
+/**
+ * Returns the z-component of (b - a) x (c - b), which is positive when
+ * a, b, c make a left (counterclockwise) turn.
+ */
+double polygon_turn(vector_t a, vector_t b, vector_t c) {
+  return vec_cross(vec_subtract(b, a), vec_subtract(c, b));
+}
+
+bool polygon_is_convex(list_t *polygon) {
+  size_t size = list_size(polygon);
+  if (size < 4) {
+    return true;
+  }
+  double sign = polygon_area(polygon) < 0 ? -1.0 : 1.0;
+  for (size_t i = 0; i < size; i++) {
+    vector_t a = *(vector_t *)list_get(polygon, i);
+    vector_t b = *(vector_t *)list_get(polygon, (i + 1) % size);
+    vector_t c = *(vector_t *)list_get(polygon, (i + 2) % size);
+    if (sign * polygon_turn(a, b, c) < -CONVEX_EPSILON) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Returns whether p lies inside (or on the boundary of) the counterclockwise
+ * triangle abc.
+ */
+bool triangle_contains(vector_t a, vector_t b, vector_t c, vector_t p) {
+  return polygon_turn(a, b, p) >= 0 && polygon_turn(b, c, p) >= 0 &&
+         polygon_turn(c, a, p) >= 0;
+}
+
+/**
+ * A convex piece under construction, stored as indices into the
+ * counterclockwise vertex array of the polygon being decomposed.
+ */
+typedef struct piece {
+  size_t *indices;
+  size_t size;
+} piece_t;
+
+piece_t *piece_init(size_t a, size_t b, size_t c) {
+  piece_t *piece = malloc(sizeof(piece_t));
+  assert(piece != NULL);
+  piece->indices = malloc(3 * sizeof(size_t));
+  assert(piece->indices != NULL);
+  piece->indices[0] = a;
+  piece->indices[1] = b;
+  piece->indices[2] = c;
+  piece->size = 3;
+  return piece;
+}
+
+void piece_free(piece_t *piece) {
+  free(piece->indices);
+  free(piece);
+}
+
+/**
+ * Returns the position of the directed edge from->to in a piece,
+ * or the piece's size if the piece has no such edge.
+ */
+size_t piece_find_edge(piece_t *piece, size_t from, size_t to) {
+  for (size_t i = 0; i < piece->size; i++) {
+    if (piece->indices[i] == from &&
+        piece->indices[(i + 1) % piece->size] == to) {
+      return i;
+    }
+  }
+  return piece->size;
+}
+
+/**
+ * Glues two pieces along the diagonal they share.
+ * first contains the edge a->b at position i, second contains b->a at j.
+ * The result walks first from b round to a, then second from a round to b.
+ */
+piece_t *piece_merge(piece_t *first, size_t i, piece_t *second, size_t j) {
+  piece_t *merged = malloc(sizeof(piece_t));
+  assert(merged != NULL);
+  merged->size = first->size + second->size - 2;
+  merged->indices = malloc(merged->size * sizeof(size_t));
+  assert(merged->indices != NULL);
+  size_t k = 0;
+  for (size_t n = 1; n <= first->size; n++) {
+    merged->indices[k++] = first->indices[(i + n) % first->size];
+  }
+  for (size_t n = 2; n < second->size; n++) {
+    merged->indices[k++] = second->indices[(j + n) % second->size];
+  }
+  return merged;
+}
+
+bool piece_is_convex(piece_t *piece, vector_t *points) {
+  for (size_t i = 0; i < piece->size; i++) {
+    vector_t a = points[piece->indices[i]];
+    vector_t b = points[piece->indices[(i + 1) % piece->size]];
+    vector_t c = points[piece->indices[(i + 2) % piece->size]];
+    if (polygon_turn(a, b, c) < -CONVEX_EPSILON) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Triangulates a simple counterclockwise polygon by ear clipping.
+ * Adds one piece per triangle to pieces and returns false if no ear could be
+ * found (the polygon is degenerate or self-intersecting).
+ */
+bool polygon_triangulate(vector_t *points, size_t size, list_t *pieces) {
+  size_t *remaining = malloc(size * sizeof(size_t));
+  assert(remaining != NULL);
+  for (size_t i = 0; i < size; i++) {
+    remaining[i] = i;
+  }
+  size_t count = size;
+  while (count > 3) {
+    bool clipped = false;
+    for (size_t i = 0; i < count && !clipped; i++) {
+      size_t prev = remaining[(i + count - 1) % count];
+      size_t curr = remaining[i];
+      size_t next = remaining[(i + 1) % count];
+      vector_t a = points[prev], b = points[curr], c = points[next];
+      if (polygon_turn(a, b, c) <= CONVEX_EPSILON) {
+        continue;
+      }
+      bool ear = true;
+      for (size_t j = 0; j < count && ear; j++) {
+        size_t other = remaining[j];
+        if (other == prev || other == curr || other == next) {
+          continue;
+        }
+        // Only reflex vertices can poke into a candidate ear
+        vector_t before = points[remaining[(j + count - 1) % count]];
+        vector_t after = points[remaining[(j + 1) % count]];
+        if (polygon_turn(before, points[other], after) > CONVEX_EPSILON) {
+          continue;
+        }
+        ear = !triangle_contains(a, b, c, points[other]);
+      }
+      if (ear) {
+        list_add(pieces, piece_init(prev, curr, next));
+        memmove(&remaining[i], &remaining[i + 1],
+                (count - i - 1) * sizeof(size_t));
+        count--;
+        clipped = true;
+      }
+    }
+    if (!clipped) {
+      free(remaining);
+      return false;
+    }
+  }
+  list_add(pieces, piece_init(remaining[0], remaining[1], remaining[2]));
+  free(remaining);
+  return true;
+}
+
+list_t *polygon_convex_decompose(list_t *polygon) {
+  size_t size = list_size(polygon);
+  if (polygon_is_convex(polygon)) {
+    return NULL;
+  }
+
+  // Work on a counterclockwise copy; pieces are flipped back at the end
+  bool clockwise = polygon_area(polygon) < 0;
+  vector_t *points = malloc(size * sizeof(vector_t));
+  assert(points != NULL);
+  for (size_t i = 0; i < size; i++) {
+    size_t from = clockwise ? size - 1 - i : i;
+    points[i] = *(vector_t *)list_get(polygon, from);
+  }
+
+  list_t *pieces = list_init(size, (free_func_t)piece_free);
+  if (!polygon_triangulate(points, size, pieces)) {
+    list_free(pieces);
+    free(points);
+    return NULL;
+  }
+
+  // Hertel-Mehlhorn: visit each diagonal of the triangulation once and drop it
+  // if the two pieces on either side still form a convex piece without it
+  size_t triangles = list_size(pieces);
+  size_t *diagonals = malloc(2 * 3 * triangles * sizeof(size_t));
+  assert(diagonals != NULL);
+  size_t num_diagonals = 0;
+  for (size_t p = 0; p < triangles; p++) {
+    piece_t *triangle = list_get(pieces, p);
+    for (size_t i = 0; i < 3; i++) {
+      size_t a = triangle->indices[i];
+      size_t b = triangle->indices[(i + 1) % 3];
+      if (a < b && b != a + 1 && !(a == 0 && b == size - 1)) {
+        diagonals[2 * num_diagonals] = a;
+        diagonals[2 * num_diagonals + 1] = b;
+        num_diagonals++;
+      }
+    }
+  }
+  for (size_t d = 0; d < num_diagonals; d++) {
+    size_t a = diagonals[2 * d];
+    size_t b = diagonals[2 * d + 1];
+    size_t p = 0, q = 0, i = 0, j = 0;
+    for (; p < list_size(pieces); p++) {
+      i = piece_find_edge(list_get(pieces, p), a, b);
+      if (i < ((piece_t *)list_get(pieces, p))->size) {
+        break;
+      }
+    }
+    for (; q < list_size(pieces); q++) {
+      j = piece_find_edge(list_get(pieces, q), b, a);
+      if (j < ((piece_t *)list_get(pieces, q))->size) {
+        break;
+      }
+    }
+    if (p == list_size(pieces) || q == list_size(pieces)) {
+      continue;
+    }
+    piece_t *candidate =
+        piece_merge(list_get(pieces, p), i, list_get(pieces, q), j);
+    if (!piece_is_convex(candidate, points)) {
+      piece_free(candidate);
+      continue;
+    }
+    piece_free(list_remove(pieces, p > q ? p : q));
+    piece_free(list_remove(pieces, p > q ? q : p));
+    list_add(pieces, candidate);
+  }
+  free(diagonals);
+
+  list_t *result = list_init(list_size(pieces), (free_func_t)list_free);
+  for (size_t p = 0; p < list_size(pieces); p++) {
+    piece_t *piece = list_get(pieces, p);
+    list_t *shape = list_init(piece->size, free);
+    for (size_t i = 0; i < piece->size; i++) {
+      size_t k = clockwise ? piece->size - 1 - i : i;
+      vector_t *v = malloc(sizeof(vector_t));
+      assert(v != NULL);
+      *v = points[piece->indices[k]];
+      list_add(shape, v);
+    }
+    list_add(result, shape);
+  }
+  list_free(pieces);
+  free(points);
+  return result;
+}
+
+bool polygon_contains(list_t *polygon, vector_t point) {
+  // Count the edges crossed by a ray from the point towards +x
+  bool inside = false;
+  size_t size = list_size(polygon);
+  for (size_t i = 0; i < size; i++) {
+    vector_t a = *(vector_t *)list_get(polygon, i);
+    vector_t b = *(vector_t *)list_get(polygon, (i + 1) % size);
+    if ((a.y > point.y) != (b.y > point.y)) {
+      double x = a.x + (point.y - a.y) / (b.y - a.y) * (b.x - a.x);
+      if (point.x < x) {
+        inside = !inside;
+      }
+    }
+  }
+  return inside;
+}
+
+double polygon_raycast(list_t *polygon, vector_t start, vector_t direction) {
+  if (polygon_contains(polygon, start)) {
+    return 0;
+  }
+  double nearest = INFINITY;
+  size_t size = list_size(polygon);
+  for (size_t i = 0; i < size; i++) {
+    vector_t a = *(vector_t *)list_get(polygon, i);
+    vector_t b = *(vector_t *)list_get(polygon, (i + 1) % size);
+    vector_t edge = vec_subtract(b, a);
+    double denominator = vec_cross(direction, edge);
+    if (denominator == 0) {
+      continue;
+    }
+    // Solve start + t * direction = a + u * edge
+    vector_t offset = vec_subtract(a, start);
+    double t = vec_cross(offset, edge) / denominator;
+    double u = vec_cross(offset, direction) / denominator;
+    if (t >= 0 && u >= 0 && u <= 1 && t < nearest) {
+      nearest = t;
+    }
+  }
+  return nearest;
+}
@@ -0,0 +1,147 @@
+#include "pool.h"
+#include "list.h"
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define POOL_ASAN
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__)
+#define POOL_ASAN
+#endif
+
+#ifdef POOL_ASAN
+#include <sanitizer/asan_interface.h>
+#else
+#define ASAN_POISON_MEMORY_REGION(addr, size) ((void)(addr), (void)(size))
+#define ASAN_UNPOISON_MEMORY_REGION(addr, size) ((void)(addr), (void)(size))
+#endif
+
+const size_t INITIAL_SLABS_GUESS = 4;
+const size_t POOL_SLAB_OBJECTS = 64;
+// The size classes are POOL_SMALLEST_CLASS doubled up to NUM_POOL_CLASSES - 1
+// times: 16, 32, 64 and 128 bytes
+const size_t POOL_SMALLEST_CLASS = 16;
+const size_t NUM_POOL_CLASSES = 4;
+
+typedef struct pool {
+  size_t object_size;
+  size_t slab_objects;
+  list_t *slabs;
+  // The most recently released object, which points to the next one
+  void *free_list;
+  size_t live;
+} pool_t;
+
+// The shared pools for pool_alloc_sized(), created on first use
+pool_t **class_pools = NULL;
+
+pool_t *pool_init(size_t object_size, size_t slab_objects) {
+  assert(object_size > 0 && slab_objects > 0);
+  pool_t *pool = malloc(sizeof(pool_t));
+  assert(pool != NULL);
+  if (object_size < sizeof(void *)) {
+    object_size = sizeof(void *);
+  }
+  size_t align = alignof(max_align_t);
+  pool->object_size = (object_size + align - 1) / align * align;
+  pool->slab_objects = slab_objects;
+  pool->slabs = list_init(INITIAL_SLABS_GUESS, free);
+  pool->free_list = NULL;
+  pool->live = 0;
+  return pool;
+}
+
+void pool_free(pool_t *pool) {
+  for (size_t i = 0; i < list_size(pool->slabs); i++) {
+    ASAN_UNPOISON_MEMORY_REGION(list_get(pool->slabs, i),
+                                pool->object_size * pool->slab_objects);
+  }
+  list_free(pool->slabs);
+  free(pool);
+}
+
+/**
+ * Adds a slab to a pool and puts all its objects on the free list.
+ */
+void pool_grow(pool_t *pool) {
+  char *slab = malloc(pool->object_size * pool->slab_objects);
+  assert(slab != NULL);
+  list_add(pool->slabs, slab);
+  // Push in reverse, so objects are handed out in address order
+  for (size_t i = pool->slab_objects; i > 0; i--) {
+    void *object = slab + (i - 1) * pool->object_size;
+    *(void **)object = pool->free_list;
+    pool->free_list = object;
+  }
+  ASAN_POISON_MEMORY_REGION(slab, pool->object_size * pool->slab_objects);
+}
+
+void *pool_alloc(pool_t *pool) {
+  if (pool->free_list == NULL) {
+    pool_grow(pool);
+  }
+  void *object = pool->free_list;
+  ASAN_UNPOISON_MEMORY_REGION(object, pool->object_size);
+  pool->free_list = *(void **)object;
+  pool->live++;
+  return object;
+}
+
+void pool_release(pool_t *pool, void *object) {
+  assert(object != NULL && pool->live > 0);
+  *(void **)object = pool->free_list;
+  pool->free_list = object;
+  pool->live--;
+  ASAN_POISON_MEMORY_REGION(object, pool->object_size);
+}
+
+size_t pool_live(pool_t *pool) { return pool->live; }
+
+size_t pool_capacity(pool_t *pool) {
+  return list_size(pool->slabs) * pool->slab_objects;
+}
+
+/**
+ * Finds the smallest size class that fits an object,
+ * or NUM_POOL_CLASSES if it is too big for all of them.
+ */
+size_t pool_class(size_t size) {
+  size_t size_class = 0;
+  size_t class_size = POOL_SMALLEST_CLASS;
+  while (size_class < NUM_POOL_CLASSES && class_size < size) {
+    size_class++;
+    class_size *= 2;
+  }
+  return size_class;
+}
+
+void *pool_alloc_sized(size_t size) {
+  size_t size_class = pool_class(size);
+  if (size_class == NUM_POOL_CLASSES) {
+    void *object = malloc(size);
+    assert(object != NULL);
+    return object;
+  }
+  if (class_pools == NULL) {
+    class_pools = malloc(NUM_POOL_CLASSES * sizeof(pool_t *));
+    assert(class_pools != NULL);
+    for (size_t i = 0; i < NUM_POOL_CLASSES; i++) {
+      class_pools[i] = pool_init(POOL_SMALLEST_CLASS << i, POOL_SLAB_OBJECTS);
+    }
+  }
+  return pool_alloc(class_pools[size_class]);
+}
+
+void pool_release_sized(void *object, size_t size) {
+  size_t size_class = pool_class(size);
+  if (size_class == NUM_POOL_CLASSES) {
+    free(object);
+    return;
+  }
+  assert(class_pools != NULL);
+  pool_release(class_pools[size_class], object);
+}
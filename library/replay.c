@@ -0,0 +1,187 @@
+#include "replay.h"
+#include "body.h"
+#include "scene.h"
+#include <assert.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+const size_t INITIAL_REPLAY_GUESS = 1024;
+const char REPLAY_MAGIC[4] = {'R', 'P', 'L', 'Y'};
+
+typedef struct replay {
+  replay_event_t *events;
+  size_t size;
+  size_t capacity;
+  size_t ticks;
+} replay_t;
+
+replay_t *replay_init(void) {
+  replay_t *replay = malloc(sizeof(replay_t));
+  assert(replay != NULL);
+  replay->capacity = INITIAL_REPLAY_GUESS;
+  replay->events = malloc(replay->capacity * sizeof(replay_event_t));
+  assert(replay->events != NULL);
+  replay->size = 0;
+  replay->ticks = 0;
+  return replay;
+}
+
+void replay_free(replay_t *replay) {
+  free(replay->events);
+  free(replay);
+}
+
+void replay_add(replay_t *replay, replay_event_t event) {
+  assert(event.kind == REPLAY_TICK || event.kind == REPLAY_KEY ||
+         event.kind == REPLAY_MOUSE);
+  if (replay->size == replay->capacity) {
+    replay->capacity *= 2;
+    replay->events =
+        realloc(replay->events, replay->capacity * sizeof(replay_event_t));
+    assert(replay->events != NULL);
+  }
+  replay->events[replay->size++] = event;
+  if (event.kind == REPLAY_TICK) {
+    replay->ticks++;
+  }
+}
+
+size_t replay_size(replay_t *replay) { return replay->size; }
+
+size_t replay_ticks(replay_t *replay) { return replay->ticks; }
+
+replay_event_t replay_get(replay_t *replay, size_t index) {
+  assert(index < replay->size);
+  return replay->events[index];
+}
+
+bool replay_write(replay_t *replay, FILE *file) {
+  uint64_t size = replay->size;
+  if (fwrite(REPLAY_MAGIC, sizeof(REPLAY_MAGIC), 1, file) != 1 ||
+      fwrite(&size, sizeof(size), 1, file) != 1) {
+    return false;
+  }
+  for (size_t i = 0; i < replay->size; i++) {
+    replay_event_t *event = &replay->events[i];
+    uint8_t kind = event->kind;
+    bool written = fwrite(&kind, sizeof(kind), 1, file) == 1;
+    if (event->kind == REPLAY_TICK) {
+      written = written && fwrite(&event->dt, sizeof(double), 1, file) == 1;
+    } else if (event->kind == REPLAY_KEY) {
+      uint8_t released = event->released;
+      written = written && fwrite(&event->key, sizeof(char), 1, file) == 1 &&
+                fwrite(&released, sizeof(released), 1, file) == 1 &&
+                fwrite(&event->held_time, sizeof(double), 1, file) == 1;
+    } else {
+      written = written && fwrite(&event->x, sizeof(double), 1, file) == 1 &&
+                fwrite(&event->y, sizeof(double), 1, file) == 1;
+    }
+    if (!written) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Reads one event's kind and fields, or returns false at a bad or short record.
+ */
+bool replay_read_event(FILE *file, replay_event_t *event) {
+  uint8_t kind;
+  if (fread(&kind, sizeof(kind), 1, file) != 1) {
+    return false;
+  }
+  *event = (replay_event_t){.kind = kind};
+  if (kind == REPLAY_TICK) {
+    return fread(&event->dt, sizeof(double), 1, file) == 1;
+  } else if (kind == REPLAY_KEY) {
+    uint8_t released;
+    bool read = fread(&event->key, sizeof(char), 1, file) == 1 &&
+                fread(&released, sizeof(released), 1, file) == 1 &&
+                fread(&event->held_time, sizeof(double), 1, file) == 1;
+    event->released = released;
+    return read;
+  } else if (kind == REPLAY_MOUSE) {
+    return fread(&event->x, sizeof(double), 1, file) == 1 &&
+           fread(&event->y, sizeof(double), 1, file) == 1;
+  }
+  return false;
+}
+
+replay_t *replay_read(FILE *file) {
+  char magic[sizeof(REPLAY_MAGIC)];
+  uint64_t size;
+  if (fread(magic, sizeof(magic), 1, file) != 1 ||
+      memcmp(magic, REPLAY_MAGIC, sizeof(magic)) != 0 ||
+      fread(&size, sizeof(size), 1, file) != 1) {
+    return NULL;
+  }
+  replay_t *replay = replay_init();
+  for (uint64_t i = 0; i < size; i++) {
+    replay_event_t event;
+    if (!replay_read_event(file, &event)) {
+      replay_free(replay);
+      return NULL;
+    }
+    replay_add(replay, event);
+  }
+  return replay;
+}
+
+void replay_write_hashes(FILE *file, size_t tick, scene_t *scene) {
+  size_t num_bodies = scene_bodies(scene);
+  fprintf(file, "%zu %016" PRIx64 " %zu %d %d %zu", tick, scene_hash(scene),
+          scene_counter(scene), scene_get_win(scene), scene_get_lose(scene),
+          num_bodies);
+  for (size_t i = 0; i < num_bodies; i++) {
+    fprintf(file, " %016" PRIx64, body_hash(scene_get_body(scene, i)));
+  }
+  fputc('\n', file);
+}
+
+trace_diff_t replay_check_hashes(FILE *reference, size_t tick,
+                                 scene_t *scene, size_t *body) {
+  size_t num_bodies = scene_bodies(scene);
+  size_t expected_tick;
+  uint64_t expected_scene;
+  size_t expected_counter;
+  int expected_win;
+  int expected_lose;
+  size_t expected_bodies;
+  if (fscanf(reference, "%zu %" SCNx64 " %zu %d %d %zu", &expected_tick,
+             &expected_scene, &expected_counter, &expected_win,
+             &expected_lose, &expected_bodies) != 6 ||
+      expected_tick != tick) {
+    return TRACE_MISSING;
+  }
+  // Read the whole line, even past a difference, to stay in step
+  trace_diff_t diff =
+      expected_bodies == num_bodies ? TRACE_MATCH : TRACE_MISSING;
+  for (size_t i = 0; i < expected_bodies; i++) {
+    uint64_t expected_body;
+    if (fscanf(reference, " %" SCNx64, &expected_body) != 1) {
+      return TRACE_MISSING;
+    }
+    if (diff == TRACE_MATCH &&
+        expected_body != body_hash(scene_get_body(scene, i))) {
+      diff = TRACE_BODY;
+      *body = i;
+    }
+  }
+  if (diff != TRACE_MATCH) {
+    return diff;
+  }
+  if (expected_counter != scene_counter(scene)) {
+    return TRACE_COUNTER;
+  }
+  if ((bool)expected_win != scene_get_win(scene)) {
+    return TRACE_WIN;
+  }
+  if ((bool)expected_lose != scene_get_lose(scene)) {
+    return TRACE_LOSE;
+  }
+  return expected_scene == scene_hash(scene) ? TRACE_MATCH
+                                             : TRACE_OTHER_BODIES;
+}
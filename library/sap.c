@@ -0,0 +1,326 @@
+#include "sap.h"
+#include "body.h"
+#include "collision.h"
+#include "list.h"
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+const size_t INITIAL_PROXIES_GUESS = 16;
+
+/**
+ * One end of a tracked body's x extent.
+ */
+typedef struct endpoint {
+  double value;
+  size_t proxy;
+  bool is_max;
+} endpoint_t;
+
+typedef struct proxy {
+  body_t *body;
+  aabb_t bounds;
+  bool is_static;
+} proxy_t;
+
+/**
+ * The overlapping pairs are stored in compressed form: the static bodies
+ * overlapping proxy p are pair_entries[pair_starts[p]] up to (but excluding)
+ * pair_entries[pair_starts[p + 1]].
+ */
+typedef struct sap {
+  size_t num_proxies;
+  size_t capacity;
+  proxy_t *proxies;
+  // 2 * num_proxies endpoints, sorted by value
+  endpoint_t *endpoints;
+  // Proxy indices sorted by body address, for looking bodies up
+  size_t *lookup;
+  size_t *active;
+  size_t *pair_starts;
+  size_t *pair_entries;
+  size_t pair_capacity;
+  // Whether bodies were added or removed since the last update
+  bool dirty;
+} sap_t;
+
+sap_t *sap_init(void) {
+  sap_t *sap = malloc(sizeof(sap_t));
+  assert(sap != NULL);
+  sap->num_proxies = 0;
+  sap->capacity = INITIAL_PROXIES_GUESS;
+  sap->proxies = malloc(sap->capacity * sizeof(proxy_t));
+  sap->endpoints = malloc(2 * sap->capacity * sizeof(endpoint_t));
+  sap->lookup = malloc(sap->capacity * sizeof(size_t));
+  sap->active = malloc(sap->capacity * sizeof(size_t));
+  sap->pair_starts = calloc(sap->capacity + 1, sizeof(size_t));
+  sap->pair_capacity = INITIAL_PROXIES_GUESS;
+  sap->pair_entries = malloc(sap->pair_capacity * sizeof(size_t));
+  assert(sap->proxies != NULL && sap->endpoints != NULL &&
+         sap->lookup != NULL && sap->active != NULL &&
+         sap->pair_starts != NULL && sap->pair_entries != NULL);
+  sap->dirty = false;
+  return sap;
+}
+
+void sap_free(sap_t *sap) {
+  free(sap->proxies);
+  free(sap->endpoints);
+  free(sap->lookup);
+  free(sap->active);
+  free(sap->pair_starts);
+  free(sap->pair_entries);
+  free(sap);
+}
+
+void sap_grow(sap_t *sap) {
+  sap->capacity *= 2;
+  sap->proxies = realloc(sap->proxies, sap->capacity * sizeof(proxy_t));
+  sap->endpoints =
+      realloc(sap->endpoints, 2 * sap->capacity * sizeof(endpoint_t));
+  sap->lookup = realloc(sap->lookup, sap->capacity * sizeof(size_t));
+  sap->active = realloc(sap->active, sap->capacity * sizeof(size_t));
+  sap->pair_starts =
+      realloc(sap->pair_starts, (sap->capacity + 1) * sizeof(size_t));
+  assert(sap->proxies != NULL && sap->endpoints != NULL &&
+         sap->lookup != NULL && sap->active != NULL &&
+         sap->pair_starts != NULL);
+}
+
+/**
+ * Returns the address of a proxy's body, which the lookup table is sorted by.
+ */
+uintptr_t sap_key(sap_t *sap, size_t proxy) {
+  return (uintptr_t)sap->proxies[proxy].body;
+}
+
+/**
+ * Re-sorts the lookup table by body address with insertion sort.
+ * Bodies are added one at a time, so the table is nearly sorted.
+ */
+void sap_sort_lookup(sap_t *sap) {
+  for (size_t i = 1; i < sap->num_proxies; i++) {
+    size_t proxy = sap->lookup[i];
+    uintptr_t key = sap_key(sap, proxy);
+    size_t j = i;
+    while (j > 0 && sap_key(sap, sap->lookup[j - 1]) > key) {
+      sap->lookup[j] = sap->lookup[j - 1];
+      j--;
+    }
+    sap->lookup[j] = proxy;
+  }
+}
+
+/**
+ * Finds the position of a body in the lookup table with a binary search.
+ * Returns num_proxies if the body is not tracked.
+ */
+size_t sap_find_lookup(sap_t *sap, body_t *body) {
+  uintptr_t key = (uintptr_t)body;
+  size_t low = 0;
+  size_t high = sap->num_proxies;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    uintptr_t mid_key = sap_key(sap, sap->lookup[mid]);
+    if (mid_key == key) {
+      return mid;
+    }
+    if (mid_key < key) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return sap->num_proxies;
+}
+
+/**
+ * Finds the proxy index of a body.
+ * Returns num_proxies if the body is not tracked.
+ */
+size_t sap_find(sap_t *sap, body_t *body) {
+  size_t position = sap_find_lookup(sap, body);
+  return position < sap->num_proxies ? sap->lookup[position]
+                                     : sap->num_proxies;
+}
+
+void sap_add(sap_t *sap, body_t *body, bool is_static) {
+  if (sap->num_proxies == sap->capacity) {
+    sap_grow(sap);
+  }
+  size_t proxy = sap->num_proxies;
+  aabb_t bounds = find_bounds(body_borrow_shape(body));
+  sap->proxies[proxy] =
+      (proxy_t){.body = body, .bounds = bounds, .is_static = is_static};
+  // The endpoints are appended out of order and sorted by the next update
+  sap->endpoints[2 * proxy] =
+      (endpoint_t){.value = bounds.min.x, .proxy = proxy, .is_max = false};
+  sap->endpoints[2 * proxy + 1] =
+      (endpoint_t){.value = bounds.max.x, .proxy = proxy, .is_max = true};
+  sap->lookup[proxy] = proxy;
+  sap->num_proxies++;
+  sap_sort_lookup(sap);
+  sap->dirty = true;
+}
+
+void sap_remove(sap_t *sap, body_t *body) {
+  size_t position = sap_find_lookup(sap, body);
+  assert(position < sap->num_proxies);
+  size_t proxy = sap->lookup[position];
+  // Move the last proxy into the freed slot
+  size_t last = sap->num_proxies - 1;
+  sap->proxies[proxy] = sap->proxies[last];
+  size_t kept = 0;
+  for (size_t i = 0; i < 2 * sap->num_proxies; i++) {
+    endpoint_t endpoint = sap->endpoints[i];
+    if (endpoint.proxy == proxy) {
+      continue;
+    }
+    if (endpoint.proxy == last) {
+      endpoint.proxy = proxy;
+    }
+    sap->endpoints[kept++] = endpoint;
+  }
+  // Drop the body's lookup entry and rename the moved proxy in place,
+  // which keeps the table sorted since the moved body's address is unchanged
+  memmove(&sap->lookup[position], &sap->lookup[position + 1],
+          (last - position) * sizeof(size_t));
+  sap->num_proxies--;
+  if (proxy != last) {
+    sap->lookup[sap_find_lookup(sap, sap->proxies[proxy].body)] = proxy;
+  }
+  sap->dirty = true;
+}
+
+/**
+ * Returns whether endpoint a belongs before endpoint b.
+ * Minimums go before maximums at the same value, so touching boxes overlap.
+ */
+bool endpoint_before(endpoint_t a, endpoint_t b) {
+  return a.value < b.value || (a.value == b.value && !a.is_max && b.is_max);
+}
+
+void sap_sort_endpoints(sap_t *sap) {
+  size_t n = 2 * sap->num_proxies;
+  for (size_t i = 1; i < n; i++) {
+    endpoint_t endpoint = sap->endpoints[i];
+    size_t j = i;
+    while (j > 0 && endpoint_before(endpoint, sap->endpoints[j - 1])) {
+      sap->endpoints[j] = sap->endpoints[j - 1];
+      j--;
+    }
+    sap->endpoints[j] = endpoint;
+  }
+}
+
+/**
+ * Sweeps the sorted endpoints to find every overlapping pair of one moving
+ * and one static body. When counting is true, the pairs are only tallied in
+ * pair_starts; otherwise they are stored at the given fill cursors.
+ */
+void sap_sweep(sap_t *sap, bool counting, size_t *fill) {
+  size_t num_active = 0;
+  for (size_t i = 0; i < 2 * sap->num_proxies; i++) {
+    endpoint_t endpoint = sap->endpoints[i];
+    if (endpoint.is_max) {
+      for (size_t a = 0; a < num_active; a++) {
+        if (sap->active[a] == endpoint.proxy) {
+          sap->active[a] = sap->active[--num_active];
+          break;
+        }
+      }
+      continue;
+    }
+    proxy_t *entering = &sap->proxies[endpoint.proxy];
+    for (size_t a = 0; a < num_active; a++) {
+      proxy_t *other = &sap->proxies[sap->active[a]];
+      if (entering->is_static == other->is_static ||
+          !aabb_overlap(entering->bounds, other->bounds)) {
+        continue;
+      }
+      size_t moving = entering->is_static ? sap->active[a] : endpoint.proxy;
+      size_t fixed = entering->is_static ? endpoint.proxy : sap->active[a];
+      if (counting) {
+        sap->pair_starts[moving + 1]++;
+      } else {
+        sap->pair_entries[fill[moving]++] = fixed;
+      }
+    }
+    sap->active[num_active++] = endpoint.proxy;
+  }
+}
+
+void sap_update(sap_t *sap) {
+  for (size_t i = 0; i < sap->num_proxies; i++) {
+    proxy_t *proxy = &sap->proxies[i];
+    if (!proxy->is_static) {
+      proxy->bounds = find_bounds(body_borrow_shape(proxy->body));
+    }
+  }
+  for (size_t i = 0; i < 2 * sap->num_proxies; i++) {
+    endpoint_t *endpoint = &sap->endpoints[i];
+    aabb_t bounds = sap->proxies[endpoint->proxy].bounds;
+    endpoint->value = endpoint->is_max ? bounds.max.x : bounds.min.x;
+  }
+  sap_sort_endpoints(sap);
+
+  // Count the pairs of each moving body, then turn the counts into offsets
+  for (size_t i = 0; i <= sap->num_proxies; i++) {
+    sap->pair_starts[i] = 0;
+  }
+  sap_sweep(sap, true, NULL);
+  for (size_t i = 0; i < sap->num_proxies; i++) {
+    sap->pair_starts[i + 1] += sap->pair_starts[i];
+  }
+  size_t num_pairs = sap->pair_starts[sap->num_proxies];
+  if (num_pairs > sap->pair_capacity) {
+    while (num_pairs > sap->pair_capacity) {
+      sap->pair_capacity *= 2;
+    }
+    sap->pair_entries =
+        realloc(sap->pair_entries, sap->pair_capacity * sizeof(size_t));
+    assert(sap->pair_entries != NULL);
+  }
+  size_t *fill = malloc((sap->num_proxies + 1) * sizeof(size_t));
+  assert(fill != NULL);
+  for (size_t i = 0; i < sap->num_proxies; i++) {
+    fill[i] = sap->pair_starts[i];
+  }
+  sap_sweep(sap, false, fill);
+  free(fill);
+  sap->dirty = false;
+}
+
+bool sap_query_body(sap_t *sap, body_t *body, list_t *results) {
+  if (sap->dirty) {
+    sap_update(sap);
+  }
+  size_t proxy = sap_find(sap, body);
+  if (proxy == sap->num_proxies) {
+    return false;
+  }
+  for (size_t e = sap->pair_starts[proxy]; e < sap->pair_starts[proxy + 1];
+       e++) {
+    list_add(results, sap->proxies[sap->pair_entries[e]].body);
+  }
+  return true;
+}
+
+void sap_query(sap_t *sap, aabb_t box, list_t *results) {
+  if (sap->dirty) {
+    sap_update(sap);
+  }
+  // Only bodies starting before the box ends can overlap it
+  for (size_t i = 0; i < 2 * sap->num_proxies; i++) {
+    endpoint_t endpoint = sap->endpoints[i];
+    if (endpoint.value > box.max.x) {
+      break;
+    }
+    proxy_t *proxy = &sap->proxies[endpoint.proxy];
+    if (!endpoint.is_max && proxy->is_static &&
+        aabb_overlap(box, proxy->bounds)) {
+      list_add(results, proxy->body);
+    }
+  }
+}
@@ -1,68 +1,231 @@
 #include "scene.h"
+#include "aabb_tree.h"
 #include "body.h"
 #include "color.h"
+#include "contact_cache.h"
 #include "force.h"
+#include "force_batch.h"
+#include "grid.h"
 #include "info.h"
+#include "islands.h"
 #include "polygon.h"
+#include "sap.h"
+#include "solver.h"
 #include "vector.h"
 #include <assert.h>
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 const size_t INITIAL_BODIES_GUESS = 15;
 const size_t INITIAL_FORCES_GUESS = 30;
-const size_t GRAV = 3; // last 3 spots reserved for gravity
-const size_t FAN = 4; // 4 spots reserved for fan (before gravity)
+const double STATIC_CELL_SIZE = 100.0;
+// How far bodies can move before their leaf in the tree is reinserted
+const double TREE_MARGIN = 5.0;
+const size_t SOLVER_ITERATIONS = 8;
+// Bodies moving further than this fraction of their smallest extent in one
+// tick are swept against the static bodies
+const double SWEEP_EXTENT_FRACTION = 0.5;
+// With substepping, how far a body may move per substep as a fraction of its
+// smallest extent, and how far (in radians) the stiffest spring may turn
+const double SUBSTEP_MAX_TRAVEL = 0.25;
+const double SUBSTEP_MAX_PHASE = 0.2;
+// As many fields as there are bits in a body's field mask
+const size_t MAX_FIELDS = 32;
+const size_t MAX_PLAYERS = 4;
+const size_t NUM_FORCE_PHASES = FORCE_PHASE_CONTACT + 1;
+// Marks the start of a buffer written by scene_snapshot()
+const uint32_t SNAPSHOT_MAGIC = 0x5343534e;
+const size_t INITIAL_SLOTS_GUESS = 32;
+// Ends the chain of free handle slots
+const size_t NO_FREE_SLOT = SIZE_MAX;
 
-const size_t PLY1 = 1;
-const size_t PLY2 = 2;
-const size_t BLOCK_BODY = 3;
+/**
+ * The body a handle with a matching generation refers to.
+ * Free slots have no body and are chained through next_free.
+ */
+typedef struct body_slot {
+  body_t *body;
+  uint32_t generation;
+  size_t next_free;
+} body_slot_t;
+
+/**
+ * A body in the scene a clone was made from, and the clone's copy of it.
+ */
+typedef struct clone_pair {
+  body_t *original;
+  body_t *copy;
+} clone_pair_t;
+
+/**
+ * The start of a snapshot. It is followed by each moving body's handle and
+ * state, the force fields, the handles of the hidden and then the static
+ * bodies, and then whether each force creator is enabled.
+ */
+typedef struct snapshot_header {
+  uint32_t magic;
+  size_t num_bodies;
+  size_t num_hidden;
+  size_t num_static;
+  size_t num_fields;
+  size_t num_forces;
+  size_t num_batched;
+  size_t counter;
+  bool win;
+  bool lose;
+  // A copy of the scene (see scene_clone()) to put back the force creators'
+  // auxiliary values and any removed bodies from, or NULL if the scene
+  // could not be copied
+  scene_t *copy;
+} snapshot_header_t;
+
+/**
+ * A moving body in a snapshot: which body it is, and its state.
+ */
+typedef struct snapshot_body {
+  body_handle_t handle;
+  body_state_t state;
+} snapshot_body_t;
 
 typedef struct scene {
   list_t *bodies;
   list_t *hidden_bodies;
-  list_t *force;
+  list_t *static_bodies;
+  grid_t *static_grid;
+  bool static_dirty;
+  broadphase_t broadphase;
+  sap_t *static_sap;
+  aabb_tree_t *body_tree;
+  aabb_tree_t *static_tree;
+  contact_cache_t *contacts;
+  solver_t *solver;
+  islands_t *islands;
+  size_t max_substeps;
+  // The largest spring constant per unit mass registered, in 1 / s^2
+  double max_stiffness;
+  // The force creators to run in each phase, indexed by force_phase_t
+  list_t **forces;
+  force_batch_t *batched;
+  force_field_t *fields;
+  size_t num_fields;
+  // The bodies whose win and lose flags decide the scene's
+  body_handle_t *players;
+  size_t num_players;
+  // For clones, the copy of each body of the original scene, sorted by the
+  // original's address
+  clone_pair_t *clone_map;
+  size_t clone_map_size;
+  // Handle slots for every body (see body_handle_t)
+  body_slot_t *slots;
+  size_t num_slots;
+  size_t slots_capacity;
+  size_t free_slot;
+  // The physics state of the bodies in bodies, integrated together
+  body_store_t *store;
   size_t num_bodies;
   size_t counter;
   bool win;
   bool lose;
+  scene_stats_t stats;
 } scene_t;
 
 /**
- * Allocates memory for an empty scene.
- * Makes a reasonable guess of the number of bodies to allocate space for.
- * Asserts that the required memory is successfully allocated.
- *
- * @return the new scene
+ * Fills in an empty scene's fields, e.g. for scene_init().
  */
-scene_t *scene_init(void) {
-  scene_t *s = malloc(sizeof(scene_t));
-  assert(s != NULL);
+void scene_setup(scene_t *s) {
   list_t *scene_bodies =
       list_init(INITIAL_BODIES_GUESS, (free_func_t)body_free);
   list_t *hidden_bodies =
       list_init(INITIAL_BODIES_GUESS, (free_func_t)body_free);
-  list_t *scene_forces =
-      list_init(INITIAL_FORCES_GUESS, (free_func_t)force_free);
   s->bodies = scene_bodies;
   s->hidden_bodies = hidden_bodies;
-  s->force = scene_forces;
+  s->static_bodies = list_init(INITIAL_BODIES_GUESS, (free_func_t)body_free);
+  s->static_grid = grid_init(STATIC_CELL_SIZE);
+  s->static_dirty = false;
+  s->broadphase = BROADPHASE_GRID;
+  s->static_sap = NULL;
+  s->body_tree = aabb_tree_init(TREE_MARGIN);
+  s->static_tree = aabb_tree_init(TREE_MARGIN);
+  s->contacts = contact_cache_init();
+  s->solver = solver_init(SOLVER_ITERATIONS, s->contacts);
+  s->islands = islands_init();
+  s->max_substeps = 1;
+  s->max_stiffness = 0;
+  s->forces = malloc(NUM_FORCE_PHASES * sizeof(list_t *));
+  assert(s->forces != NULL);
+  for (size_t i = 0; i < NUM_FORCE_PHASES; i++) {
+    s->forces[i] = list_init(INITIAL_FORCES_GUESS, (free_func_t)force_free);
+  }
+  s->batched = force_batch_init();
+  s->fields = malloc(MAX_FIELDS * sizeof(force_field_t));
+  assert(s->fields != NULL);
+  s->num_fields = 0;
+  s->players = malloc(MAX_PLAYERS * sizeof(body_handle_t));
+  assert(s->players != NULL);
+  s->num_players = 0;
+  s->clone_map = NULL;
+  s->clone_map_size = 0;
+  s->slots_capacity = INITIAL_SLOTS_GUESS;
+  s->slots = malloc(s->slots_capacity * sizeof(body_slot_t));
+  assert(s->slots != NULL);
+  s->num_slots = 0;
+  s->free_slot = NO_FREE_SLOT;
+  s->store = body_store_init(INITIAL_BODIES_GUESS);
   s->num_bodies = 0;
   s->lose = false;
   s->win = false;
   s->counter = 0;
+  s->stats = (scene_stats_t){0};
+}
+
+/**
+ * Allocates memory for an empty scene.
+ * Makes a reasonable guess of the number of bodies to allocate space for.
+ * Asserts that the required memory is successfully allocated.
+ *
+ * @return the new scene
+ */
+scene_t *scene_init(void) {
+  scene_t *s = malloc(sizeof(scene_t));
+  assert(s != NULL);
+  scene_setup(s);
   return s;
 }
 
+/**
+ * Releases everything a scene holds, but not the scene itself, so it can be
+ * set up again with scene_setup().
+ */
+void scene_teardown(scene_t *scene) {
+  list_free(scene->bodies);
+  list_free(scene->hidden_bodies);
+  list_free(scene->static_bodies);
+  body_store_free(scene->store);
+  grid_free(scene->static_grid);
+  if (scene->static_sap != NULL) {
+    sap_free(scene->static_sap);
+  }
+  aabb_tree_free(scene->body_tree);
+  aabb_tree_free(scene->static_tree);
+  solver_free(scene->solver);
+  contact_cache_free(scene->contacts);
+  islands_free(scene->islands);
+  scene_free_forces(scene);
+  force_batch_free(scene->batched);
+  free(scene->fields);
+  free(scene->players);
+  free(scene->clone_map);
+  free(scene->slots);
+}
+
 /**
  * Releases memory allocated for a given scene and all its bodies.
  *
  * @param scene a pointer to a scene returned from scene_init()
  */
 void scene_free(scene_t *scene) {
-  list_free(scene->bodies);
-  list_free(scene->hidden_bodies);
-  scene_free_forces(scene);
+  scene_teardown(scene);
   free(scene);
 }
 
@@ -75,13 +238,255 @@ body_t *scene_get_body(scene_t *scene, size_t index) {
   return (body_t *)list_get(scene->bodies, index);
 }
 
-void scene_add_body(scene_t *scene, body_t *body) {
+/**
+ * Gives a body a handle slot, reusing a freed one if there is one.
+ */
+body_handle_t scene_acquire_slot(scene_t *scene, body_t *body) {
+  size_t index = scene->free_slot;
+  if (index != NO_FREE_SLOT) {
+    scene->free_slot = scene->slots[index].next_free;
+  } else {
+    if (scene->num_slots == scene->slots_capacity) {
+      scene->slots_capacity *= 2;
+      scene->slots = realloc(scene->slots,
+                             scene->slots_capacity * sizeof(body_slot_t));
+      assert(scene->slots != NULL);
+    }
+    index = scene->num_slots++;
+    assert(index < UINT32_MAX);
+    // Generation 0 is never used, so zeroed handles never resolve
+    scene->slots[index].generation = 1;
+  }
+  scene->slots[index].body = body;
+  body_set_slot(body, index);
+  return (body_handle_t){.index = index,
+                         .generation = scene->slots[index].generation};
+}
+
+/**
+ * Frees a body's handle slot before the body is freed, so that its handles
+ * stop resolving.
+ */
+void scene_release_slot(scene_t *scene, body_t *body) {
+  body_slot_t *slot = &scene->slots[body_get_slot(body)];
+  slot->body = NULL;
+  slot->generation++;
+  if (slot->generation == 0) {
+    slot->generation = 1;
+  }
+  slot->next_free = scene->free_slot;
+  scene->free_slot = body_get_slot(body);
+}
+
+body_handle_t scene_get_handle(scene_t *scene, body_t *body) {
+  size_t index = body_get_slot(body);
+  assert(index < scene->num_slots && scene->slots[index].body == body);
+  return (body_handle_t){.index = index,
+                         .generation = scene->slots[index].generation};
+}
+
+body_t *scene_resolve(scene_t *scene, body_handle_t handle) {
+  if (handle.index >= scene->num_slots ||
+      scene->slots[handle.index].generation != handle.generation) {
+    return NULL;
+  }
+  return scene->slots[handle.index].body;
+}
+
+body_handle_t scene_add_body(scene_t *scene, body_t *body) {
   list_add(scene->bodies, body);
+  body_store_add(scene->store, body);
   scene->num_bodies++;
+  body_set_proxy(body, aabb_tree_insert(scene->body_tree, body,
+                                        find_bounds(body_borrow_shape(body))));
+  if (scene->static_sap != NULL) {
+    sap_add(scene->static_sap, body, false);
+  }
+  return scene_acquire_slot(scene, body);
+}
+
+void scene_add_bodies_n(scene_t *scene, body_t **bodies, size_t num_bodies,
+                        body_handle_t *handles) {
+  scene_reserve_bodies(scene, num_bodies);
+  for (size_t i = 0; i < num_bodies; i++) {
+    body_handle_t handle = scene_add_body(scene, bodies[i]);
+    if (handles != NULL) {
+      handles[i] = handle;
+    }
+  }
 }
 
-void scene_add_hidden_body(scene_t *scene, body_t *body) {
+void scene_reserve_bodies(scene_t *scene, size_t num_bodies) {
+  list_reserve(scene->bodies, scene->num_bodies + num_bodies);
+  body_store_reserve(scene->store, body_store_size(scene->store) + num_bodies);
+  size_t slots = scene->num_slots + num_bodies;
+  if (slots > scene->slots_capacity) {
+    scene->slots_capacity = slots;
+    scene->slots =
+        realloc(scene->slots, scene->slots_capacity * sizeof(body_slot_t));
+    assert(scene->slots != NULL);
+  }
+}
+
+void scene_reserve_forces(scene_t *scene, force_phase_t phase,
+                          size_t num_forces) {
+  assert((size_t)phase < NUM_FORCE_PHASES);
+  list_t *forces = scene->forces[phase];
+  list_reserve(forces, list_size(forces) + num_forces);
+}
+
+body_handle_t scene_add_hidden_body(scene_t *scene, body_t *body) {
   list_add(scene->hidden_bodies, body);
+  return scene_acquire_slot(scene, body);
+}
+
+body_handle_t scene_add_static_body(scene_t *scene, body_t *body) {
+  assert(body_get_mass(body) == INFINITY);
+  list_add(scene->static_bodies, body);
+  scene->static_dirty = true;
+  body_set_proxy(body, aabb_tree_insert(scene->static_tree, body,
+                                        find_bounds(body_borrow_shape(body))));
+  if (scene->static_sap != NULL) {
+    sap_add(scene->static_sap, body, true);
+  }
+  return scene_acquire_slot(scene, body);
+}
+
+size_t scene_static_bodies(scene_t *scene) {
+  return list_size(scene->static_bodies);
+}
+
+/**
+ * Adds the bodies found in a tree whose actual bounds overlap a box;
+ * the tree only knows their fat boxes.
+ */
+void scene_query_tree(aabb_tree_t *tree, aabb_t box, list_t *results) {
+  list_t *candidates = list_init(INITIAL_BODIES_GUESS, NULL);
+  aabb_tree_query(tree, box, candidates);
+  for (size_t i = 0; i < list_size(candidates); i++) {
+    body_t *body = list_get(candidates, i);
+    if (aabb_overlap(box, find_bounds(body_borrow_shape(body)))) {
+      list_add(results, body);
+    }
+  }
+  list_free(candidates);
+}
+
+void scene_set_broadphase(scene_t *scene, broadphase_t broadphase) {
+  if (broadphase == scene->broadphase) {
+    return;
+  }
+  scene->broadphase = broadphase;
+  if (scene->static_sap != NULL) {
+    sap_free(scene->static_sap);
+    scene->static_sap = NULL;
+  }
+  if (broadphase == BROADPHASE_SAP) {
+    scene->static_sap = sap_init();
+    for (size_t i = 0; i < scene->num_bodies; i++) {
+      sap_add(scene->static_sap, scene_get_body(scene, i), false);
+    }
+    for (size_t i = 0; i < list_size(scene->static_bodies); i++) {
+      sap_add(scene->static_sap, list_get(scene->static_bodies, i), true);
+    }
+  }
+}
+
+void scene_query_aabb(scene_t *scene, aabb_t box, list_t *results) {
+  scene_query_tree(scene->body_tree, box, results);
+  scene_query_tree(scene->static_tree, box, results);
+}
+
+void scene_query_point(scene_t *scene, vector_t point, list_t *results) {
+  list_t *candidates = list_init(INITIAL_BODIES_GUESS, NULL);
+  aabb_t box = {.min = point, .max = point};
+  aabb_tree_query(scene->body_tree, box, candidates);
+  aabb_tree_query(scene->static_tree, box, candidates);
+  for (size_t i = 0; i < list_size(candidates); i++) {
+    body_t *body = list_get(candidates, i);
+    if (polygon_contains(body_borrow_shape(body), point)) {
+      list_add(results, body);
+    }
+  }
+  list_free(candidates);
+}
+
+raycast_hit_t scene_raycast(scene_t *scene, vector_t start, vector_t direction,
+                            double max_distance) {
+  list_t *candidates = list_init(INITIAL_BODIES_GUESS, NULL);
+  vector_t end = vec_add(start, vec_multiply(max_distance, direction));
+  aabb_tree_raycast(scene->body_tree, start, end, candidates);
+  aabb_tree_raycast(scene->static_tree, start, end, candidates);
+  raycast_hit_t nearest = {.hit = false, .body = NULL,
+                           .distance = max_distance};
+  for (size_t i = 0; i < list_size(candidates); i++) {
+    body_t *body = list_get(candidates, i);
+    double distance =
+        polygon_raycast(body_borrow_shape(body), start, direction);
+    if (distance <= nearest.distance) {
+      nearest = (raycast_hit_t){.hit = true, .body = body,
+                                .distance = distance};
+    }
+  }
+  list_free(candidates);
+  if (nearest.hit) {
+    nearest.point = vec_add(start, vec_multiply(nearest.distance, direction));
+  }
+  return nearest;
+}
+
+void scene_query_static(scene_t *scene, aabb_t box, list_t *results) {
+  if (scene->broadphase == BROADPHASE_TREE) {
+    scene_query_tree(scene->static_tree, box, results);
+    return;
+  }
+  if (scene->static_sap != NULL) {
+    sap_query(scene->static_sap, box, results);
+    return;
+  }
+  if (scene->static_dirty) {
+    grid_build(scene->static_grid, scene->static_bodies);
+    scene->static_dirty = false;
+  }
+  grid_query(scene->static_grid, box, results);
+}
+
+void scene_query_static_near(scene_t *scene, body_t *body, list_t *results) {
+  if (scene->static_sap != NULL &&
+      sap_query_body(scene->static_sap, body, results)) {
+    return;
+  }
+  scene_query_static(scene, find_bounds(body_borrow_shape(body)), results);
+}
+
+void scene_add_contact(scene_t *scene, body_t *body1, body_t *body2,
+                       vector_t normal, double depth) {
+  // A body landing on a sleeping one wakes it, but a body that keeps resting
+  // on it does not: the solver holds sleeping bodies still, so a stack can
+  // fall asleep one body at a time
+  if (contact_cache_event(scene->contacts, body1, body2) != CONTACT_STAY) {
+    if (body_get_mass(body1) != INFINITY) {
+      body_wake(body1);
+    }
+    if (body_get_mass(body2) != INFINITY) {
+      body_wake(body2);
+    }
+  }
+  islands_connect(scene->islands, body1, body2);
+  solver_add_contact(scene->solver, body1, body2, normal, depth);
+}
+
+void scene_set_solver_iterations(scene_t *scene, size_t iterations) {
+  solver_set_iterations(scene->solver, iterations);
+}
+
+double scene_get_contact_impulse(scene_t *scene, body_t *body1,
+                                 body_t *body2) {
+  return contact_cache_get_impulse(scene->contacts, body1, body2);
+}
+
+contact_result_t scene_collide(scene_t *scene, body_t *body1, body_t *body2) {
+  return contact_cache_collide(scene->contacts, body1, body2);
 }
 
 void scene_remove_body(scene_t *scene, size_t index) {
@@ -90,34 +495,226 @@ void scene_remove_body(scene_t *scene, size_t index) {
 }
 
 /**
- * Executes a tick of a given scene over a small time interval.
- * This requires executing all the force creators
- * and then ticking each body (see body_tick()).
- *
- * @param scene a pointer to a scene returned from scene_init()
- * @param dt the time elapsed since the last tick, in seconds
+ * Returns whether a force can be skipped this tick because none of the
+ * bodies it acts on can move: each is either asleep or has infinite mass.
+ * Forces without any relevant bodies always run.
  */
-void scene_tick(scene_t *scene, double dt) {
-  if (scene->num_bodies > BLOCK_BODY && (body_get_lose(scene_get_body(scene, PLY1)) || body_get_lose(scene_get_body(scene, PLY2)))) {
-    scene->lose = true;
+bool force_is_idle(force_t *force) {
+  body_array_t *bodies = get_relevant_bodies(force);
+  if (bodies == NULL || body_array_size(bodies) == 0) {
+    return false;
+  }
+  for (body_t **body = body_array_begin(bodies);
+       body != body_array_end(bodies); body++) {
+    if (!body_is_asleep(*body) && body_get_mass(*body) != INFINITY) {
+      return false;
+    }
   }
-  if (scene->num_bodies > BLOCK_BODY && (body_get_win(scene_get_body(scene, PLY1)) || body_get_win(scene_get_body(scene, PLY2)))) {
-    scene->win = true;
+  return true;
+}
+
+void scene_apply_force(scene_t *scene, force_t *force) {
+  if (!force_is_enabled(force)) {
+    return;
+  }
+  if (force_is_idle(force)) {
+    scene->stats.forces_skipped++;
+    return;
+  }
+  get_force_creator(force)(get_aux(force));
+  scene->stats.forces_run++;
+}
+
+/**
+ * Applies every batched force of one kind.
+ */
+void scene_apply_batch(scene_t *scene, force_kind_t kind) {
+  scene->stats.forces_run += force_batch_apply(
+      scene->batched, kind, scene, &scene->stats.forces_skipped);
+}
+
+/**
+ * Applies every force field to the bodies it acts on, adding up the fields'
+ * forces on each body so it is only pushed once.
+ */
+void scene_apply_fields(scene_t *scene) {
+  if (scene->num_fields == 0) {
+    return;
+  }
+  for (size_t i = 0; i < scene->num_bodies; i++) {
+    body_t *body = scene_get_body(scene, i);
+    double mass = body_get_mass(body);
+    uint32_t mask = body_get_field_mask(body);
+    if (body_is_asleep(body) || mass == INFINITY || mask == 0) {
+      continue;
+    }
+    vector_t velocity = body_get_velocity(body);
+    aabb_t bounds;
+    bool have_bounds = false;
+    vector_t total = VEC_ZERO;
+    bool felt = false;
+    for (size_t j = 0; j < scene->num_fields; j++) {
+      force_field_t *field = &scene->fields[j];
+      if (!(mask & (1u << j))) {
+        continue;
+      }
+      if (field->bounded) {
+        if (!have_bounds) {
+          bounds = find_bounds(body_borrow_shape(body));
+          have_bounds = true;
+        }
+        if (!aabb_overlap(bounds, field->region)) {
+          continue;
+        }
+      }
+      vector_t force = field->kind == FIELD_UNIFORM
+                           ? field->force
+                           : vec_multiply(-field->drag, velocity);
+      if (field->mass_scaled) {
+        force = vec_multiply(mass, force);
+      }
+      total = vec_add(total, force);
+      felt = true;
+    }
+    if (felt) {
+      body_add_force(body, total);
+    }
   }
-  size_t end = list_size(scene->force);
-  if (scene->num_bodies > BLOCK_BODY && (body_get_fan(scene_get_body(scene, PLY1)) || body_get_fan(scene_get_body(scene, PLY2)) || body_get_fan(scene_get_body(scene, BLOCK_BODY)))) {
-    end -= FAN + GRAV;
+}
+
+/**
+ * Returns whether a force creator was registered with a body.
+ */
+bool scene_force_acts_on(force_t *force, body_t *body) {
+  body_array_t *bodies = get_relevant_bodies(force);
+  if (bodies == NULL) {
+    return false;
+  }
+  for (body_t **other = body_array_begin(bodies);
+       other != body_array_end(bodies); other++) {
+    if (*other == body) {
+      return true;
+    }
   }
+  return false;
+}
 
-  for (int i = end + FAN; i < list_size(scene->force); i++) {
-    get_force_creator((force_t *)list_get(scene->force, i))(
-        get_aux(((force_t *)list_get(scene->force, i))));
+/**
+ * Removes and frees every force creator that acts on a body.
+ */
+void scene_remove_forces_with(scene_t *scene, body_t *body) {
+  force_batch_remove_with(scene->batched, body);
+  for (size_t i = 0; i < NUM_FORCE_PHASES; i++) {
+    list_remove_if(scene->forces[i], (list_predicate_t)scene_force_acts_on,
+                   body);
+  }
+}
+
+/**
+ * Runs the force creators of one phase, most recently added first.
+ */
+void scene_apply_phase(scene_t *scene, force_phase_t phase) {
+  list_t *forces = scene->forces[phase];
+  for (size_t i = list_size(forces); i > 0; i--) {
+    scene_apply_force(scene, list_get(forces, i - 1));
+  }
+}
+
+/**
+ * Sweeps a body that has just moved from start against the static bodies.
+ * If it passed into or through one, it is moved back to where it first
+ * touched it and stops moving into it, so fast bodies cannot skip through
+ * thin walls within one tick. Slow bodies that are not marked fast are left
+ * to the contact solver.
+ * Returns the body's bounds after any correction.
+ */
+aabb_t scene_sweep_body(scene_t *scene, body_t *body, vector_t start,
+                        aabb_t end) {
+  vector_t displacement = vec_subtract(body_get_centroid(body), start);
+  double extent = fmin(end.max.x - end.min.x, end.max.y - end.min.y);
+  if (!body_is_fast(body) &&
+      sqrt(vec_dot(displacement, displacement)) <=
+          SWEEP_EXTENT_FRACTION * extent) {
+    return end;
+  }
+  scene->stats.bodies_swept++;
+  aabb_t begin = {.min = vec_subtract(end.min, displacement),
+                  .max = vec_subtract(end.max, displacement)};
+  aabb_t path = {.min = {fmin(begin.min.x, end.min.x),
+                         fmin(begin.min.y, end.min.y)},
+                 .max = {fmax(begin.max.x, end.max.x),
+                         fmax(begin.max.y, end.max.y)}};
+  list_t *nearby = list_init(INITIAL_BODIES_GUESS, NULL);
+  scene_query_static(scene, path, nearby);
+  sweep_info_t first = {.hit = false, .time = 1};
+  for (size_t i = 0; i < list_size(nearby); i++) {
+    aabb_t wall = find_bounds(body_borrow_shape(list_get(nearby, i)));
+    sweep_info_t sweep = aabb_sweep(begin, displacement, wall);
+    if (sweep.hit && sweep.time < first.time) {
+      first = sweep;
+    }
   }
-  for (int i = end - 1; i >= 0; i--) {
-    get_force_creator((force_t *)list_get(scene->force, i))(
-        get_aux(((force_t *)list_get(scene->force, i))));
+  list_free(nearby);
+  if (!first.hit) {
+    return end;
   }
 
+  vector_t back = vec_multiply(1 - first.time, displacement);
+  body_set_centroid(body, vec_subtract(body_get_centroid(body), back));
+  vector_t velocity = body_get_velocity(body);
+  double into = vec_dot(velocity, first.normal);
+  if (into < 0) {
+    body_set_velocity(body,
+                      vec_subtract(velocity, vec_multiply(into, first.normal)));
+  }
+  return (aabb_t){.min = vec_subtract(end.min, back),
+                  .max = vec_subtract(end.max, back)};
+}
+
+/**
+ * Advances a scene by one step: runs the force creators, solves the contacts
+ * and ticks each body.
+ * The impulse phase only runs in the first step of a tick.
+ */
+void scene_step(scene_t *scene, double dt, bool first_substep) {
+  // The body counts describe the end of the tick, so only the last step's
+  // count is kept; the other counters add up over the steps
+  scene->stats.awake_bodies = 0;
+  scene->stats.sleeping_bodies = 0;
+  contact_cache_begin_tick(scene->contacts);
+  islands_reset(scene->islands, scene->bodies);
+  if (scene->static_sap != NULL) {
+    sap_update(scene->static_sap);
+  }
+  scene_apply_fields(scene);
+  scene_apply_batch(scene, FORCE_FALL);
+  scene_apply_batch(scene, FORCE_GRAVITY);
+  scene_apply_batch(scene, FORCE_SPRING);
+  scene_apply_batch(scene, FORCE_DRAG);
+  scene_apply_phase(scene, FORCE_PHASE_APPLY);
+  scene_apply_phase(scene, FORCE_PHASE_REACT);
+  if (first_substep) {
+    scene_apply_phase(scene, FORCE_PHASE_IMPULSE);
+  }
+  scene_apply_batch(scene, FORCE_PLAT);
+  scene_apply_batch(scene, FORCE_STATIC_PLAT);
+  scene_apply_phase(scene, FORCE_PHASE_CONTACT);
+  for (size_t i = 0; i < NUM_FORCE_PHASES; i++) {
+    for (size_t j = 0; j < list_size(scene->forces[i]); j++) {
+      force_t *force = list_get(scene->forces[i], j);
+      body_array_t *bodies = get_relevant_bodies(force);
+      if (bodies != NULL && force_is_enabled(force)) {
+        islands_connect_n(scene->islands, body_array_begin(bodies),
+                          body_array_size(bodies));
+      }
+    }
+  }
+  force_batch_connect(scene->batched, scene->islands);
+  scene->stats.islands = islands_finish(scene->islands);
+  scene->stats.contacts += solver_contacts(scene->solver);
+  scene->stats.collisions_cached += contact_cache_reused(scene->contacts);
+  solver_solve(scene->solver, dt);
+
   for (size_t i = scene->num_bodies; i > 0; i--) {
     if (body_is_removed(scene_get_body(scene, 0)) &&
         body_get_info_freer(scene_get_body(scene, 0)) != NULL &&
@@ -126,43 +723,613 @@ void scene_tick(scene_t *scene, double dt) {
     }
     body_t *curr = scene_get_body(scene, i - 1);
     if (body_is_removed(curr)) {
-      for (size_t j = list_size(scene->force); j > 0; j--) {
-        list_t *bods =
-            get_relevant_bodies((force_t *)list_get(scene->force, j - 1));
-        for (size_t k = 0; k < list_size(bods); k++) {
-          if (list_get(bods, k) == curr) {
-            force_t *rmv = list_get(scene->force, j - 1);
-            list_remove(scene->force, j - 1);
-            force_free(rmv);
-            break;
-          }
-        }
+      scene_remove_forces_with(scene, curr);
+      aabb_tree_remove(scene->body_tree, body_get_proxy(curr));
+      contact_cache_forget(scene->contacts, curr);
+      islands_forget(scene->islands, curr);
+      if (scene->static_sap != NULL) {
+        sap_remove(scene->static_sap, curr);
       }
-      body_t *rem = list_get(scene->bodies, i - 1);
-      list_remove(scene->bodies, i - 1);
-      body_free(rem);
+      // The last body has already been checked, so it can fill the gap
+      list_swap_remove(scene->bodies, i - 1);
+      scene_release_slot(scene, curr);
+      body_store_discard(scene->store, curr);
       scene->num_bodies--;
       scene->counter++;
+    }
+  }
+
+  body_store_integrate(scene->store, dt);
+  for (size_t i = 0; i < scene->num_bodies; i++) {
+    body_t *curr = scene_get_body(scene, i);
+    bool moved = !body_is_asleep(curr);
+    body_finish_tick(curr, dt);
+    if (moved) {
+      aabb_t bounds = find_bounds(body_borrow_shape(curr));
+      if (body_get_mass(curr) != INFINITY) {
+        bounds = scene_sweep_body(scene, curr, body_get_tick_start(curr),
+                                  bounds);
+      }
+      aabb_tree_move(scene->body_tree, body_get_proxy(curr), bounds);
+    }
+  }
+  scene->stats.sleeping_islands = islands_update_sleep(scene->islands);
+  for (size_t i = 0; i < scene->num_bodies; i++) {
+    body_t *body = scene_get_body(scene, i);
+    if (body_is_asleep(body)) {
+      scene->stats.sleeping_bodies++;
     } else {
-      body_tick(list_get(scene->bodies, i - 1), dt);
+      scene->stats.awake_bodies++;
+    }
+  }
+  for (size_t i = 0; i < scene->num_players; i++) {
+    body_t *player = scene_resolve(scene, scene->players[i]);
+    if (player != NULL) {
+      scene->lose = scene->lose || body_get_lose(player);
+      scene->win = scene->win || body_get_win(player);
+    }
+  }
+
+  for (size_t i = list_size(scene->static_bodies); i > 0; i--) {
+    body_t *curr = list_get(scene->static_bodies, i - 1);
+    if (body_is_removed(curr)) {
+      scene_remove_forces_with(scene, curr);
+      aabb_tree_remove(scene->static_tree, body_get_proxy(curr));
+      contact_cache_forget(scene->contacts, curr);
+      if (scene->static_sap != NULL) {
+        sap_remove(scene->static_sap, curr);
+      }
+      list_swap_remove(scene->static_bodies, i - 1);
+      scene_release_slot(scene, curr);
+      body_free(curr);
+      scene->static_dirty = true;
     }
   }
 }
 
+/**
+ * Picks how many substeps to split a tick into, so that no awake body moves
+ * more than a fraction of its size per substep and the stiffest spring
+ * turns through only a small angle of its oscillation.
+ */
+size_t scene_choose_substeps(scene_t *scene, double dt) {
+  if (scene->max_substeps <= 1) {
+    return 1;
+  }
+  double needed = dt * sqrt(scene->max_stiffness) / SUBSTEP_MAX_PHASE;
+  for (size_t i = 0; i < scene->num_bodies; i++) {
+    body_t *body = scene_get_body(scene, i);
+    if (body_is_asleep(body) || body_get_mass(body) == INFINITY) {
+      continue;
+    }
+    vector_t velocity = body_get_velocity(body);
+    aabb_t bounds = find_bounds(body_borrow_shape(body));
+    double extent =
+        fmin(bounds.max.x - bounds.min.x, bounds.max.y - bounds.min.y);
+    double travel = dt * sqrt(vec_dot(velocity, velocity));
+    if (extent > 0) {
+      needed = fmax(needed, travel / (SUBSTEP_MAX_TRAVEL * extent));
+    }
+  }
+  if (needed >= scene->max_substeps) {
+    return scene->max_substeps;
+  }
+  return needed <= 1 ? 1 : (size_t)ceil(needed);
+}
+
+void scene_tick(scene_t *scene, double dt) {
+  size_t substeps = scene_choose_substeps(scene, dt);
+  scene->stats = (scene_stats_t){0};
+  for (size_t i = 0; i < substeps; i++) {
+    scene_step(scene, dt / substeps, i == 0);
+  }
+  scene->stats.substeps = substeps;
+}
+
+bool scene_same_island(scene_t *scene, body_t *body1, body_t *body2) {
+  return islands_same(scene->islands, body1, body2);
+}
+
+void scene_set_max_substeps(scene_t *scene, size_t max_substeps) {
+  assert(max_substeps >= 1);
+  scene->max_substeps = max_substeps;
+}
+
+void scene_add_stiffness(scene_t *scene, double stiffness) {
+  scene->max_stiffness = fmax(scene->max_stiffness, stiffness);
+}
+
 void scene_add_force_creator(scene_t *scene, force_creator_t forcer, void *aux,
                              free_func_t freer) {
   force_t *f = force_init(forcer, aux, freer);
-  list_add(scene->force, f);
+  list_add(scene->forces[FORCE_PHASE_REACT], f);
 }
 
-void scene_free_forces(scene_t *scene) { list_free(scene->force); }
+void scene_free_forces(scene_t *scene) {
+  for (size_t i = 0; i < NUM_FORCE_PHASES; i++) {
+    list_free(scene->forces[i]);
+  }
+  free(scene->forces);
+}
 
 void scene_add_bodies_force_creator(scene_t *scene, force_creator_t forcer,
                                     void *aux, list_t *bodies,
                                     free_func_t freer) {
+  scene_add_phased_force_creator(scene, FORCE_PHASE_REACT, 0, forcer, aux,
+                                 bodies, freer, NULL);
+}
+
+void scene_add_phased_force_creator(scene_t *scene, force_phase_t phase,
+                                    size_t tag, force_creator_t forcer,
+                                    void *aux, list_t *bodies,
+                                    free_func_t freer, aux_cloner_t cloner) {
+  assert((size_t)phase < NUM_FORCE_PHASES);
   force_t *f = force_init_with_bodies(forcer, aux, bodies, freer);
-  list_add(scene->force, f);
+  force_set_tag(f, tag);
+  force_set_cloner(f, cloner);
+  list_add(scene->forces[phase], f);
+}
+
+void scene_add_phased_force_creator_n(scene_t *scene, force_phase_t phase,
+                                      size_t tag, force_creator_t forcer,
+                                      void *aux, body_t **bodies,
+                                      size_t num_bodies, free_func_t freer,
+                                      aux_cloner_t cloner) {
+  assert((size_t)phase < NUM_FORCE_PHASES);
+  force_t *f =
+      force_init_with_body_array(forcer, aux, bodies, num_bodies, freer);
+  force_set_tag(f, tag);
+  force_set_cloner(f, cloner);
+  list_add(scene->forces[phase], f);
+}
+
+void scene_set_tag_enabled(scene_t *scene, size_t tag, bool enabled) {
+  assert(tag != 0);
+  for (size_t i = 0; i < NUM_FORCE_PHASES; i++) {
+    for (size_t j = 0; j < list_size(scene->forces[i]); j++) {
+      force_t *force = list_get(scene->forces[i], j);
+      if (force_get_tag(force) != tag || force_is_enabled(force) == enabled) {
+        continue;
+      }
+      force_set_enabled(force, enabled);
+      // Bodies resting where the force acts need to react to the switch
+      body_array_t *bodies = get_relevant_bodies(force);
+      for (size_t k = 0; bodies != NULL && k < body_array_size(bodies); k++) {
+        body_t *body = body_array_get(bodies, k);
+        if (body_get_mass(body) != INFINITY) {
+          body_wake(body);
+        }
+      }
+    }
+  }
+}
+
+void scene_add_batched_force(scene_t *scene, force_kind_t kind,
+                             double constant, body_t *body1, body_t *body2) {
+  force_batch_add(scene->batched, kind, constant, body1, body2);
+}
+
+void scene_add_player(scene_t *scene, body_handle_t player) {
+  assert(scene->num_players < MAX_PLAYERS);
+  scene->players[scene->num_players++] = player;
+}
+
+size_t scene_add_field(scene_t *scene, force_field_t field) {
+  assert(scene->num_fields < MAX_FIELDS);
+  scene->fields[scene->num_fields] = field;
+  return scene->num_fields++;
+}
+
+/**
+ * Counts the force creators in every phase.
+ */
+size_t scene_count_forces(scene_t *scene) {
+  size_t count = 0;
+  for (size_t i = 0; i < NUM_FORCE_PHASES; i++) {
+    count += list_size(scene->forces[i]);
+  }
+  return count;
+}
+
+/**
+ * Counts the batched forces of every kind.
+ */
+size_t scene_count_batched(scene_t *scene) {
+  size_t count = 0;
+  for (force_kind_t kind = FORCE_DRAG; kind <= FORCE_STATIC_PLAT; kind++) {
+    count += force_batch_size(scene->batched, kind);
+  }
+  return count;
 }
 
+int clone_pair_compare(const void *a, const void *b) {
+  uintptr_t body1 = (uintptr_t)((const clone_pair_t *)a)->original;
+  uintptr_t body2 = (uintptr_t)((const clone_pair_t *)b)->original;
+  return body1 < body2 ? -1 : body1 > body2;
+}
+
+body_t *scene_find_clone(scene_t *clone, body_t *original) {
+  clone_pair_t key = {.original = original};
+  clone_pair_t *found =
+      bsearch(&key, clone->clone_map, clone->clone_map_size,
+              sizeof(clone_pair_t), clone_pair_compare);
+  return found == NULL ? NULL : found->copy;
+}
+
+/**
+ * Copies a force for a clone of its scene, or returns NULL if its auxiliary
+ * value or bodies cannot be copied.
+ */
+force_t *scene_clone_force(scene_t *clone, force_t *force) {
+  body_array_t *bodies = get_relevant_bodies(force);
+  list_t *copied_bodies = NULL;
+  if (bodies != NULL) {
+    copied_bodies = list_init(body_array_size(bodies), NULL);
+    for (size_t i = 0; i < body_array_size(bodies); i++) {
+      body_t *copy = scene_find_clone(clone, body_array_get(bodies, i));
+      if (copy == NULL) {
+        list_free(copied_bodies);
+        return NULL;
+      }
+      list_add(copied_bodies, copy);
+    }
+  }
+  void *aux = get_aux(force);
+  if (aux != NULL) {
+    aux = get_cloner(force) == NULL ? NULL : get_cloner(force)(aux, clone);
+    if (aux == NULL) {
+      if (copied_bodies != NULL) {
+        list_free(copied_bodies);
+      }
+      return NULL;
+    }
+  }
+  force_t *copy = force_init_with_bodies(get_force_creator(force), aux,
+                                         copied_bodies, get_freer(force));
+  force_set_tag(copy, force_get_tag(force));
+  force_set_enabled(copy, force_is_enabled(force));
+  force_set_cloner(copy, get_cloner(force));
+  return copy;
+}
+
+/**
+ * Copies a scene's force creators into a scene whose bodies map to the
+ * scene's through scene_find_clone(). Returns false if some force creator
+ * cannot be copied.
+ */
+bool scene_copy_forces(scene_t *clone, scene_t *scene) {
+  force_batch_t *batched = force_batch_clone(scene->batched, clone);
+  if (batched == NULL) {
+    return false;
+  }
+  force_batch_free(clone->batched);
+  clone->batched = batched;
+  for (size_t i = 0; i < NUM_FORCE_PHASES; i++) {
+    for (size_t j = 0; j < list_size(scene->forces[i]); j++) {
+      force_t *copy = scene_clone_force(clone, list_get(scene->forces[i], j));
+      if (copy == NULL) {
+        return false;
+      }
+      list_add(clone->forces[i], copy);
+    }
+  }
+  return true;
+}
+
+/**
+ * Makes an empty scene, set up with scene_setup(), into a copy of another
+ * scene. Returns false if some force creator cannot be copied, leaving the
+ * copy to be freed.
+ */
+bool scene_copy_into(scene_t *clone, scene_t *scene) {
+  size_t total = scene->num_bodies + list_size(scene->hidden_bodies) +
+                 list_size(scene->static_bodies);
+  clone->clone_map = malloc((total + 1) * sizeof(clone_pair_t));
+  assert(clone->clone_map != NULL);
+  scene_reserve_bodies(clone, scene->num_bodies);
+  list_reserve(clone->hidden_bodies, list_size(scene->hidden_bodies));
+  list_reserve(clone->static_bodies, list_size(scene->static_bodies));
+  // The moving bodies' state is copied array by array, and the copies are
+  // attached to it where it lands. Their tree is copied once the copies
+  // can be looked up.
+  body_store_copy_state(clone->store, scene->store);
+  for (size_t i = 0; i < scene->num_bodies; i++) {
+    body_t *original = scene_get_body(scene, i);
+    body_t *copy = body_clone_into(original, clone->store);
+    list_add(clone->bodies, copy);
+    clone->clone_map[clone->clone_map_size++] =
+        (clone_pair_t){.original = original, .copy = copy};
+  }
+  clone->num_bodies = scene->num_bodies;
+  for (size_t i = 0; i < list_size(scene->hidden_bodies); i++) {
+    body_t *original = list_get(scene->hidden_bodies, i);
+    body_t *copy = body_clone(original);
+    scene_add_hidden_body(clone, copy);
+    clone->clone_map[clone->clone_map_size++] =
+        (clone_pair_t){.original = original, .copy = copy};
+  }
+  for (size_t i = 0; i < list_size(scene->static_bodies); i++) {
+    body_t *original = list_get(scene->static_bodies, i);
+    body_t *copy = body_clone(original);
+    scene_add_static_body(clone, copy);
+    clone->clone_map[clone->clone_map_size++] =
+        (clone_pair_t){.original = original, .copy = copy};
+  }
+  qsort(clone->clone_map, clone->clone_map_size, sizeof(clone_pair_t),
+        clone_pair_compare);
+  aabb_tree_free(clone->body_tree);
+  clone->body_tree = aabb_tree_clone(
+      scene->body_tree, (item_mapper_t)scene_find_clone, clone);
+  // Copy the slots as well, so handles resolve to the copies
+  if (scene->num_slots > clone->slots_capacity) {
+    clone->slots_capacity = scene->num_slots;
+    clone->slots =
+        realloc(clone->slots, clone->slots_capacity * sizeof(body_slot_t));
+    assert(clone->slots != NULL);
+  }
+  memcpy(clone->slots, scene->slots, scene->num_slots * sizeof(body_slot_t));
+  clone->num_slots = scene->num_slots;
+  clone->free_slot = scene->free_slot;
+  for (size_t i = 0; i < clone->clone_map_size; i++) {
+    body_t *copy = clone->clone_map[i].copy;
+    size_t slot = body_get_slot(clone->clone_map[i].original);
+    clone->slots[slot].body = copy;
+    body_set_slot(copy, slot);
+  }
+  scene_set_broadphase(clone, scene->broadphase);
+  contact_cache_copy(clone->contacts, scene->contacts,
+                     (item_mapper_t)scene_find_clone, clone);
+
+  if (!scene_copy_forces(clone, scene)) {
+    return false;
+  }
+
+  memcpy(clone->fields, scene->fields,
+         scene->num_fields * sizeof(force_field_t));
+  clone->num_fields = scene->num_fields;
+  memcpy(clone->players, scene->players,
+         scene->num_players * sizeof(body_handle_t));
+  clone->num_players = scene->num_players;
+  solver_set_iterations(clone->solver, solver_get_iterations(scene->solver));
+  clone->max_substeps = scene->max_substeps;
+  clone->max_stiffness = scene->max_stiffness;
+  clone->counter = scene->counter;
+  clone->win = scene->win;
+  clone->lose = scene->lose;
+  return true;
+}
+
+scene_t *scene_clone(scene_t *scene) {
+  scene_t *clone = scene_init();
+  if (!scene_copy_into(clone, scene)) {
+    scene_free(clone);
+    return NULL;
+  }
+  return clone;
+}
+
+/**
+ * Returns the size of a snapshot with the given header.
+ */
+size_t snapshot_size(snapshot_header_t *header) {
+  return sizeof(snapshot_header_t) +
+         header->num_bodies * sizeof(snapshot_body_t) +
+         (header->num_hidden + header->num_static) * sizeof(body_handle_t) +
+         header->num_fields * sizeof(force_field_t) +
+         header->num_forces * sizeof(bool);
+}
+
+/**
+ * Writes the handles of a list of bodies to a snapshot.
+ * Returns where the next part of the snapshot goes.
+ */
+body_handle_t *snapshot_handles(scene_t *scene, list_t *bodies,
+                                body_handle_t *handles) {
+  for (size_t i = 0; i < list_size(bodies); i++) {
+    *handles++ = scene_get_handle(scene, list_get(bodies, i));
+  }
+  return handles;
+}
+
+void *scene_snapshot(scene_t *scene, size_t *size) {
+  snapshot_header_t header = {.magic = SNAPSHOT_MAGIC,
+                              .num_bodies = scene->num_bodies,
+                              .num_hidden = list_size(scene->hidden_bodies),
+                              .num_static = list_size(scene->static_bodies),
+                              .num_fields = scene->num_fields,
+                              .num_forces = scene_count_forces(scene),
+                              .num_batched = scene_count_batched(scene),
+                              .counter = scene->counter,
+                              .win = scene->win,
+                              .lose = scene->lose,
+                              .copy = scene_clone(scene)};
+  *size = snapshot_size(&header);
+  char *buffer = malloc(*size);
+  assert(buffer != NULL);
+  memcpy(buffer, &header, sizeof(header));
+
+  snapshot_body_t *bodies = (snapshot_body_t *)(buffer + sizeof(header));
+  for (size_t i = 0; i < scene->num_bodies; i++) {
+    body_t *body = scene_get_body(scene, i);
+    bodies[i] = (snapshot_body_t){.handle = scene_get_handle(scene, body),
+                                  .state = body_get_state(body)};
+  }
+  force_field_t *fields = (force_field_t *)(bodies + header.num_bodies);
+  memcpy(fields, scene->fields, header.num_fields * sizeof(force_field_t));
+  body_handle_t *handles = (body_handle_t *)(fields + header.num_fields);
+  handles = snapshot_handles(scene, scene->hidden_bodies, handles);
+  handles = snapshot_handles(scene, scene->static_bodies, handles);
+  bool *enabled = (bool *)handles;
+  for (size_t i = 0; i < NUM_FORCE_PHASES; i++) {
+    for (size_t j = 0; j < list_size(scene->forces[i]); j++) {
+      *enabled++ = force_is_enabled(list_get(scene->forces[i], j));
+    }
+  }
+  return buffer;
+}
+
+/**
+ * Returns whether every handle saved in a snapshot still refers to a body.
+ * Along with the counts matching, this means the scene has exactly the
+ * bodies it had when the snapshot was taken.
+ */
+bool snapshot_bodies_match(scene_t *scene, snapshot_header_t *header,
+                           const snapshot_body_t *bodies,
+                           const body_handle_t *handles) {
+  for (size_t i = 0; i < header->num_bodies; i++) {
+    if (scene_resolve(scene, bodies[i].handle) == NULL) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < header->num_hidden + header->num_static; i++) {
+    if (scene_resolve(scene, handles[i]) == NULL) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Points the scene's clone map from each body of a copy of it to the
+ * scene's body with the same handle, so things can be copied back from the
+ * copy with scene_find_clone(). Every body of the copy must still be there.
+ */
+void scene_map_from_copy(scene_t *scene, scene_t *copy) {
+  free(scene->clone_map);
+  scene->clone_map = malloc((copy->clone_map_size + 1) * sizeof(clone_pair_t));
+  assert(scene->clone_map != NULL);
+  scene->clone_map_size = copy->clone_map_size;
+  for (size_t i = 0; i < copy->clone_map_size; i++) {
+    body_t *body = copy->clone_map[i].copy;
+    size_t slot = body_get_slot(body);
+    body_handle_t handle = {.index = slot,
+                            .generation = copy->slots[slot].generation};
+    scene->clone_map[i] = (clone_pair_t){.original = body,
+                                         .copy = scene_resolve(scene, handle)};
+    assert(scene->clone_map[i].copy != NULL);
+  }
+  qsort(scene->clone_map, scene->clone_map_size, sizeof(clone_pair_t),
+        clone_pair_compare);
+}
+
+/**
+ * Replaces the scene's force creators and remembered contacts with fresh
+ * copies of those of a copy of it that has the same bodies.
+ */
+void scene_restore_forces(scene_t *scene, scene_t *copy) {
+  scene_map_from_copy(scene, copy);
+  for (size_t i = 0; i < NUM_FORCE_PHASES; i++) {
+    list_free(scene->forces[i]);
+    scene->forces[i] =
+        list_init(list_size(copy->forces[i]), (free_func_t)force_free);
+  }
+  // The copy's force creators were all copied once, so they copy again
+  bool copied = scene_copy_forces(scene, copy);
+  assert(copied);
+  contact_cache_copy(scene->contacts, copy->contacts,
+                     (item_mapper_t)scene_find_clone, scene);
+}
+
+bool scene_restore(scene_t *scene, const void *snapshot, size_t size) {
+  const char *buffer = snapshot;
+  snapshot_header_t header;
+  if (size < sizeof(header)) {
+    return false;
+  }
+  memcpy(&header, buffer, sizeof(header));
+  if (header.magic != SNAPSHOT_MAGIC || size != snapshot_size(&header) ||
+      header.num_fields > MAX_FIELDS) {
+    return false;
+  }
+  const snapshot_body_t *bodies =
+      (const snapshot_body_t *)(buffer + sizeof(header));
+  const force_field_t *fields =
+      (const force_field_t *)(bodies + header.num_bodies);
+  const body_handle_t *handles =
+      (const body_handle_t *)(fields + header.num_fields);
+  if (header.num_bodies != scene->num_bodies ||
+      header.num_hidden != list_size(scene->hidden_bodies) ||
+      header.num_static != list_size(scene->static_bodies) ||
+      header.num_forces != scene_count_forces(scene) ||
+      header.num_batched != scene_count_batched(scene) ||
+      !snapshot_bodies_match(scene, &header, bodies, handles)) {
+    if (header.copy == NULL) {
+      return false;
+    }
+    // Bodies have come or gone, so rebuild the whole scene from the copy
+    scene_teardown(scene);
+    scene_setup(scene);
+    bool copied = scene_copy_into(scene, header.copy);
+    assert(copied);
+    return true;
+  }
+
+  for (size_t i = 0; i < header.num_bodies; i++) {
+    body_t *body = scene_resolve(scene, bodies[i].handle);
+    body_set_state(body, bodies[i].state);
+    aabb_tree_move(scene->body_tree, body_get_proxy(body),
+                   find_bounds(body_borrow_shape(body)));
+  }
+  memcpy(scene->fields, fields, header.num_fields * sizeof(force_field_t));
+  scene->num_fields = header.num_fields;
+  if (header.copy != NULL) {
+    scene_restore_forces(scene, header.copy);
+  } else {
+    const bool *enabled =
+        (const bool *)(handles + header.num_hidden + header.num_static);
+    for (size_t i = 0; i < NUM_FORCE_PHASES; i++) {
+      for (size_t j = 0; j < list_size(scene->forces[i]); j++) {
+        force_set_enabled(list_get(scene->forces[i], j), *enabled++);
+      }
+    }
+    contact_cache_clear(scene->contacts);
+  }
+  scene->counter = header.counter;
+  scene->win = header.win;
+  scene->lose = header.lose;
+  scene->stats = (scene_stats_t){0};
+  return true;
+}
+
+void scene_free_snapshot(void *snapshot) {
+  if (snapshot == NULL) {
+    return;
+  }
+  snapshot_header_t header;
+  memcpy(&header, snapshot, sizeof(header));
+  if (header.copy != NULL) {
+    scene_free(header.copy);
+  }
+  free(snapshot);
+}
+
+/**
+ * Mixes the number of bodies in a list and each of their hashes into a hash.
+ */
+uint64_t scene_hash_bodies(uint64_t hash, list_t *bodies, size_t count) {
+  uint64_t size = count;
+  hash = hash_bytes(hash, &size, sizeof(size));
+  for (size_t i = 0; i < count; i++) {
+    uint64_t body = body_hash(list_get(bodies, i));
+    hash = hash_bytes(hash, &body, sizeof(body));
+  }
+  return hash;
+}
+
+uint64_t scene_hash(scene_t *scene) {
+  uint64_t hash = HASH_SEED;
+  hash = scene_hash_bodies(hash, scene->bodies, scene->num_bodies);
+  hash = scene_hash_bodies(hash, scene->hidden_bodies,
+                           list_size(scene->hidden_bodies));
+  hash = scene_hash_bodies(hash, scene->static_bodies,
+                           list_size(scene->static_bodies));
+  uint64_t counter = scene->counter;
+  uint8_t flags[] = {scene->win, scene->lose};
+  hash = hash_bytes(hash, &counter, sizeof(counter));
+  return hash_bytes(hash, flags, sizeof(flags));
+}
+
+scene_stats_t scene_get_stats(scene_t *scene) { return scene->stats; }
+
 bool scene_get_lose(scene_t *scene) {return scene->lose; }
 bool scene_get_win(scene_t *scene) {return scene->win; }
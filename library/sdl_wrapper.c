@@ -43,6 +43,20 @@ uint32_t key_start_timestamp;
  * Initially 0.
  */
 clock_t last_clock = 0;
+/**
+ * Whether to run without a window, e.g. to replay a session quickly.
+ */
+bool headless = false;
+/**
+ * The recording that handled events and ticks are added to, or NULL.
+ */
+replay_t *recording = NULL;
+/**
+ * The recording being played back instead of the real events and clock,
+ * or NULL, and the index of its next event.
+ */
+replay_t *playback = NULL;
+size_t playback_index = 0;
 
 /** Computes the center of the window in pixel coordinates */
 vector_t get_window_center(void) {
@@ -113,6 +127,9 @@ void sdl_init(vector_t min, vector_t max) {
 
   center = vec_multiply(0.5, vec_add(min, max));
   max_diff = vec_subtract(max, center);
+  if (headless) {
+    return;
+  }
   SDL_Init(SDL_INIT_EVERYTHING);
   window = SDL_CreateWindow(WINDOW_TITLE, SDL_WINDOWPOS_CENTERED,
                             SDL_WINDOWPOS_CENTERED, WINDOW_WIDTH, WINDOW_HEIGHT,
@@ -121,7 +138,42 @@ void sdl_init(vector_t min, vector_t max) {
 
 }
 
+void sdl_set_headless(bool is_headless) { headless = is_headless; }
+
+bool sdl_is_headless(void) { return headless; }
+
+void sdl_record(replay_t *replay) { recording = replay; }
+
+void sdl_replay(replay_t *replay) {
+  playback = replay;
+  playback_index = 0;
+}
+
+/**
+ * Passes the recorded events up to the next tick to the handlers.
+ * Returns whether the recording has run out.
+ */
+bool sdl_replay_events(state_t *s) {
+  while (playback_index < replay_size(playback)) {
+    replay_event_t event = replay_get(playback, playback_index);
+    if (event.kind == REPLAY_TICK) {
+      return false;
+    }
+    playback_index++;
+    if (event.kind == REPLAY_KEY && key_handler != NULL) {
+      key_handler(s, event.key, event.released ? KEY_RELEASED : KEY_PRESSED,
+                  event.held_time);
+    } else if (event.kind == REPLAY_MOUSE && mouse_handler != NULL) {
+      mouse_handler(s, event.x, event.y);
+    }
+  }
+  return true;
+}
+
 bool sdl_is_done(state_t *s) {
+  if (playback != NULL) {
+    return sdl_replay_events(s);
+  }
   SDL_Event *event = malloc(sizeof(*event));
   assert(event != NULL);
   while (SDL_PollEvent(event)) {
@@ -147,9 +199,20 @@ bool sdl_is_done(state_t *s) {
           event->type == SDL_KEYDOWN ? KEY_PRESSED : KEY_RELEASED;
       double held_time = (timestamp - key_start_timestamp) / MS_PER_S;
       key_handler(s, key, type, held_time);
+      if (recording != NULL) {
+        replay_add(recording, (replay_event_t){.kind = REPLAY_KEY,
+                                               .key = key,
+                                               .released = type == KEY_RELEASED,
+                                               .held_time = held_time});
+      }
       break;
     case SDL_MOUSEBUTTONDOWN:
       mouse_handler(s, event->motion.x, event->motion.y);
+      if (recording != NULL) {
+        replay_add(recording, (replay_event_t){.kind = REPLAY_MOUSE,
+                                               .x = event->motion.x,
+                                               .y = event->motion.y});
+      }
       break;
     }
   }
@@ -158,6 +221,9 @@ bool sdl_is_done(state_t *s) {
 }
 
 void sdl_clear(void) {
+  if (headless) {
+    return;
+  }
   SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
   SDL_RenderClear(renderer);
 }
@@ -169,6 +235,9 @@ void sdl_draw_polygon(list_t *points, rgb_color_t color) {
   assert(0 <= color.r && color.r <= 1);
   assert(0 <= color.g && color.g <= 1);
   assert(0 <= color.b && color.b <= 1);
+  if (headless) {
+    return;
+  }
 
   vector_t window_center = get_window_center();
 
@@ -193,6 +262,9 @@ void sdl_draw_polygon(list_t *points, rgb_color_t color) {
 
 
 void sdl_show(void) {
+  if (headless) {
+    return;
+  }
   // Draw boundary lines
   vector_t window_center = get_window_center();
   vector_t max = vec_add(center, max_diff),
@@ -212,21 +284,30 @@ void sdl_show(void) {
 }
 
 SDL_Texture *sdl_load_image(char *draw){
+  if (headless) {
+    return NULL;
+  }
   return IMG_LoadTexture(get_renderer(), draw);
 }
 
 void sdl_render_image(SDL_Texture *texture, vector_t center, vector_t size, double angle){
+  if (headless) {
+    return;
+  }
   SDL_Rect rect = {WINDOW_HEIGHT/2 + center.x/2 - size.x/2, WINDOW_WIDTH/2 - center.y/2 - size.y/2, (int)size.x, (int)size.y};
   SDL_RenderCopyEx(renderer, texture, NULL, &rect, angle, NULL, SDL_FLIP_NONE);
 }
 
 void sdl_render_scene(scene_t *scene) {
+  if (headless) {
+    return;
+  }
   sdl_clear();
   size_t body_count = scene_bodies(scene);
 
   for (size_t i = 0; i < body_count; i++) {
     body_t *body = scene_get_body(scene, i);
-    list_t *shape = body_get_shape(body);
+    list_t *shape = body_borrow_shape(body);
     if(body_get_texture(body)!=NULL){
       sdl_render_image(body_get_texture(body), body_get_centroid(body), 
                       (vector_t){body_get_width(body)/2, body_get_height(body)/2}, 0); //edit the size
@@ -234,7 +315,6 @@ void sdl_render_scene(scene_t *scene) {
     else{
        sdl_draw_polygon(shape, body_get_color(body));
     }
-    list_free(shape);
   }
   sdl_show();
 }
@@ -243,10 +323,21 @@ void sdl_on_key(key_handler_t handler) { key_handler = handler; }
 void sdl_on_mouse(mouse_handler_t handler) { mouse_handler = handler; }
 
 double time_since_last_tick(void) {
+  if (playback != NULL) {
+    // sdl_is_done() stops at each tick, so the next event is this tick
+    assert(playback_index < replay_size(playback));
+    replay_event_t tick = replay_get(playback, playback_index++);
+    assert(tick.kind == REPLAY_TICK);
+    return tick.dt;
+  }
   clock_t now = clock();
   double difference = last_clock
                           ? (double)(now - last_clock) / CLOCKS_PER_SEC
                           : 0.0; // return 0 the first time this is called
   last_clock = now;
+  if (recording != NULL) {
+    replay_add(recording,
+               (replay_event_t){.kind = REPLAY_TICK, .dt = difference});
+  }
   return difference;
 }
@@ -0,0 +1,70 @@
+#include "shape.h"
+#include "list.h"
+#include "polygon.h"
+#include "vector.h"
+#include <assert.h>
+#include <stdlib.h>
+
+typedef struct shape {
+  list_t *points;
+  list_t *pieces;
+  vector_t origin;
+  size_t refs;
+} shape_t;
+
+shape_t *shape_init(list_t *points) {
+  shape_t *shape = malloc(sizeof(shape_t));
+  assert(shape != NULL);
+  shape->origin = polygon_centroid(points);
+  polygon_translate(points, vec_negate(shape->origin));
+  shape->points = points;
+  shape->pieces = polygon_convex_decompose(points);
+  shape->refs = 1;
+  return shape;
+}
+
+shape_t *shape_acquire(shape_t *shape) {
+  shape->refs++;
+  return shape;
+}
+
+void shape_release(shape_t *shape) {
+  assert(shape->refs > 0);
+  shape->refs--;
+  if (shape->refs > 0) {
+    return;
+  }
+  list_free(shape->points);
+  if (shape->pieces != NULL) {
+    list_free(shape->pieces);
+  }
+  free(shape);
+}
+
+vector_t shape_get_origin(shape_t *shape) { return shape->origin; }
+
+list_t *shape_get_points(shape_t *shape) { return shape->points; }
+
+list_t *shape_get_pieces(shape_t *shape) { return shape->pieces; }
+
+list_t *shape_place(list_t *points, vector_t position, double angle) {
+  size_t size = list_size(points);
+  list_t *placed = list_init(size, free);
+  for (size_t i = 0; i < size; i++) {
+    vector_t *v = malloc(sizeof(vector_t));
+    assert(v != NULL);
+    *v = vec_add(vec_rotate(*(vector_t *)list_get(points, i), angle), position);
+    list_add(placed, v);
+  }
+  return placed;
+}
+
+void shape_place_into(list_t *points, vector_t position, double angle,
+                      list_t *placed) {
+  size_t size = list_size(points);
+  assert(list_size(placed) == size);
+  for (size_t i = 0; i < size; i++) {
+    vector_t *v = list_get(placed, i);
+    *v = vec_add(vec_rotate(*(vector_t *)list_get(points, i), angle), position);
+  }
+}
@@ -0,0 +1,223 @@
+#include "solver.h"
+#include "body.h"
+#include "contact_cache.h"
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+const size_t INITIAL_CONTACTS_GUESS = 16;
+// Overlap allowed before bodies are pushed apart, which keeps resting
+// contacts touching from one tick to the next instead of jittering
+const double CONTACT_SLOP = 0.5;
+// Fraction of the remaining overlap removed per tick
+const double CONTACT_BAUMGARTE = 0.2;
+
+typedef struct contact {
+  body_t *body1;
+  body_t *body2;
+  vector_t normal;
+  double depth;
+  // Accumulated impulse along the normal; never negative
+  double impulse;
+  size_t index1;
+  size_t index2;
+  double mass;
+  double bias;
+} contact_t;
+
+/**
+ * A body's velocity as it is being solved.
+ */
+typedef struct solver_body {
+  body_t *body;
+  double inv_mass;
+  vector_t predicted;
+  vector_t velocity;
+} solver_body_t;
+
+typedef struct solver {
+  size_t iterations;
+  // Remembers each pair's impulse for warm starting
+  contact_cache_t *cache;
+  contact_t *contacts;
+  size_t num_contacts;
+  size_t capacity;
+  double previous_dt;
+  solver_body_t *bodies;
+  size_t num_bodies;
+  size_t body_capacity;
+} solver_t;
+
+solver_t *solver_init(size_t iterations, contact_cache_t *cache) {
+  solver_t *solver = malloc(sizeof(solver_t));
+  assert(solver != NULL);
+  solver->iterations = iterations;
+  solver->cache = cache;
+  solver->capacity = INITIAL_CONTACTS_GUESS;
+  solver->contacts = malloc(solver->capacity * sizeof(contact_t));
+  solver->num_contacts = 0;
+  solver->previous_dt = 0;
+  solver->body_capacity = 2 * INITIAL_CONTACTS_GUESS;
+  solver->bodies = malloc(solver->body_capacity * sizeof(solver_body_t));
+  solver->num_bodies = 0;
+  assert(solver->contacts != NULL && solver->bodies != NULL);
+  return solver;
+}
+
+void solver_free(solver_t *solver) {
+  free(solver->contacts);
+  free(solver->bodies);
+  free(solver);
+}
+
+void solver_set_iterations(solver_t *solver, size_t iterations) {
+  solver->iterations = iterations;
+}
+
+size_t solver_get_iterations(solver_t *solver) { return solver->iterations; }
+
+void solver_add_contact(solver_t *solver, body_t *body1, body_t *body2,
+                        vector_t normal, double depth) {
+  if (solver->num_contacts == solver->capacity) {
+    solver->capacity *= 2;
+    solver->contacts =
+        realloc(solver->contacts, solver->capacity * sizeof(contact_t));
+    assert(solver->contacts != NULL);
+  }
+  solver->contacts[solver->num_contacts++] = (contact_t){
+      .body1 = body1, .body2 = body2, .normal = normal, .depth = depth};
+}
+
+size_t solver_contacts(solver_t *solver) { return solver->num_contacts; }
+
+int solver_body_compare(const void *a, const void *b) {
+  uintptr_t body1 = (uintptr_t)((const solver_body_t *)a)->body;
+  uintptr_t body2 = (uintptr_t)((const solver_body_t *)b)->body;
+  return body1 < body2 ? -1 : body1 > body2;
+}
+
+size_t solver_find_body(solver_t *solver, body_t *body) {
+  solver_body_t key = {.body = body};
+  solver_body_t *found = bsearch(&key, solver->bodies, solver->num_bodies,
+                                 sizeof(solver_body_t), solver_body_compare);
+  assert(found != NULL);
+  return found - solver->bodies;
+}
+
+/**
+ * Collects the distinct bodies of the pending contacts and predicts the
+ * velocity each will have at the end of the tick, as body_tick() would
+ * compute it.
+ */
+void solver_gather_bodies(solver_t *solver, double dt) {
+  if (2 * solver->num_contacts > solver->body_capacity) {
+    solver->body_capacity = 2 * solver->num_contacts;
+    solver->bodies = realloc(solver->bodies,
+                             solver->body_capacity * sizeof(solver_body_t));
+    assert(solver->bodies != NULL);
+  }
+  for (size_t i = 0; i < solver->num_contacts; i++) {
+    solver->bodies[2 * i].body = solver->contacts[i].body1;
+    solver->bodies[2 * i + 1].body = solver->contacts[i].body2;
+  }
+  qsort(solver->bodies, 2 * solver->num_contacts, sizeof(solver_body_t),
+        solver_body_compare);
+  size_t unique = 0;
+  for (size_t i = 0; i < 2 * solver->num_contacts; i++) {
+    if (unique == 0 ||
+        solver->bodies[unique - 1].body != solver->bodies[i].body) {
+      solver->bodies[unique++] = solver->bodies[i];
+    }
+  }
+  solver->num_bodies = unique;
+
+  for (size_t i = 0; i < solver->num_bodies; i++) {
+    solver_body_t *solver_body = &solver->bodies[i];
+    body_t *body = solver_body->body;
+    double mass = body_get_mass(body);
+    // Sleeping bodies hold still until something wakes them
+    if (mass == INFINITY || body_is_asleep(body)) {
+      solver_body->inv_mass = 0;
+      solver_body->predicted = body_get_velocity(body);
+    } else {
+      solver_body->inv_mass = 1 / mass;
+      solver_body->predicted = vec_add(
+          body_get_velocity(body),
+          vec_add(vec_multiply(dt, body_get_acceleration(body)),
+                  vec_multiply(1 / mass, body_get_total_impulse(body))));
+    }
+    solver_body->velocity = solver_body->predicted;
+  }
+}
+
+/**
+ * Applies an impulse along a contact's normal to both of its bodies.
+ */
+void contact_apply(solver_t *solver, contact_t *contact, double impulse) {
+  solver_body_t *body1 = &solver->bodies[contact->index1];
+  solver_body_t *body2 = &solver->bodies[contact->index2];
+  vector_t push = vec_multiply(impulse, contact->normal);
+  body1->velocity =
+      vec_subtract(body1->velocity, vec_multiply(body1->inv_mass, push));
+  body2->velocity =
+      vec_add(body2->velocity, vec_multiply(body2->inv_mass, push));
+}
+
+void solver_solve(solver_t *solver, double dt) {
+  solver_gather_bodies(solver, dt);
+
+  for (size_t i = 0; i < solver->num_contacts; i++) {
+    contact_t *contact = &solver->contacts[i];
+    contact->index1 = solver_find_body(solver, contact->body1);
+    contact->index2 = solver_find_body(solver, contact->body2);
+    double inv_mass = solver->bodies[contact->index1].inv_mass +
+                      solver->bodies[contact->index2].inv_mass;
+    contact->mass = inv_mass == 0 ? 0 : 1 / inv_mass;
+    contact->bias = dt > 0 ? CONTACT_BAUMGARTE *
+                                 fmax(contact->depth - CONTACT_SLOP, 0) / dt
+                           : 0;
+    double previous = contact_cache_previous_impulse(
+        solver->cache, contact->body1, contact->body2);
+    // Resting impulses scale with the tick length, which varies
+    contact->impulse =
+        solver->previous_dt <= 0 ? 0 : previous * dt / solver->previous_dt;
+    contact_apply(solver, contact, contact->impulse);
+  }
+
+  for (size_t iteration = 0; iteration < solver->iterations; iteration++) {
+    for (size_t i = 0; i < solver->num_contacts; i++) {
+      contact_t *contact = &solver->contacts[i];
+      vector_t relative =
+          vec_subtract(solver->bodies[contact->index2].velocity,
+                       solver->bodies[contact->index1].velocity);
+      double closing = vec_dot(relative, contact->normal);
+      // Clamp the total, not the increment, so later passes can undo
+      // impulses that earlier passes over-applied
+      double impulse =
+          fmax(contact->impulse + contact->mass * (contact->bias - closing), 0);
+      contact_apply(solver, contact, impulse - contact->impulse);
+      contact->impulse = impulse;
+    }
+  }
+
+  for (size_t i = 0; i < solver->num_bodies; i++) {
+    solver_body_t *solver_body = &solver->bodies[i];
+    if (solver_body->inv_mass == 0) {
+      continue;
+    }
+    vector_t change =
+        vec_subtract(solver_body->velocity, solver_body->predicted);
+    body_add_impulse(solver_body->body,
+                     vec_multiply(1 / solver_body->inv_mass, change));
+  }
+
+  // Remember this solve's impulses for warm starting the next one
+  for (size_t i = 0; i < solver->num_contacts; i++) {
+    contact_t *contact = &solver->contacts[i];
+    contact_cache_set_impulse(solver->cache, contact->body1, contact->body2,
+                              contact->impulse);
+  }
+  solver->num_contacts = 0;
+  solver->previous_dt = dt;
+}
@@ -52,6 +52,10 @@ void draw_init(){
 }
 
 void draw_text(scene_t *scene, char *worldText){
+  if (sdl_is_headless()) {
+    free(worldText);
+    return;
+  }
   SDL_Surface* text;
   if (!FONT1){
     FONT1 = TTF_OpenFont("assets/Armstrong.ttf", FONT_SIZE_1);
@@ -101,6 +105,9 @@ void draw_text(scene_t *scene, char *worldText){
 }
 
 void draw_win(char *display_time, size_t curr_gem_ct, char grade){
+  if (sdl_is_headless()) {
+    return;
+  }
   if (!FONT2){
     FONT2 = TTF_OpenFont("assets/Armstrong.ttf", FONT_SIZE_2);
   }
@@ -4,6 +4,8 @@
 
 const vector_t VEC_ZERO = {0, 0};
 
+ARRAY_DEFINE(vector_t, vector_array)
+
 vector_t vec_add(vector_t v1, vector_t v2) {
   vector_t v = {.x = v1.x + v2.x, .y = v1.y + v2.y};
   return v;
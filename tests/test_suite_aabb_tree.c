@@ -0,0 +1,168 @@
+#include "aabb_tree.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+bool contains(list_t *list, void *item) {
+  for (size_t i = 0; i < list_size(list); i++) {
+    if (list_get(list, i) == item) {
+      return true;
+    }
+  }
+  return false;
+}
+
+aabb_t make_box(vector_t center, double half) {
+  return (aabb_t){.min = {center.x - half, center.y - half},
+                  .max = {center.x + half, center.y + half}};
+}
+
+void test_tree_empty() {
+  aabb_tree_t *tree = aabb_tree_init(1);
+  list_t *results = list_init(1, NULL);
+  aabb_tree_query(tree, make_box(VEC_ZERO, 100), results);
+  aabb_tree_raycast(tree, VEC_ZERO, (vector_t){100, 100}, results);
+  assert(list_size(results) == 0);
+  assert(aabb_tree_height(tree) == 0);
+  list_free(results);
+  aabb_tree_free(tree);
+}
+
+void test_tree_balanced() {
+  const size_t NUM_ITEMS = 256;
+  aabb_tree_t *tree = aabb_tree_init(0);
+  size_t ids[NUM_ITEMS];
+  // Inserting along a line is the worst case for an unbalanced tree
+  for (size_t i = 0; i < NUM_ITEMS; i++) {
+    ids[i] = aabb_tree_insert(tree, &ids[i],
+                              make_box((vector_t){i * 10.0, 0}, 1));
+  }
+  assert(aabb_tree_height(tree) <= 2 * 8 + 2);
+
+  list_t *results = list_init(4, NULL);
+  aabb_tree_query(tree, (aabb_t){{95, -1}, {125, 1}}, results);
+  assert(list_size(results) == 3);
+  for (size_t i = 10; i <= 12; i++) {
+    assert(contains(results, &ids[i]));
+  }
+  list_free(results);
+
+  // Removing every other item keeps the tree consistent
+  for (size_t i = 0; i < NUM_ITEMS; i += 2) {
+    aabb_tree_remove(tree, ids[i]);
+  }
+  results = list_init(4, NULL);
+  aabb_tree_query(tree, (aabb_t){{-10, -10}, {NUM_ITEMS * 10.0, 10}}, results);
+  assert(list_size(results) == NUM_ITEMS / 2);
+  assert(!contains(results, &ids[0]));
+  assert(contains(results, &ids[1]));
+  list_free(results);
+  aabb_tree_free(tree);
+}
+
+void test_tree_move() {
+  aabb_tree_t *tree = aabb_tree_init(5);
+  int item;
+  size_t id = aabb_tree_insert(tree, &item, make_box(VEC_ZERO, 1));
+  // Small moves stay inside the fat box
+  assert(!aabb_tree_move(tree, id, make_box((vector_t){3, -3}, 1)));
+  list_t *results = list_init(1, NULL);
+  aabb_tree_query(tree, make_box((vector_t){5.5, 0}, 0.1), results);
+  assert(list_size(results) == 1);
+  list_free(results);
+
+  assert(aabb_tree_move(tree, id, make_box((vector_t){100, 0}, 1)));
+  results = list_init(1, NULL);
+  aabb_tree_query(tree, make_box(VEC_ZERO, 1), results);
+  assert(list_size(results) == 0);
+  aabb_tree_query(tree, make_box((vector_t){100, 0}, 1), results);
+  assert(list_size(results) == 1);
+  list_free(results);
+  aabb_tree_free(tree);
+}
+
+// Maps an item in items to the same index in the array of copies
+void *map_to_copy(void *copies, void *item) {
+  return (int *)copies + (*(int *)item);
+}
+
+void test_tree_clone() {
+  const int NUM_ITEMS = 20;
+  aabb_tree_t *tree = aabb_tree_init(0.5);
+  int items[NUM_ITEMS];
+  int copies[NUM_ITEMS];
+  size_t ids[NUM_ITEMS];
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    items[i] = i;
+    ids[i] =
+        aabb_tree_insert(tree, &items[i], make_box((vector_t){3 * i, 0}, 1));
+  }
+  aabb_tree_remove(tree, ids[4]);
+
+  aabb_tree_t *clone = aabb_tree_clone(tree, map_to_copy, copies);
+  assert(aabb_tree_height(clone) == aabb_tree_height(tree));
+  list_t *results = list_init(1, NULL);
+  aabb_tree_query(clone, make_box((vector_t){30, 0}, 1), results);
+  assert(list_size(results) == 1 && list_get(results, 0) == &copies[10]);
+  list_free(results);
+  results = list_init(1, NULL);
+  aabb_tree_query(clone, make_box((vector_t){12, 0}, 1), results);
+  assert(list_size(results) == 0);
+  list_free(results);
+
+  // Leaf ids carry over, and the copy changes independently
+  assert(aabb_tree_move(clone, ids[10], make_box((vector_t){500, 0}, 1)));
+  results = list_init(1, NULL);
+  aabb_tree_query(tree, make_box((vector_t){30, 0}, 1), results);
+  assert(list_size(results) == 1 && list_get(results, 0) == &items[10]);
+  list_free(results);
+  aabb_tree_free(clone);
+  aabb_tree_free(tree);
+}
+
+void test_tree_raycast() {
+  aabb_tree_t *tree = aabb_tree_init(0);
+  int near, far, off;
+  aabb_tree_insert(tree, &near, make_box((vector_t){10, 0}, 1));
+  aabb_tree_insert(tree, &far, make_box((vector_t){50, 0}, 1));
+  aabb_tree_insert(tree, &off, make_box((vector_t){30, 20}, 1));
+
+  list_t *results = list_init(2, NULL);
+  aabb_tree_raycast(tree, VEC_ZERO, (vector_t){100, 0}, results);
+  assert(list_size(results) == 2);
+  assert(contains(results, &near) && contains(results, &far));
+  list_free(results);
+
+  // The segment ends before the far box
+  results = list_init(2, NULL);
+  aabb_tree_raycast(tree, VEC_ZERO, (vector_t){20, 0}, results);
+  assert(list_size(results) == 1);
+  assert(contains(results, &near));
+  list_free(results);
+
+  results = list_init(2, NULL);
+  aabb_tree_raycast(tree, (vector_t){30, 0}, (vector_t){30, 100}, results);
+  assert(list_size(results) == 1);
+  assert(contains(results, &off));
+  list_free(results);
+  aabb_tree_free(tree);
+}
+
+int main(int argc, char *argv[]) {
+  // Run all tests? True if there are no command-line arguments
+  bool all_tests = argc == 1;
+  // Read test name from file
+  char testname[100];
+  if (!all_tests) {
+    read_testname(argv[1], testname, sizeof(testname));
+  }
+
+  DO_TEST(test_tree_empty)
+  DO_TEST(test_tree_balanced)
+  DO_TEST(test_tree_move)
+  DO_TEST(test_tree_raycast)
+  DO_TEST(test_tree_clone)
+
+  puts("aabb_tree_test PASS");
+}
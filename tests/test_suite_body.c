@@ -81,6 +81,78 @@ void test_body_setters() {
   body_free(body);
 }
 
+void test_body_borrow_shape() {
+  vector_t v[] = {{1, 1}, {2, 1}, {2, 2}, {1, 2}};
+  const size_t VERTICES = sizeof(v) / sizeof(*v);
+  list_t *shape = list_init(VERTICES, free);
+  for (size_t i = 0; i < VERTICES; i++) {
+    vector_t *list_v = malloc(sizeof(*list_v));
+    *list_v = v[i];
+    list_add(shape, list_v);
+  }
+  body_t *body = body_init(shape, 1, (rgb_color_t){0, 0, 0});
+  list_t *borrowed = body_borrow_shape(body);
+  assert(list_size(borrowed) == VERTICES);
+  for (size_t i = 0; i < VERTICES; i++) {
+    assert(vec_isclose(*(vector_t *)list_get(borrowed, i), v[i]));
+  }
+  // The cached vertices follow the body when it moves
+  body_set_centroid(body, (vector_t){10, 20});
+  body_set_rotation(body, M_PI);
+  assert(body_borrow_shape(body) == borrowed);
+  assert(vec_isclose(*(vector_t *)list_get(borrowed, 0),
+                     (vector_t){10.5, 20.5}));
+  assert(vec_isclose(*(vector_t *)list_get(borrowed, 2),
+                     (vector_t){9.5, 19.5}));
+  body_free(body);
+}
+
+void test_body_sleep() {
+  const double DT = 1e-2;
+  const int REST_TICKS = 1000;
+  list_t *shape = list_init(3, free);
+  vector_t *v = malloc(sizeof(*v));
+  *v = (vector_t){+1, 0};
+  list_add(shape, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){0, +1};
+  list_add(shape, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){-1, 0};
+  list_add(shape, v);
+  body_t *body = body_init(shape, 1, (rgb_color_t){0, 0, 0});
+  assert(!body_is_asleep(body));
+  for (int i = 0; i < REST_TICKS; i++) {
+    body_tick(body, DT);
+  }
+  assert(body_is_asleep(body));
+
+  // Setting the same velocity is not a disturbance, a new one is
+  body_set_velocity(body, VEC_ZERO);
+  assert(body_is_asleep(body));
+  body_set_velocity(body, (vector_t){1, 0});
+  assert(!body_is_asleep(body));
+  vector_t centroid = body_get_centroid(body);
+  body_tick(body, DT);
+  assert(vec_isclose(body_get_centroid(body),
+                     vec_add(centroid, (vector_t){DT, 0})));
+
+  // A moving body never falls asleep
+  for (int i = 0; i < REST_TICKS; i++) {
+    body_tick(body, DT);
+  }
+  assert(!body_is_asleep(body));
+
+  body_set_velocity(body, VEC_ZERO);
+  for (int i = 0; i < REST_TICKS; i++) {
+    body_tick(body, DT);
+  }
+  assert(body_is_asleep(body));
+  body_add_impulse(body, (vector_t){0, 1});
+  assert(!body_is_asleep(body));
+  body_free(body);
+}
+
 void test_body_tick() {
   const vector_t A = {1, 2};
   const double DT = 1e-6;
@@ -122,6 +194,88 @@ void test_body_tick() {
   body_free(body);
 }
 
+void test_body_store() {
+  const double DT = 1e-2;
+  const int NUM_BODIES = 40;
+  const int TICKS = 100;
+  // Bodies ticked together in a store move exactly as they do on their own
+  body_store_t *store = body_store_init(1);
+  body_t *stored[NUM_BODIES];
+  body_t *alone[NUM_BODIES];
+  for (int i = 0; i < NUM_BODIES; i++) {
+    list_t *shape = list_init(3, free);
+    vector_t *v = malloc(sizeof(*v));
+    *v = (vector_t){+1, 0};
+    list_add(shape, v);
+    v = malloc(sizeof(*v));
+    *v = (vector_t){0, +1};
+    list_add(shape, v);
+    v = malloc(sizeof(*v));
+    *v = (vector_t){-1, 0};
+    list_add(shape, v);
+    stored[i] = body_init(shape, i + 1, (rgb_color_t){0, 0, 0});
+    body_set_centroid(stored[i], (vector_t){i, -i});
+    // Some bodies stay still and fall asleep
+    body_set_velocity(stored[i], (vector_t){i % 3 == 0 ? 0 : i, 0});
+    alone[i] = body_clone(stored[i]);
+    body_store_add(store, stored[i]);
+  }
+  assert(body_store_size(store) == NUM_BODIES);
+  for (int t = 0; t < TICKS; t++) {
+    for (int i = 0; i < NUM_BODIES; i++) {
+      if (i % 3 != 0) {
+        vector_t force = {0, -(double)t};
+        body_add_force(stored[i], force);
+        body_add_force(alone[i], force);
+      }
+      vector_t impulse = {t % 7 == 0 ? i : 0, 0};
+      body_add_impulse(stored[i], impulse);
+      body_add_impulse(alone[i], impulse);
+    }
+    body_store_integrate(store, DT);
+    for (int i = 0; i < NUM_BODIES; i++) {
+      body_finish_tick(stored[i], DT);
+      body_tick(alone[i], DT);
+    }
+  }
+  for (int i = 0; i < NUM_BODIES; i++) {
+    assert(body_hash(stored[i]) == body_hash(alone[i]));
+    assert(body_get_moves(stored[i]) == body_get_moves(alone[i]));
+  }
+  assert(body_is_asleep(stored[0]) && !body_is_asleep(stored[1]));
+
+  // Removing a body keeps its state and the state of the body moved into
+  // its place
+  body_store_remove(store, stored[0]);
+  body_store_remove(store, stored[NUM_BODIES / 2]);
+  assert(body_store_size(store) == NUM_BODIES - 2);
+  for (int i = 0; i < NUM_BODIES; i++) {
+    assert(body_hash(stored[i]) == body_hash(alone[i]));
+  }
+  body_set_velocity(stored[0], (vector_t){1, 2});
+  assert(vec_equal(body_get_velocity(stored[0]), (vector_t){1, 2}));
+  assert(!vec_equal(body_get_velocity(stored[NUM_BODIES - 1]),
+                    (vector_t){1, 2}));
+  body_free(stored[0]);
+  body_free(stored[NUM_BODIES / 2]);
+
+  // Discarding a body frees it and leaves the others' state alone
+  body_store_discard(store, stored[1]);
+  assert(body_store_size(store) == NUM_BODIES - 3);
+  for (int i = 2; i < NUM_BODIES; i++) {
+    if (i != NUM_BODIES / 2) {
+      assert(body_hash(stored[i]) == body_hash(alone[i]));
+    }
+  }
+  for (int i = 0; i < NUM_BODIES; i++) {
+    if (i > 1 && i != NUM_BODIES / 2) {
+      body_free(stored[i]);
+    }
+    body_free(alone[i]);
+  }
+  body_store_free(store);
+}
+
 void test_infinite_mass() {
   list_t *shape = list_init(10, free);
   vector_t *v = malloc(sizeof(*v));
@@ -259,7 +413,10 @@ int main(int argc, char *argv[]) {
 
   DO_TEST(test_body_init)
   DO_TEST(test_body_setters)
+  DO_TEST(test_body_borrow_shape)
+  DO_TEST(test_body_sleep)
   DO_TEST(test_body_tick)
+  DO_TEST(test_body_store)
   DO_TEST(test_infinite_mass)
   DO_TEST(test_forces)
   DO_TEST(test_body_remove)
@@ -1 +1,135 @@
-int main() {}
\ No newline at end of file
+#include "body.h"
+#include "collision.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+list_t *make_rect(vector_t min, vector_t max) {
+  list_t *rect = list_init(4, free);
+  vector_t *v = malloc(sizeof(*v));
+  *v = min;
+  list_add(rect, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){max.x, min.y};
+  list_add(rect, v);
+  v = malloc(sizeof(*v));
+  *v = max;
+  list_add(rect, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){min.x, max.y};
+  list_add(rect, v);
+  return rect;
+}
+
+// U-shaped cup: a 6x6 box with a 4x5 notch cut out of the top
+list_t *make_cup() {
+  list_t *cup = list_init(8, free);
+  vector_t points[] = {{0, 0}, {6, 0}, {6, 6}, {5, 6},
+                       {5, 1}, {1, 1}, {1, 6}, {0, 6}};
+  for (size_t i = 0; i < sizeof(points) / sizeof(*points); i++) {
+    vector_t *v = malloc(sizeof(*v));
+    *v = points[i];
+    list_add(cup, v);
+  }
+  return cup;
+}
+
+void test_bounds() {
+  list_t *cup = make_cup();
+  aabb_t box = find_bounds(cup);
+  assert(vec_equal(box.min, (vector_t){0, 0}));
+  assert(vec_equal(box.max, (vector_t){6, 6}));
+  list_free(cup);
+
+  aabb_t a = {.min = {0, 0}, .max = {2, 2}};
+  aabb_t b = {.min = {1, 1}, .max = {3, 3}};
+  aabb_t c = {.min = {2.5, 0}, .max = {3, 1}};
+  assert(aabb_overlap(a, b));
+  assert(aabb_overlap(b, a));
+  assert(!aabb_overlap(a, c));
+  assert(aabb_overlap(b, c));
+}
+
+void test_sweep() {
+  aabb_t box = {.min = {0, 0}, .max = {2, 2}};
+  aabb_t wall = {.min = {10, -5}, .max = {11, 5}};
+  // Passes straight through the wall within the sweep
+  sweep_info_t sweep = aabb_sweep(box, (vector_t){20, 0}, wall);
+  assert(sweep.hit);
+  assert(isclose(sweep.time, 0.4));
+  assert(vec_equal(sweep.normal, (vector_t){-1, 0}));
+  // Stops short of it, or moves away from it
+  assert(!aabb_sweep(box, (vector_t){5, 0}, wall).hit);
+  assert(!aabb_sweep(box, (vector_t){-20, 0}, wall).hit);
+  // Passes above it
+  assert(!aabb_sweep(box, (vector_t){20, 40}, wall).hit);
+  // Diagonal motion hits the top face
+  aabb_t floor = {.min = {-10, -3}, .max = {10, -1}};
+  sweep = aabb_sweep(box, (vector_t){2, -4}, floor);
+  assert(sweep.hit);
+  assert(isclose(sweep.time, 0.25));
+  assert(vec_equal(sweep.normal, (vector_t){0, 1}));
+  // Boxes that already overlap are left to the narrowphase
+  assert(!aabb_sweep(box, (vector_t){0, -4}, (aabb_t){{-1, -1}, {3, 1}}).hit);
+}
+
+void test_convex_collision() {
+  list_t *r1 = make_rect((vector_t){0, 0}, (vector_t){2, 2});
+  list_t *r2 = make_rect((vector_t){1.5, 0.5}, (vector_t){3.5, 1.5});
+  collision_info_t collide = find_collision(r1, r2);
+  assert(collide.collided);
+  assert(isclose(collide.depth, 0.5));
+  assert(vec_isclose(collide.axis, (vector_t){1, 0}));
+  list_free(r2);
+
+  r2 = make_rect((vector_t){3, 0}, (vector_t){4, 1});
+  assert(!find_collision(r1, r2).collided);
+  list_free(r1);
+  list_free(r2);
+}
+
+void test_concave_body_collision() {
+  body_t *cup = body_init(make_cup(), 1, (rgb_color_t){0, 0, 0});
+  assert(body_get_pieces(cup) != NULL);
+
+  // Sits inside the notch: the convex hulls overlap but the bodies do not
+  body_t *box = body_init(make_rect((vector_t){2, 2}, (vector_t){4, 4}), 1,
+                          (rgb_color_t){0, 0, 0});
+  assert(body_get_pieces(box) == NULL);
+  assert(!find_body_collision(cup, box).collided);
+  assert(!find_body_collision(box, cup).collided);
+
+  // Slide it into the right wall
+  body_set_centroid(box, (vector_t){4.25, 3});
+  collision_info_t collide = find_body_collision(box, cup);
+  assert(collide.collided);
+  assert(isclose(collide.depth, 0.25));
+  assert(vec_isclose(collide.axis, (vector_t){1, 0}));
+
+  // The pieces follow the body when it moves
+  body_set_centroid(box, (vector_t){3, 3});
+  assert(!find_body_collision(cup, box).collided);
+  body_set_centroid(cup, vec_add(body_get_centroid(cup), (vector_t){1.5, 0}));
+  assert(find_body_collision(cup, box).collided);
+
+  body_free(cup);
+  body_free(box);
+}
+
+int main(int argc, char *argv[]) {
+  // Run all tests? True if there are no command-line arguments
+  bool all_tests = argc == 1;
+  // Read test name from file
+  char testname[100];
+  if (!all_tests) {
+    read_testname(argv[1], testname, sizeof(testname));
+  }
+
+  DO_TEST(test_bounds)
+  DO_TEST(test_sweep)
+  DO_TEST(test_convex_collision)
+  DO_TEST(test_concave_body_collision)
+
+  puts("collision_test PASS");
+}
@@ -0,0 +1,126 @@
+#include "contact_cache.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+list_t *make_square() {
+  list_t *square = list_init(4, free);
+  vector_t *v = malloc(sizeof(*v));
+  *v = (vector_t){-1, -1};
+  list_add(square, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){+1, -1};
+  list_add(square, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){+1, +1};
+  list_add(square, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){-1, +1};
+  list_add(square, v);
+  return square;
+}
+
+void test_events() {
+  contact_cache_t *cache = contact_cache_init();
+  body_t *body1 = body_init(make_square(), 1, (rgb_color_t){0, 0, 0});
+  body_t *body2 = body_init(make_square(), 1, (rgb_color_t){0, 0, 0});
+  body_set_centroid(body2, (vector_t){5, 0});
+
+  assert(contact_cache_collide(cache, body1, body2).event == CONTACT_NONE);
+  contact_cache_begin_tick(cache);
+  body_set_centroid(body2, (vector_t){1.5, 0});
+  contact_result_t result = contact_cache_collide(cache, body1, body2);
+  assert(result.event == CONTACT_ENTER);
+  assert(result.collision.collided);
+  assert(isclose(result.collision.depth, 0.5));
+  // Checking again in the same tick, in either order, reports the same event
+  assert(contact_cache_collide(cache, body1, body2).event == CONTACT_ENTER);
+  contact_result_t swapped = contact_cache_collide(cache, body2, body1);
+  assert(swapped.event == CONTACT_ENTER);
+  assert(vec_isclose(swapped.collision.axis,
+                     vec_negate(result.collision.axis)));
+
+  contact_cache_begin_tick(cache);
+  assert(contact_cache_collide(cache, body1, body2).event == CONTACT_STAY);
+  contact_cache_begin_tick(cache);
+  body_set_centroid(body2, (vector_t){5, 0});
+  assert(contact_cache_collide(cache, body1, body2).event == CONTACT_EXIT);
+  contact_cache_begin_tick(cache);
+  assert(contact_cache_collide(cache, body1, body2).event == CONTACT_NONE);
+
+  contact_cache_free(cache);
+  body_free(body1);
+  body_free(body2);
+}
+
+void test_reuse() {
+  contact_cache_t *cache = contact_cache_init();
+  body_t *body1 = body_init(make_square(), 1, (rgb_color_t){0, 0, 0});
+  body_t *body2 = body_init(make_square(), 1, (rgb_color_t){0, 0, 0});
+  body_set_centroid(body2, (vector_t){0, 1.5});
+
+  assert(contact_cache_collide(cache, body1, body2).collision.collided);
+  assert(contact_cache_reused(cache) == 0);
+  contact_cache_begin_tick(cache);
+  assert(contact_cache_collide(cache, body1, body2).collision.collided);
+  assert(contact_cache_reused(cache) == 1);
+  // Moving either body invalidates the cached result
+  body_set_centroid(body1, (vector_t){0, -1});
+  assert(!contact_cache_collide(cache, body1, body2).collision.collided);
+  assert(contact_cache_reused(cache) == 1);
+  contact_cache_begin_tick(cache);
+  assert(contact_cache_reused(cache) == 0);
+
+  contact_cache_free(cache);
+  body_free(body1);
+  body_free(body2);
+}
+
+void test_impulses() {
+  contact_cache_t *cache = contact_cache_init();
+  body_t *body1 = body_init(make_square(), 1, (rgb_color_t){0, 0, 0});
+  body_t *body2 = body_init(make_square(), 1, (rgb_color_t){0, 0, 0});
+  body_t *body3 = body_init(make_square(), 1, (rgb_color_t){0, 0, 0});
+
+  contact_cache_set_impulse(cache, body1, body2, 3);
+  contact_cache_set_impulse(cache, body3, body2, 4);
+  assert(contact_cache_size(cache) == 2);
+  assert(contact_cache_get_impulse(cache, body2, body1) == 3);
+  assert(contact_cache_previous_impulse(cache, body1, body2) == 0);
+
+  contact_cache_begin_tick(cache);
+  assert(contact_cache_get_impulse(cache, body1, body2) == 0);
+  assert(contact_cache_previous_impulse(cache, body1, body2) == 3);
+  assert(contact_cache_previous_impulse(cache, body2, body3) == 4);
+  contact_cache_forget(cache, body3);
+  assert(contact_cache_size(cache) == 1);
+  assert(contact_cache_previous_impulse(cache, body2, body3) == 0);
+
+  // Pairs that are apart and no longer checked are dropped
+  contact_cache_begin_tick(cache);
+  assert(contact_cache_previous_impulse(cache, body1, body2) == 0);
+  contact_cache_begin_tick(cache);
+  assert(contact_cache_size(cache) == 0);
+
+  contact_cache_free(cache);
+  body_free(body1);
+  body_free(body2);
+  body_free(body3);
+}
+
+int main(int argc, char *argv[]) {
+  // Run all tests? True if there are no command-line arguments
+  bool all_tests = argc == 1;
+  // Read test name from file
+  char testname[100];
+  if (!all_tests) {
+    read_testname(argv[1], testname, sizeof(testname));
+  }
+
+  DO_TEST(test_events)
+  DO_TEST(test_reuse)
+  DO_TEST(test_impulses)
+
+  puts("contact_cache_test PASS");
+}
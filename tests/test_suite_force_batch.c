@@ -0,0 +1,113 @@
+#include "force_batch.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+list_t *make_square() {
+  list_t *square = list_init(4, free);
+  vector_t *v = malloc(sizeof(*v));
+  *v = (vector_t){-1, -1};
+  list_add(square, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){+1, -1};
+  list_add(square, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){+1, +1};
+  list_add(square, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){-1, +1};
+  list_add(square, v);
+  return square;
+}
+
+// Each kind applies the same force as its force creator in forces.c
+void test_apply_kinds() {
+  const double DT = 1;
+  body_t *body = body_init(make_square(), 2, (rgb_color_t){0, 0, 0});
+  body_t *other = body_init(make_square(), 1, (rgb_color_t){0, 0, 0});
+  body_set_centroid(other, (vector_t){10, 0});
+  body_set_velocity(body, (vector_t){3, 0});
+  force_batch_t *batch = force_batch_init();
+  force_batch_add(batch, FORCE_DRAG, 1, body, NULL);
+  force_batch_add(batch, FORCE_FALL, 10, body, NULL);
+  force_batch_add(batch, FORCE_SPRING, 2, body, other);
+  force_batch_add(batch, FORCE_GRAVITY, 1, body, other);
+  assert(force_batch_size(batch, FORCE_SPRING) == 1);
+  assert(force_batch_size(batch, FORCE_PLAT) == 0);
+
+  size_t skipped = 0;
+  size_t run = 0;
+  run += force_batch_apply(batch, FORCE_DRAG, NULL, &skipped);
+  run += force_batch_apply(batch, FORCE_FALL, NULL, &skipped);
+  run += force_batch_apply(batch, FORCE_SPRING, NULL, &skipped);
+  run += force_batch_apply(batch, FORCE_GRAVITY, NULL, &skipped);
+  assert(run == 4 && skipped == 0);
+  body_tick(body, DT);
+  body_tick(other, DT);
+  // drag (-3, 0), weight (0, -20), spring (20, 0), gravity (0.02, 0)
+  assert(vec_isclose(body_get_velocity(body),
+                     (vector_t){3 + 17.02 / 2, -20.0 / 2}));
+  assert(vec_isclose(body_get_velocity(other), (vector_t){-0.02, 0}));
+
+  force_batch_free(batch);
+  body_free(body);
+  body_free(other);
+}
+
+void test_skip_and_remove() {
+  body_t *body = body_init(make_square(), 1, (rgb_color_t){0, 0, 0});
+  body_t *other = body_init(make_square(), 1, (rgb_color_t){0, 0, 0});
+  body_t *wall = body_init(make_square(), INFINITY, (rgb_color_t){0, 0, 0});
+  force_batch_t *batch = force_batch_init();
+  force_batch_add(batch, FORCE_DRAG, 1, wall, NULL);
+  force_batch_add(batch, FORCE_DRAG, 1, body, NULL);
+  force_batch_add(batch, FORCE_DRAG, 1, other, NULL);
+  force_batch_add(batch, FORCE_SPRING, 1, body, other);
+
+  // Forces on bodies that cannot move are skipped, unless the other body can
+  body_sleep(body);
+  size_t skipped = 0;
+  assert(force_batch_apply(batch, FORCE_DRAG, NULL, &skipped) == 1);
+  assert(skipped == 2);
+  assert(force_batch_apply(batch, FORCE_SPRING, NULL, &skipped) == 1);
+  assert(skipped == 2);
+
+  // Islands are joined through the forces between two bodies
+  list_t *bodies = list_init(3, NULL);
+  list_add(bodies, body);
+  list_add(bodies, other);
+  list_add(bodies, wall);
+  islands_t *islands = islands_init();
+  islands_reset(islands, bodies);
+  force_batch_connect(batch, islands);
+  assert(islands_finish(islands) == 1);
+  islands_free(islands);
+  list_free(bodies);
+
+  force_batch_remove_with(batch, body);
+  assert(force_batch_size(batch, FORCE_DRAG) == 2);
+  assert(force_batch_size(batch, FORCE_SPRING) == 0);
+  force_batch_remove_with(batch, wall);
+  assert(force_batch_size(batch, FORCE_DRAG) == 1);
+
+  force_batch_free(batch);
+  body_free(body);
+  body_free(other);
+  body_free(wall);
+}
+
+int main(int argc, char *argv[]) {
+  // Run all tests? True if there are no command-line arguments
+  bool all_tests = argc == 1;
+  // Read test name from file
+  char testname[100];
+  if (!all_tests) {
+    read_testname(argv[1], testname, sizeof(testname));
+  }
+
+  DO_TEST(test_apply_kinds)
+  DO_TEST(test_skip_and_remove)
+
+  puts("force_batch_test PASS");
+}
@@ -1,4 +1,6 @@
+#include "draw.h"
 #include "forces.h"
+#include "info.h"
 #include "test_util.h"
 #include <assert.h>
 #include <math.h>
@@ -150,6 +152,324 @@ void test_forces_removed() {
   scene_free(scene);
 }
 
+// Tests that a falling box lands on static floors and is stopped by walls
+void check_static_plat_collision(broadphase_t broadphase) {
+  const double G = 100;
+  const double DT = 1e-3;
+  const int STEPS = 2000;
+  scene_t *scene = scene_init();
+  scene_set_broadphase(scene, broadphase);
+  body_t *box = body_init_more_info(draw_rect((vector_t){5, 10}, 2, 2), 1,
+                                    (rgb_color_t){0, 0, 0}, 2, 2);
+  scene_add_body(scene, box);
+  for (int i = 0; i < 10; i++) {
+    // A row of floor tiles, plus far away walls that never get close
+    scene_add_static_body(
+        scene, body_init_more_info(draw_rect((vector_t){i * 20 - 90, -1}, 20, 2),
+                                   INFINITY, (rgb_color_t){0, 0, 0}, 20, 2));
+    scene_add_static_body(
+        scene, body_init_more_info(draw_rect((vector_t){500, i * 20}, 2, 20),
+                                   INFINITY, (rgb_color_t){0, 0, 0}, 2, 20));
+  }
+  assert(scene_static_bodies(scene) == 20);
+  create_fall(scene, G, box);
+  // One force covers every static body
+  create_static_plat_collision(scene, box);
+  for (int i = 0; i < STEPS; i++) {
+    scene_tick(scene, DT);
+  }
+  // Platforms let bodies sink up to one unit before pushing them back out
+  assert(body_get_centroid(box).y > 0);
+  assert(body_get_centroid(box).y < 2);
+  assert(fabs(body_get_velocity(box).y) <= G * DT);
+
+  // Only the floor under the box is near it
+  list_t *nearby = list_init(1, NULL);
+  scene_query_static(scene, find_bounds(body_borrow_shape(box)), nearby);
+  assert(list_size(nearby) == 1);
+  list_free(nearby);
+  nearby = list_init(1, NULL);
+  scene_query_static_near(scene, box, nearby);
+  assert(list_size(nearby) == 1);
+  list_free(nearby);
+  scene_free(scene);
+}
+
+void test_static_plat_collision() {
+  check_static_plat_collision(BROADPHASE_GRID);
+  check_static_plat_collision(BROADPHASE_SAP);
+  check_static_plat_collision(BROADPHASE_TREE);
+}
+
+void test_stacked_contacts() {
+  const double G = 100;
+  const double DT = 1e-2;
+  const int STEPS = 300;
+  scene_t *scene = scene_init();
+  scene_add_static_body(
+      scene, body_init_more_info(draw_rect((vector_t){0, -1}, 40, 2), INFINITY,
+                                 (rgb_color_t){0, 0, 0}, 40, 2));
+  // A player standing on a heavier block standing on the floor
+  body_t *block = body_init_more_info(draw_rect((vector_t){0, 2}, 4, 4), 2,
+                                      (rgb_color_t){0, 0, 0}, 4, 4);
+  body_t *player = body_init_more_info(draw_rect((vector_t){0, 5}, 2, 2), 1,
+                                       (rgb_color_t){0, 0, 0}, 2, 2);
+  scene_add_body(scene, block);
+  scene_add_body(scene, player);
+  create_fall(scene, G, block);
+  create_fall(scene, G, player);
+  create_static_plat_collision(scene, block);
+  create_static_plat_collision(scene, player);
+  create_plat_collision(scene, player, block);
+  const int SETTLE_STEPS = 10;
+  for (int i = 0; i < SETTLE_STEPS; i++) {
+    scene_tick(scene, DT);
+  }
+  assert(scene_get_stats(scene).contacts == 2);
+  // Neither body is moving, so the narrowphase results are reused
+  assert(scene_get_stats(scene).collisions_cached > 0);
+  // The block carries the player's weight
+  assert(isclose(scene_get_contact_impulse(scene, player, block), G * DT));
+  assert(fabs(body_get_velocity(block).y) < 1e-6);
+  assert(fabs(body_get_velocity(player).y) < 1e-6);
+
+  // The stack comes to rest and falls asleep
+  for (int i = SETTLE_STEPS; i < STEPS; i++) {
+    scene_tick(scene, DT);
+  }
+  assert(body_is_asleep(block) && body_is_asleep(player));
+  assert(fabs(body_get_centroid(block).y - 2) < 1);
+  assert(fabs(body_get_centroid(player).y - 5) < 1);
+  scene_free(scene);
+}
+
+void test_fast_body_stops_at_wall() {
+  const double DT = 0.1;
+  scene_t *scene = scene_init();
+  // A wall much thinner than the distance the ball covers in one tick
+  scene_add_static_body(
+      scene, body_init_more_info(draw_rect((vector_t){100, 0}, 4, 100),
+                                 INFINITY, (rgb_color_t){0, 0, 0}, 4, 100));
+  body_t *ball = body_init_more_info(draw_rect((vector_t){60, 0}, 10, 10), 1,
+                                     (rgb_color_t){0, 0, 0}, 10, 10);
+  scene_add_body(scene, ball);
+  create_static_plat_collision(scene, ball);
+  body_set_velocity(ball, (vector_t){1000, 0});
+  scene_tick(scene, DT);
+  assert(scene_get_stats(scene).bodies_swept == 1);
+  // It stops against the near face of the wall
+  assert(isclose(body_get_centroid(ball).x, 93));
+  assert(body_get_velocity(ball).x <= 0);
+  for (int i = 0; i < 10; i++) {
+    scene_tick(scene, DT);
+  }
+  assert(body_get_centroid(ball).x < 100);
+  scene_free(scene);
+}
+
+void test_islands() {
+  const double DT = 1e-2;
+  scene_t *scene = scene_init();
+  body_t *anchor = body_init(make_shape(), INFINITY, (rgb_color_t){0, 0, 0});
+  body_t *spring1 = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_t *spring2 = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_t *loner = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_set_centroid(spring1, (vector_t){10, 0});
+  body_set_centroid(spring2, (vector_t){-10, 0});
+  scene_add_body(scene, anchor);
+  scene_add_body(scene, spring1);
+  scene_add_body(scene, spring2);
+  scene_add_body(scene, loner);
+  // Both springs hang off the same fixed anchor, which does not join them
+  create_spring(scene, 1, spring1, anchor);
+  create_spring(scene, 1, spring2, anchor);
+  create_drag(scene, 1, loner);
+  scene_tick(scene, DT);
+  assert(scene_get_stats(scene).islands == 3);
+  assert(!scene_same_island(scene, spring1, spring2));
+  assert(!scene_same_island(scene, spring1, anchor));
+
+  create_spring(scene, 1, spring1, spring2);
+  scene_tick(scene, DT);
+  assert(scene_get_stats(scene).islands == 2);
+  assert(scene_same_island(scene, spring1, spring2));
+  assert(!scene_same_island(scene, spring1, loner));
+  // The lone body is at rest and sleeps without waiting for the springs
+  for (int i = 0; i < 100; i++) {
+    scene_tick(scene, DT);
+  }
+  assert(body_is_asleep(loner));
+  assert(!body_is_asleep(spring1) && !body_is_asleep(spring2));
+  assert(scene_get_stats(scene).sleeping_islands == 1);
+  scene_free(scene);
+}
+
+void test_clone() {
+  const double G = 100;
+  const double DT = 1e-2;
+  const int STEPS = 50;
+  scene_t *scene = scene_init();
+  scene_add_static_body(
+      scene, body_init_more_info(draw_rect((vector_t){0, -1}, 40, 2), INFINITY,
+                                 (rgb_color_t){0, 0, 0}, 40, 2));
+  body_t *block = body_init_more_info(draw_rect((vector_t){0, 4}, 4, 4), 2,
+                                      (rgb_color_t){0, 0, 0}, 4, 4);
+  body_t *ball = body_init_more_info(draw_rect((vector_t){10, 4}, 2, 2), 1,
+                                     (rgb_color_t){0, 0, 0}, 2, 2);
+  body_t *target = body_init_more_info(draw_rect((vector_t){20, 4}, 2, 2), 1,
+                                       (rgb_color_t){0, 0, 0}, 2, 2);
+  scene_add_body(scene, block);
+  scene_add_body(scene, ball);
+  scene_add_body(scene, target);
+  create_fall(scene, G, block);
+  create_static_plat_collision(scene, block);
+  create_destructive_collision(scene, ball, target);
+  body_set_velocity(ball, (vector_t){100, 0});
+
+  // The clone runs the same future without touching the original
+  scene_t *clone = scene_clone(scene);
+  assert(clone != NULL);
+  assert(scene_bodies(clone) == 3);
+  body_t *block_copy = scene_find_clone(clone, block);
+  assert(block_copy != NULL && block_copy != block);
+  for (int i = 0; i < STEPS; i++) {
+    scene_tick(clone, DT);
+  }
+  assert(scene_bodies(clone) == 1);
+  assert(scene_bodies(scene) == 3);
+  assert(vec_isclose(body_get_centroid(block), (vector_t){0, 4}));
+  for (int i = 0; i < STEPS; i++) {
+    scene_tick(scene, DT);
+  }
+  assert(scene_bodies(scene) == 1);
+  assert(vec_isclose(body_get_centroid(block), body_get_centroid(block_copy)));
+  scene_free(clone);
+
+  // Handlers with auxiliary values nobody knows how to copy stop a clone
+  body_t *other = body_init_more_info(draw_rect((vector_t){30, 4}, 2, 2), 1,
+                                      (rgb_color_t){0, 0, 0}, 2, 2);
+  scene_add_body(scene, other);
+  create_collision(scene, block, other, destructive_handler, malloc(1), free);
+  assert(scene_clone(scene) == NULL);
+  scene_free(scene);
+}
+
+// A clone made while bodies touch carries on like the original, rather
+// than seeing the contact begin again
+void test_clone_touching() {
+  const double DT = 0.01;
+  const double V = 10;
+  scene_t *scene = scene_init();
+  body_t *ball = body_init_with_info(make_shape(), 1, (rgb_color_t){0, 0, 0},
+                                     info_init(2), (free_func_t)info_free);
+  body_t *wall =
+      body_init_with_info(make_shape(), INFINITY, (rgb_color_t){0, 0, 0},
+                          info_init(2), (free_func_t)info_free);
+  body_set_centroid(wall, (vector_t){3, 0});
+  body_set_velocity(ball, (vector_t){V, 0});
+  scene_add_body(scene, ball);
+  scene_add_body(scene, wall);
+  create_physics_collision(scene, 0, ball, wall);
+  // Keeps pushing the ball into the wall once it has stopped
+  scene_add_field(scene, (force_field_t){.kind = FIELD_UNIFORM,
+                                         .force = {V, 0},
+                                         .mass_scaled = true});
+  for (size_t i = 0; i < 15; i++) {
+    scene_tick(scene, DT);
+  }
+  assert(body_get_velocity(ball).x > 0);
+
+  scene_t *clone = scene_clone(scene);
+  for (size_t i = 0; i < 10; i++) {
+    scene_tick(scene, DT);
+    scene_tick(clone, DT);
+    assert(scene_hash(clone) == scene_hash(scene));
+  }
+  // The copies hold on to the textures and info they share
+  scene_free(scene);
+  scene_tick(clone, DT);
+  assert(get_typ(body_get_info(scene_get_body(clone, 0))) == 2);
+  scene_free(clone);
+}
+
+// A ball bounces off each wall it was given a batched collision with
+void test_physics_collisions_batch() {
+  const double DT = 0.01;
+  const double V = 10;
+  scene_t *scene = scene_init();
+  body_t *ball = body_init_with_info(make_shape(), 1, (rgb_color_t){0, 0, 0},
+                                     info_init(2), (free_func_t)info_free);
+  body_set_velocity(ball, (vector_t){V, 0});
+  scene_add_body(scene, ball);
+  body_t *walls[2];
+  for (size_t i = 0; i < 2; i++) {
+    walls[i] =
+        body_init_with_info(make_shape(), INFINITY, (rgb_color_t){0, 0, 0},
+                            info_init(2), (free_func_t)info_free);
+    body_set_centroid(walls[i], (vector_t){i == 0 ? -5 : 5, 0});
+  }
+  scene_add_bodies_n(scene, walls, 2, NULL);
+  create_physics_collisions_batch(scene, 1.0, ball, walls, 2);
+  // Off the right wall
+  for (size_t i = 0; i < 50; i++) {
+    scene_tick(scene, DT);
+  }
+  assert(vec_isclose(body_get_velocity(ball), (vector_t){-V, 0}));
+  // and then the left one
+  for (size_t i = 0; i < 60; i++) {
+    scene_tick(scene, DT);
+  }
+  assert(vec_isclose(body_get_velocity(ball), (vector_t){V, 0}));
+  scene_free(scene);
+}
+
+void test_pulley_tilted() {
+  const double G = 100;
+  const double DT = 1e-2;
+  scene_t *scene = scene_init();
+  body_t *pulley1 = body_init_more_info(draw_rect((vector_t){0, 0}, 20, 2),
+                                        10, (rgb_color_t){0, 0, 0}, 20, 2);
+  body_t *pulley2 = body_init_more_info(draw_rect((vector_t){40, 0}, 20, 2),
+                                        10, (rgb_color_t){0, 0, 0}, 20, 2);
+  body_t *player = body_init_more_info(draw_rect((vector_t){0, 1.5}, 2, 2), 1,
+                                       (rgb_color_t){0, 0, 0}, 2, 2);
+  // The contact axis is not exactly vertical, but the player is still on top
+  body_set_rotation(pulley1, 0.05);
+  scene_add_body(scene, pulley1);
+  scene_add_body(scene, pulley2);
+  scene_add_body(scene, player);
+  create_fall(scene, G, player);
+  create_pulley_collision(scene, player, 1, pulley1, pulley2);
+  scene_tick(scene, DT);
+  // The player's weight pulls its platform down and the other one up, and
+  // the player rides down with its platform
+  assert(body_get_velocity(pulley1).y < 0);
+  assert(isclose(body_get_velocity(pulley2).y, -body_get_velocity(pulley1).y));
+  assert(isclose(body_get_velocity(player).y, body_get_velocity(pulley1).y));
+  scene_free(scene);
+}
+
+void test_fan_substeps() {
+  const double DT = 0.01;
+  const double K = 10;
+  for (size_t max_substeps = 1; max_substeps <= 8; max_substeps *= 8) {
+    scene_t *scene = scene_init();
+    scene_set_max_substeps(scene, max_substeps);
+    // Stiff enough to split every tick into the most substeps
+    scene_add_stiffness(scene, 1e8);
+    body_t *body = body_init(make_shape(), 2, (rgb_color_t){0, 0, 0});
+    body_t *fan = body_init(make_shape(), INFINITY, (rgb_color_t){0, 0, 0});
+    scene_add_body(scene, body);
+    scene_add_body(scene, fan);
+    create_fan(scene, K, body, fan, 0);
+    scene_tick(scene, DT);
+    assert(scene_get_stats(scene).substeps == max_substeps);
+    // The fan gives the same push however the tick is split
+    assert(vec_isclose(body_get_velocity(body), (vector_t){0, K}));
+    scene_free(scene);
+  }
+}
+
 int main(int argc, char *argv[]) {
   // Run all tests if there are no command-line arguments
   bool all_tests = argc == 1;
@@ -163,6 +483,15 @@ int main(int argc, char *argv[]) {
   DO_TEST(test_energy_conservation)
   DO_TEST(test_collisions)
   DO_TEST(test_forces_removed)
+  DO_TEST(test_static_plat_collision)
+  DO_TEST(test_stacked_contacts)
+  DO_TEST(test_fast_body_stops_at_wall)
+  DO_TEST(test_islands)
+  DO_TEST(test_clone)
+  DO_TEST(test_clone_touching)
+  DO_TEST(test_physics_collisions_batch)
+  DO_TEST(test_pulley_tilted)
+  DO_TEST(test_fan_substeps)
 
   puts("forces_test PASS");
 }
@@ -0,0 +1,102 @@
+#include "grid.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+body_t *make_box(vector_t min, vector_t max) {
+  list_t *rect = list_init(4, free);
+  vector_t *v = malloc(sizeof(*v));
+  *v = min;
+  list_add(rect, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){max.x, min.y};
+  list_add(rect, v);
+  v = malloc(sizeof(*v));
+  *v = max;
+  list_add(rect, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){min.x, max.y};
+  list_add(rect, v);
+  return body_init(rect, INFINITY, (rgb_color_t){0, 0, 0});
+}
+
+bool contains(list_t *list, void *item) {
+  for (size_t i = 0; i < list_size(list); i++) {
+    if (list_get(list, i) == item) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void test_empty_grid() {
+  grid_t *grid = grid_init(10);
+  list_t *results = list_init(1, NULL);
+  grid_query(grid, (aabb_t){{0, 0}, {100, 100}}, results);
+  assert(list_size(results) == 0);
+  list_free(results);
+  grid_free(grid);
+}
+
+void test_grid_query() {
+  list_t *bodies = list_init(3, (free_func_t)body_free);
+  // A long thin platform spanning many cells, and two small boxes
+  body_t *platform = make_box((vector_t){0, 0}, (vector_t){800, 10});
+  body_t *left = make_box((vector_t){5, 50}, (vector_t){15, 60});
+  body_t *right = make_box((vector_t){700, 300}, (vector_t){720, 320});
+  list_add(bodies, platform);
+  list_add(bodies, left);
+  list_add(bodies, right);
+  grid_t *grid = grid_init(25);
+  grid_build(grid, bodies);
+
+  list_t *results = list_init(1, NULL);
+  grid_query(grid, (aabb_t){{0, 5}, {20, 55}}, results);
+  assert(list_size(results) == 2);
+  assert(contains(results, platform));
+  assert(contains(results, left));
+  list_free(results);
+
+  // The platform is reported once even though the box covers many of its cells
+  results = list_init(1, NULL);
+  grid_query(grid, (aabb_t){{-50, -50}, {1000, 20}}, results);
+  assert(list_size(results) == 1);
+  assert(contains(results, platform));
+  list_free(results);
+
+  // Boxes outside the grid are clamped onto it but still checked
+  results = list_init(1, NULL);
+  grid_query(grid, (aabb_t){{2000, 2000}, {2100, 2100}}, results);
+  assert(list_size(results) == 0);
+  grid_query(grid, (aabb_t){{710, 310}, {2000, 2000}}, results);
+  assert(list_size(results) == 1);
+  assert(contains(results, right));
+  list_free(results);
+
+  // Rebuilding replaces the previous contents
+  body_free(list_remove(bodies, 0));
+  grid_build(grid, bodies);
+  results = list_init(1, NULL);
+  grid_query(grid, (aabb_t){{0, 0}, {800, 10}}, results);
+  assert(list_size(results) == 0);
+  list_free(results);
+
+  grid_free(grid);
+  list_free(bodies);
+}
+
+int main(int argc, char *argv[]) {
+  // Run all tests? True if there are no command-line arguments
+  bool all_tests = argc == 1;
+  // Read test name from file
+  char testname[100];
+  if (!all_tests) {
+    read_testname(argv[1], testname, sizeof(testname));
+  }
+
+  DO_TEST(test_empty_grid)
+  DO_TEST(test_grid_query)
+
+  puts("grid_test PASS");
+}
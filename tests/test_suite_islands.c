@@ -0,0 +1,121 @@
+#include "islands.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+list_t *make_square() {
+  list_t *square = list_init(4, free);
+  vector_t *v = malloc(sizeof(*v));
+  *v = (vector_t){-1, -1};
+  list_add(square, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){+1, -1};
+  list_add(square, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){+1, +1};
+  list_add(square, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){-1, +1};
+  list_add(square, v);
+  return square;
+}
+
+void test_grouping() {
+  const size_t NUM_BODIES = 6;
+  list_t *bodies = list_init(NUM_BODIES, (free_func_t)body_free);
+  for (size_t i = 0; i < NUM_BODIES; i++) {
+    list_add(bodies, body_init(make_square(), 1, (rgb_color_t){0, 0, 0}));
+  }
+  body_t *wall = body_init(make_square(), INFINITY, (rgb_color_t){0, 0, 0});
+  list_add(bodies, wall);
+  islands_t *islands = islands_init();
+
+  islands_reset(islands, bodies);
+  assert(islands_finish(islands) == NUM_BODIES);
+  assert(!islands_same(islands, list_get(bodies, 0), list_get(bodies, 1)));
+
+  // 0 - 1 - 2 in a chain, 3 and 4 both touching the wall, 5 alone
+  islands_reset(islands, bodies);
+  islands_connect(islands, list_get(bodies, 0), list_get(bodies, 1));
+  islands_connect(islands, list_get(bodies, 2), list_get(bodies, 1));
+  islands_connect(islands, list_get(bodies, 3), wall);
+  islands_connect(islands, wall, list_get(bodies, 4));
+  assert(islands_finish(islands) == 4);
+  assert(islands_same(islands, list_get(bodies, 0), list_get(bodies, 2)));
+  assert(!islands_same(islands, list_get(bodies, 3), list_get(bodies, 4)));
+  assert(!islands_same(islands, list_get(bodies, 3), wall));
+
+  // A force acting on several bodies joins them all, even through the wall
+  islands_reset(islands, bodies);
+  list_t *acted_on = list_init(3, NULL);
+  list_add(acted_on, wall);
+  list_add(acted_on, list_get(bodies, 3));
+  list_add(acted_on, list_get(bodies, 5));
+  islands_connect_all(islands, acted_on);
+  assert(islands_finish(islands) == NUM_BODIES - 1);
+  assert(islands_same(islands, list_get(bodies, 3), list_get(bodies, 5)));
+  islands_forget(islands, list_get(bodies, 5));
+  assert(!islands_same(islands, list_get(bodies, 3), list_get(bodies, 5)));
+
+  list_free(acted_on);
+  islands_free(islands);
+  list_free(bodies);
+}
+
+void test_island_sleep() {
+  const double DT = 1e-2;
+  list_t *bodies = list_init(2, (free_func_t)body_free);
+  body_t *resting = body_init(make_square(), 1, (rgb_color_t){0, 0, 0});
+  body_t *moving = body_init(make_square(), 1, (rgb_color_t){0, 0, 0});
+  list_add(bodies, resting);
+  list_add(bodies, moving);
+  islands_t *islands = islands_init();
+
+  // The resting body falls asleep on its own, but its moving neighbour
+  // wakes it again
+  body_set_velocity(moving, (vector_t){1, 0});
+  bool ever_asleep = false;
+  for (int i = 0; i < 100; i++) {
+    islands_reset(islands, bodies);
+    islands_connect(islands, resting, moving);
+    islands_finish(islands);
+    body_tick(resting, DT);
+    body_tick(moving, DT);
+    ever_asleep = ever_asleep || body_is_asleep(resting);
+    assert(islands_update_sleep(islands) == 0);
+    assert(!body_is_asleep(resting));
+  }
+  assert(ever_asleep);
+
+  // Once both rest, the first to fall asleep takes the other with it
+  body_set_velocity(moving, VEC_ZERO);
+  body_tick(moving, DT);
+  body_tick(moving, DT);
+  size_t asleep = 0;
+  for (int i = 0; i < 100 && asleep == 0; i++) {
+    body_tick(resting, DT);
+    body_tick(moving, DT);
+    asleep = islands_update_sleep(islands);
+  }
+  assert(asleep == 1);
+  assert(body_is_asleep(resting) && body_is_asleep(moving));
+
+  islands_free(islands);
+  list_free(bodies);
+}
+
+int main(int argc, char *argv[]) {
+  // Run all tests? True if there are no command-line arguments
+  bool all_tests = argc == 1;
+  // Read test name from file
+  char testname[100];
+  if (!all_tests) {
+    read_testname(argv[1], testname, sizeof(testname));
+  }
+
+  DO_TEST(test_grouping)
+  DO_TEST(test_island_sleep)
+
+  puts("islands_test PASS");
+}
@@ -152,6 +152,111 @@ void test_list_large_add_remove() {
   list_free(l);
 }
 
+// Swap-removing moves the last element into the gap
+void test_swap_remove() {
+  list_t *l = list_init(4, free);
+  for (size_t i = 0; i < 4; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    v->x = v->y = i;
+    list_add(l, v);
+  }
+  vector_t *v = list_swap_remove(l, 1);
+  assert(vec_equal(*v, (vector_t){1, 1}));
+  free(v);
+  assert(list_size(l) == 3);
+  assert(vec_equal(*(vector_t *)list_get(l, 0), (vector_t){0, 0}));
+  assert(vec_equal(*(vector_t *)list_get(l, 1), (vector_t){3, 3}));
+  assert(vec_equal(*(vector_t *)list_get(l, 2), (vector_t){2, 2}));
+  // Removing the last element leaves the rest alone
+  v = list_swap_remove(l, 2);
+  assert(vec_equal(*v, (vector_t){2, 2}));
+  free(v);
+  assert(list_size(l) == 2);
+  assert(vec_equal(*(vector_t *)list_get(l, 1), (vector_t){3, 3}));
+  list_free(l);
+}
+
+// Reserving room keeps the elements and makes room for more
+void test_reserve() {
+  list_t *l = list_init(1, free);
+  vector_t *v = malloc(sizeof(*v));
+  *v = (vector_t){0, 0};
+  list_add(l, v);
+  list_reserve(l, 1000);
+  // Reserving less than the list has room for changes nothing
+  list_reserve(l, 10);
+  for (size_t i = 1; i < 1000; i++) {
+    v = malloc(sizeof(*v));
+    v->x = v->y = i;
+    list_add(l, v);
+  }
+  assert(list_size(l) == 1000);
+  for (size_t i = 0; i < 1000; i++) {
+    assert(vec_equal(*(vector_t *)list_get(l, i), (vector_t){i, i}));
+  }
+  list_free(l);
+}
+
+bool is_odd(vector_t *v, void *aux) {
+  assert(aux == NULL);
+  return (size_t)v->x % 2 == 1;
+}
+
+// Removing by a test keeps the order of what is left
+void test_remove_if() {
+  list_t *l = list_init(4, free);
+  for (size_t i = 0; i < 9; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    v->x = v->y = i;
+    list_add(l, v);
+  }
+  assert(list_remove_if(l, (list_predicate_t)is_odd, NULL) == 4);
+  assert(list_size(l) == 5);
+  for (size_t i = 0; i < 5; i++) {
+    assert(vec_equal(*(vector_t *)list_get(l, i), (vector_t){2 * i, 2 * i}));
+  }
+  assert(list_remove_if(l, (list_predicate_t)is_odd, NULL) == 0);
+  // Removing from the middle shifts the rest down
+  vector_t *v = list_remove(l, 1);
+  assert(vec_equal(*v, (vector_t){2, 2}));
+  free(v);
+  assert(list_size(l) == 4);
+  assert(vec_equal(*(vector_t *)list_get(l, 1), (vector_t){4, 4}));
+  assert(vec_equal(*(vector_t *)list_get(l, 3), (vector_t){8, 8}));
+  list_free(l);
+}
+
+// Shrinking and a custom growth factor keep the elements
+void test_shrink_and_growth() {
+  list_t *l = list_init(1, free);
+  list_set_growth(l, 1.5);
+  for (size_t i = 0; i < 1000; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    v->x = v->y = i;
+    list_add(l, v);
+  }
+  while (list_size(l) > 10) {
+    free(list_remove(l, list_size(l) - 1));
+  }
+  list_shrink_to_fit(l);
+  for (size_t i = 0; i < 10; i++) {
+    assert(vec_equal(*(vector_t *)list_get(l, i), (vector_t){i, i}));
+  }
+  // The list still grows after shrinking, even when emptied first
+  while (list_size(l) > 0) {
+    free(list_remove(l, 0));
+  }
+  list_shrink_to_fit(l);
+  for (size_t i = 0; i < 5; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    v->x = v->y = i;
+    list_add(l, v);
+  }
+  assert(list_size(l) == 5);
+  assert(vec_equal(*(vector_t *)list_get(l, 4), (vector_t){4, 4}));
+  list_free(l);
+}
+
 typedef struct {
   list_t *list;
   size_t index;
@@ -258,6 +363,10 @@ int main(int argc, char *argv[]) {
   DO_TEST(test_list_small)
   DO_TEST(test_list_large_get_set)
   DO_TEST(test_list_large_add_remove)
+  DO_TEST(test_swap_remove)
+  DO_TEST(test_reserve)
+  DO_TEST(test_remove_if)
+  DO_TEST(test_shrink_and_growth)
   DO_TEST(test_out_of_bounds_access)
   DO_TEST(test_full_add)
   DO_TEST(test_empty_remove)
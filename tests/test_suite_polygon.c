@@ -218,6 +218,87 @@ void test_weird_rotate() {
   list_free(w);
 }
 
+void test_convex_decompose_convex() {
+  list_t *sq = make_square();
+  assert(polygon_is_convex(sq));
+  assert(polygon_convex_decompose(sq) == NULL);
+  list_free(sq);
+
+  list_t *tri = make_triangle();
+  assert(polygon_is_convex(tri));
+  assert(polygon_convex_decompose(tri) == NULL);
+  list_free(tri);
+}
+
+void test_convex_decompose_weird() {
+  list_t *w = make_weird();
+  assert(!polygon_is_convex(w));
+  list_t *pieces = polygon_convex_decompose(w);
+  assert(pieces != NULL);
+  assert(list_size(pieces) >= 2);
+
+  double area = 0;
+  for (size_t i = 0; i < list_size(pieces); i++) {
+    list_t *piece = list_get(pieces, i);
+    assert(polygon_is_convex(piece));
+    area += polygon_area(piece);
+  }
+  assert(isclose(area, polygon_area(w)));
+
+  list_free(pieces);
+  list_free(w);
+}
+
+// Five-pointed star, clockwise
+#define STAR_POINTS 5
+list_t *make_star() {
+  list_t *star = list_init(2 * STAR_POINTS, free);
+  for (size_t i = 0; i < 2 * STAR_POINTS; i++) {
+    double angle = -M_PI * i / STAR_POINTS;
+    double radius = i % 2 == 0 ? 2 : 1;
+    vector_t *v = malloc(sizeof(*v));
+    *v = (vector_t){radius * cos(angle), radius * sin(angle)};
+    list_add(star, v);
+  }
+  return star;
+}
+
+void test_convex_decompose_star() {
+  list_t *star = make_star();
+  assert(!polygon_is_convex(star));
+  list_t *pieces = polygon_convex_decompose(star);
+  assert(pieces != NULL);
+  // Each piece can resolve at most two of the reflex vertices
+  assert(list_size(pieces) >= STAR_POINTS / 2 + 2);
+
+  double area = 0;
+  for (size_t i = 0; i < list_size(pieces); i++) {
+    list_t *piece = list_get(pieces, i);
+    assert(polygon_is_convex(piece));
+    // Pieces keep the winding of the original polygon
+    assert(polygon_area(piece) < 0);
+    area += polygon_area(piece);
+  }
+  assert(isclose(area, polygon_area(star)));
+
+  list_free(pieces);
+  list_free(star);
+}
+
+void test_contains_raycast() {
+  list_t *w = make_weird();
+  assert(polygon_contains(w, (vector_t){-1, 0}));
+  // Inside the polygon's hull but in its notch
+  assert(!polygon_contains(w, (vector_t){1, 2}));
+  assert(!polygon_contains(w, (vector_t){10, 0}));
+
+  assert(isclose(polygon_raycast(w, (vector_t){-1, 0}, (vector_t){1, 0}), 0));
+  // Enters through the edge from (4, 1) to (-2, 1)
+  assert(isclose(polygon_raycast(w, (vector_t){-1, 10}, (vector_t){0, -1}), 9));
+  assert(polygon_raycast(w, (vector_t){10, 10}, (vector_t){1, 0}) == INFINITY);
+  list_free(w);
+}
+
 int main(int argc, char *argv[]) {
   // Run all tests? True if there are no command-line arguments
   bool all_tests = argc == 1;
@@ -239,6 +320,10 @@ int main(int argc, char *argv[]) {
   DO_TEST(test_weird_area_centroid)
   DO_TEST(test_weird_translate)
   DO_TEST(test_weird_rotate)
+  DO_TEST(test_convex_decompose_convex)
+  DO_TEST(test_convex_decompose_weird)
+  DO_TEST(test_convex_decompose_star)
+  DO_TEST(test_contains_raycast)
 
   puts("polygon_test PASS");
 }
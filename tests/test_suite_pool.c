@@ -0,0 +1,81 @@
+#include "pool.h"
+#include "test_util.h"
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+typedef struct {
+  double x;
+  double y;
+  size_t id;
+} thing_t;
+
+void test_pool_reuse() {
+  const size_t SLAB = 8;
+  pool_t *pool = pool_init(sizeof(thing_t), SLAB);
+  assert(pool_live(pool) == 0 && pool_capacity(pool) == 0);
+
+  // Filling past one slab adds another; the objects stay distinct
+  thing_t *things[3 * SLAB];
+  for (size_t i = 0; i < 3 * SLAB; i++) {
+    things[i] = pool_alloc(pool);
+    *things[i] = (thing_t){.x = i, .y = -(double)i, .id = i};
+  }
+  assert(pool_live(pool) == 3 * SLAB);
+  assert(pool_capacity(pool) == 3 * SLAB);
+  for (size_t i = 0; i < 3 * SLAB; i++) {
+    assert(things[i]->id == i && things[i]->x == i);
+    assert((uintptr_t)things[i] % sizeof(double) == 0);
+  }
+
+  // Released objects are handed out again without growing the pool
+  for (size_t i = 0; i < 3 * SLAB; i += 2) {
+    pool_release(pool, things[i]);
+  }
+  assert(pool_live(pool) == 3 * SLAB / 2);
+  for (size_t round = 0; round < 100; round++) {
+    thing_t *thing = pool_alloc(pool);
+    thing->id = round;
+    pool_release(pool, thing);
+  }
+  for (size_t i = 0; i < 3 * SLAB; i += 2) {
+    things[i] = pool_alloc(pool);
+  }
+  assert(pool_capacity(pool) == 3 * SLAB);
+  for (size_t i = 1; i < 3 * SLAB; i += 2) {
+    assert(things[i]->id == i);
+  }
+  pool_free(pool);
+}
+
+void test_pool_sized() {
+  // Small objects of the same class reuse each other's memory
+  void *small = pool_alloc_sized(24);
+  pool_release_sized(small, 24);
+  void *again = pool_alloc_sized(20);
+  assert(again == small);
+  pool_release_sized(again, 20);
+
+  // Objects too big for any class still work
+  char *big = pool_alloc_sized(1000);
+  for (size_t i = 0; i < 1000; i++) {
+    big[i] = (char)i;
+  }
+  assert(big[999] == (char)999);
+  pool_release_sized(big, 1000);
+}
+
+int main(int argc, char *argv[]) {
+  // Run all tests? True if there are no command-line arguments
+  bool all_tests = argc == 1;
+  // Read test name from file
+  char testname[100];
+  if (!all_tests) {
+    read_testname(argv[1], testname, sizeof(testname));
+  }
+
+  DO_TEST(test_pool_reuse)
+  DO_TEST(test_pool_sized)
+
+  puts("pool_test PASS");
+}
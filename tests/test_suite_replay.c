@@ -0,0 +1,212 @@
+#include "replay.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+list_t *make_square() {
+  list_t *square = list_init(4, free);
+  vector_t *v = malloc(sizeof(*v));
+  *v = (vector_t){-1, -1};
+  list_add(square, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){+1, -1};
+  list_add(square, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){+1, +1};
+  list_add(square, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){-1, +1};
+  list_add(square, v);
+  return square;
+}
+
+scene_t *make_falling_scene(size_t num_bodies) {
+  scene_t *scene = scene_init();
+  for (size_t i = 0; i < num_bodies; i++) {
+    body_t *body = body_init(make_square(), 1, (rgb_color_t){0, 0, 0});
+    body_set_centroid(body, (vector_t){10 * i, 0});
+    scene_add_body(scene, body);
+  }
+  scene_add_field(scene, (force_field_t){.kind = FIELD_UNIFORM,
+                                         .force = {0, -10},
+                                         .mass_scaled = true});
+  return scene;
+}
+
+replay_t *make_session() {
+  replay_t *replay = replay_init();
+  replay_add(replay, (replay_event_t){.kind = REPLAY_TICK, .dt = 0});
+  replay_add(replay,
+             (replay_event_t){.kind = REPLAY_MOUSE, .x = 12, .y = 34.5});
+  replay_add(replay, (replay_event_t){.kind = REPLAY_TICK, .dt = 0.016});
+  replay_add(replay, (replay_event_t){.kind = REPLAY_KEY, .key = 'w'});
+  replay_add(replay, (replay_event_t){
+      .kind = REPLAY_KEY, .key = 'w', .released = true, .held_time = 0.25});
+  replay_add(replay, (replay_event_t){.kind = REPLAY_TICK, .dt = 1.0 / 3});
+  return replay;
+}
+
+void test_record() {
+  replay_t *replay = make_session();
+  assert(replay_size(replay) == 6);
+  assert(replay_ticks(replay) == 3);
+  replay_event_t event = replay_get(replay, 1);
+  assert(event.kind == REPLAY_MOUSE && event.x == 12 && event.y == 34.5);
+  event = replay_get(replay, 4);
+  assert(event.kind == REPLAY_KEY && event.key == 'w' && event.released);
+  replay_free(replay);
+
+  // Growing past the initial capacity keeps every event
+  replay = replay_init();
+  for (size_t i = 0; i < 5000; i++) {
+    replay_add(replay, (replay_event_t){.kind = REPLAY_TICK, .dt = i});
+  }
+  assert(replay_ticks(replay) == 5000);
+  assert(replay_get(replay, 4999).dt == 4999);
+  replay_free(replay);
+}
+
+void test_write_read() {
+  replay_t *replay = make_session();
+  FILE *file = tmpfile();
+  assert(file != NULL);
+  assert(replay_write(replay, file));
+  // Ticks and mouse clicks only store their own fields
+  assert(ftell(file) < (long)(replay_size(replay) * sizeof(replay_event_t)));
+  rewind(file);
+  replay_t *copy = replay_read(file);
+  assert(copy != NULL);
+  assert(replay_size(copy) == replay_size(replay));
+  assert(replay_ticks(copy) == replay_ticks(replay));
+  for (size_t i = 0; i < replay_size(replay); i++) {
+    replay_event_t expected = replay_get(replay, i);
+    replay_event_t actual = replay_get(copy, i);
+    assert(actual.kind == expected.kind);
+    assert(actual.dt == expected.dt);
+    assert(actual.key == expected.key);
+    assert(actual.released == expected.released);
+    assert(actual.held_time == expected.held_time);
+    assert(actual.x == expected.x && actual.y == expected.y);
+  }
+  replay_free(copy);
+  fclose(file);
+  replay_free(replay);
+}
+
+void test_read_rejects() {
+  // A stream cut off partway through an event
+  replay_t *replay = make_session();
+  FILE *file = tmpfile();
+  assert(replay_write(replay, file));
+  long length = ftell(file);
+  rewind(file);
+  char *bytes = malloc(length);
+  assert(fread(bytes, 1, length, file) == (size_t)length);
+  fclose(file);
+  file = tmpfile();
+  fwrite(bytes, 1, length - 3, file);
+  rewind(file);
+  assert(replay_read(file) == NULL);
+  fclose(file);
+
+  // A stream that is not a recording
+  bytes[0] = 'X';
+  file = tmpfile();
+  fwrite(bytes, 1, length, file);
+  rewind(file);
+  assert(replay_read(file) == NULL);
+  fclose(file);
+  free(bytes);
+  replay_free(replay);
+}
+
+void test_hash_trace() {
+  const double DT = 1e-2;
+  const size_t TICKS = 5;
+  FILE *trace = tmpfile();
+  scene_t *scene = make_falling_scene(3);
+  for (size_t tick = 0; tick < TICKS; tick++) {
+    scene_tick(scene, DT);
+    replay_write_hashes(trace, tick, scene);
+  }
+  scene_free(scene);
+
+  // The same run matches every tick
+  rewind(trace);
+  scene = make_falling_scene(3);
+  size_t body;
+  for (size_t tick = 0; tick < TICKS; tick++) {
+    scene_tick(scene, DT);
+    assert(replay_check_hashes(trace, tick, scene, &body) == TRACE_MATCH);
+  }
+  // and the trace has nothing past its last tick
+  assert(replay_check_hashes(trace, TICKS, scene, &body) == TRACE_MISSING);
+  scene_free(scene);
+
+  // A run that drifts reports the first tick and body that differ
+  rewind(trace);
+  scene = make_falling_scene(3);
+  for (size_t tick = 0; tick < 2; tick++) {
+    scene_tick(scene, DT);
+    assert(replay_check_hashes(trace, tick, scene, &body) == TRACE_MATCH);
+  }
+  body_set_velocity(scene_get_body(scene, 2), (vector_t){0, 1e-12});
+  scene_tick(scene, DT);
+  assert(replay_check_hashes(trace, 2, scene, &body) == TRACE_BODY);
+  assert(body == 2);
+  scene_free(scene);
+
+  // or the bodies that are not moving, if the others all match
+  rewind(trace);
+  scene = make_falling_scene(3);
+  scene_add_static_body(
+      scene, body_init(make_square(), INFINITY, (rgb_color_t){0, 0, 0}));
+  scene_tick(scene, DT);
+  assert(replay_check_hashes(trace, 0, scene, &body) ==
+         TRACE_OTHER_BODIES);
+  scene_free(scene);
+
+  // or the flag that differs
+  FILE *won = tmpfile();
+  scene = make_falling_scene(3);
+  body_win(scene_get_body(scene, 0));
+  scene_tick(scene, DT);
+  replay_write_hashes(won, 0, scene);
+  scene_free(scene);
+  rewind(won);
+  scene = make_falling_scene(3);
+  body_t *player = scene_get_body(scene, 0);
+  scene_add_player(scene, scene_get_handle(scene, player));
+  body_win(player);
+  scene_tick(scene, DT);
+  assert(replay_check_hashes(won, 0, scene, &body) == TRACE_WIN);
+  scene_free(scene);
+  fclose(won);
+
+  // As does a run with a different number of bodies
+  rewind(trace);
+  scene = make_falling_scene(2);
+  scene_tick(scene, DT);
+  assert(replay_check_hashes(trace, 0, scene, &body) == TRACE_MISSING);
+  scene_free(scene);
+  fclose(trace);
+}
+
+int main(int argc, char *argv[]) {
+  // Run all tests? True if there are no command-line arguments
+  bool all_tests = argc == 1;
+  // Read test name from file
+  char testname[100];
+  if (!all_tests) {
+    read_testname(argv[1], testname, sizeof(testname));
+  }
+
+  DO_TEST(test_record)
+  DO_TEST(test_write_read)
+  DO_TEST(test_read_rejects)
+  DO_TEST(test_hash_trace)
+
+  puts("replay_test PASS");
+}
@@ -0,0 +1,159 @@
+#include "sap.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+body_t *make_box(vector_t min, vector_t max, double mass) {
+  list_t *rect = list_init(4, free);
+  vector_t *v = malloc(sizeof(*v));
+  *v = min;
+  list_add(rect, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){max.x, min.y};
+  list_add(rect, v);
+  v = malloc(sizeof(*v));
+  *v = max;
+  list_add(rect, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){min.x, max.y};
+  list_add(rect, v);
+  return body_init(rect, mass, (rgb_color_t){0, 0, 0});
+}
+
+bool contains(list_t *list, void *item) {
+  for (size_t i = 0; i < list_size(list); i++) {
+    if (list_get(list, i) == item) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void test_sap_pairs() {
+  sap_t *sap = sap_init();
+  // A long thin platform, a wall, and a player moving between them
+  body_t *platform = make_box((vector_t){0, 0}, (vector_t){800, 10}, INFINITY);
+  body_t *wall = make_box((vector_t){900, 0}, (vector_t){910, 500}, INFINITY);
+  body_t *player = make_box((vector_t){100, 5}, (vector_t){120, 25}, 1);
+  sap_add(sap, platform, true);
+  sap_add(sap, wall, true);
+  sap_add(sap, player, false);
+
+  list_t *results = list_init(1, NULL);
+  assert(sap_query_body(sap, player, results));
+  assert(list_size(results) == 1);
+  assert(contains(results, platform));
+  list_free(results);
+
+  // Static bodies are not paired with each other
+  results = list_init(1, NULL);
+  assert(sap_query_body(sap, platform, results));
+  assert(list_size(results) == 0);
+  list_free(results);
+
+  // Pairs follow the player once the endpoints are re-sorted
+  body_set_centroid(player, (vector_t){905, 100});
+  sap_update(sap);
+  results = list_init(1, NULL);
+  assert(sap_query_body(sap, player, results));
+  assert(list_size(results) == 1);
+  assert(contains(results, wall));
+  list_free(results);
+
+  body_set_centroid(player, (vector_t){850, 100});
+  sap_update(sap);
+  results = list_init(1, NULL);
+  assert(sap_query_body(sap, player, results));
+  assert(list_size(results) == 0);
+  list_free(results);
+
+  sap_free(sap);
+  body_free(platform);
+  body_free(wall);
+  body_free(player);
+}
+
+void test_sap_add_remove() {
+  sap_t *sap = sap_init();
+  const size_t STEPS = 40;
+  body_t *platforms[STEPS];
+  body_t *player = make_box((vector_t){-5, -5}, (vector_t){5, 5}, 1);
+  sap_add(sap, player, false);
+  for (size_t i = 0; i < STEPS; i++) {
+    // A staircase of platforms, so the structure has to grow
+    platforms[i] = make_box((vector_t){i * 20.0, i * 20.0},
+                            (vector_t){i * 20.0 + 30, i * 20.0 + 5}, INFINITY);
+    sap_add(sap, platforms[i], true);
+  }
+  body_t *stranger = make_box((vector_t){0, 0}, (vector_t){1, 1}, 1);
+  list_t *results = list_init(1, NULL);
+  assert(!sap_query_body(sap, stranger, results));
+
+  body_set_centroid(player, (vector_t){200, 202});
+  sap_update(sap);
+  assert(sap_query_body(sap, player, results));
+  assert(list_size(results) == 1);
+  assert(contains(results, platforms[10]));
+  list_free(results);
+
+  // Removing bodies moves others into their slots
+  sap_remove(sap, platforms[10]);
+  sap_remove(sap, platforms[0]);
+  results = list_init(1, NULL);
+  assert(sap_query_body(sap, player, results));
+  assert(list_size(results) == 0);
+  list_free(results);
+  body_set_centroid(player, (vector_t){780, 782});
+  sap_update(sap);
+  results = list_init(1, NULL);
+  assert(sap_query_body(sap, player, results));
+  assert(list_size(results) == 1);
+  assert(contains(results, platforms[STEPS - 1]));
+  list_free(results);
+
+  // Every body left is still found after many removals
+  for (size_t i = 3; i < STEPS; i += 3) {
+    sap_remove(sap, platforms[i]);
+  }
+  results = list_init(1, NULL);
+  for (size_t i = 1; i < STEPS; i++) {
+    bool removed = i == 10 || i % 3 == 0;
+    assert(sap_query_body(sap, platforms[i], results) == !removed);
+  }
+  assert(sap_query_body(sap, player, results));
+  assert(list_size(results) == 0);
+  list_free(results);
+  for (size_t i = 3; i < STEPS; i += 3) {
+    sap_add(sap, platforms[i], true);
+  }
+
+  // Box queries only report static bodies
+  results = list_init(1, NULL);
+  sap_query(sap, (aabb_t){{0, 0}, {1000, 1000}}, results);
+  assert(list_size(results) == STEPS - 2);
+  assert(!contains(results, player));
+  list_free(results);
+
+  sap_free(sap);
+  for (size_t i = 0; i < STEPS; i++) {
+    body_free(platforms[i]);
+  }
+  body_free(player);
+  body_free(stranger);
+}
+
+int main(int argc, char *argv[]) {
+  // Run all tests? True if there are no command-line arguments
+  bool all_tests = argc == 1;
+  // Read test name from file
+  char testname[100];
+  if (!all_tests) {
+    read_testname(argv[1], testname, sizeof(testname));
+  }
+
+  DO_TEST(test_sap_pairs)
+  DO_TEST(test_sap_add_remove)
+
+  puts("sap_test PASS");
+}
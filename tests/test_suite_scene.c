@@ -2,7 +2,9 @@
 #include "test_util.h"
 #include <assert.h>
 #include <math.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 
 void scene_get_first(void *scene) { scene_get_body(scene, 0); }
 void scene_remove_first(void *scene) { scene_remove_body(scene, 0); }
@@ -227,6 +229,559 @@ void test_reaping() {
   scene_free(scene);
 }
 
+void count_only(void *aux) { (*(int *)aux)++; }
+
+void test_sleeping_forces_skipped() {
+  const int REST_TICKS = 1000;
+  scene_t *scene = scene_init();
+  body_t *body = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  scene_add_body(scene, body);
+  body_t *wall = body_init(make_shape(), INFINITY, (rgb_color_t){0, 0, 0});
+  scene_add_body(scene, wall);
+
+  int *count = malloc(sizeof(*count));
+  *count = 0;
+  list_t *bodies = list_init(2, NULL);
+  list_add(bodies, body);
+  list_add(bodies, wall);
+  scene_add_bodies_force_creator(scene, count_only, count, bodies, free);
+
+  for (int i = 0; i < REST_TICKS; i++) {
+    scene_tick(scene, 1e-2);
+  }
+  assert(body_is_asleep(body));
+  assert(*count < REST_TICKS);
+  scene_stats_t stats = scene_get_stats(scene);
+  assert(stats.forces_run == 0);
+  assert(stats.forces_skipped == 1);
+  assert(stats.sleeping_bodies == 2);
+  assert(stats.awake_bodies == 0);
+
+  // Disturbing the body brings its forces back
+  int calls = *count;
+  body_add_impulse(body, (vector_t){1, 0});
+  scene_tick(scene, 1e-2);
+  assert(*count == calls + 1);
+  assert(!body_is_asleep(body));
+  assert(scene_get_stats(scene).forces_run == 1);
+  scene_free(scene);
+}
+
+void test_substeps() {
+  const double DT = 1e-2;
+  scene_t *scene = scene_init();
+  body_t *body = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  scene_add_body(scene, body);
+  int *count = malloc(sizeof(*count));
+  *count = 0;
+  scene_add_force_creator(scene, count_only, count, free);
+
+  // Substepping is off by default
+  body_set_velocity(body, (vector_t){1000, 0});
+  scene_tick(scene, DT);
+  assert(scene_get_stats(scene).substeps == 1);
+  assert(*count == 1);
+
+  // Calm ticks still take one step
+  scene_set_max_substeps(scene, 8);
+  body_set_velocity(body, (vector_t){1, 0});
+  scene_tick(scene, DT);
+  assert(scene_get_stats(scene).substeps == 1);
+  assert(*count == 2);
+
+  // Fast bodies split the tick, up to the cap
+  body_set_velocity(body, (vector_t){100, 0});
+  vector_t start = body_get_centroid(body);
+  scene_tick(scene, DT);
+  assert(scene_get_stats(scene).substeps == 2);
+  assert(*count == 4);
+  // The work done adds up over the substeps, but the bodies are counted once
+  assert(scene_get_stats(scene).forces_run == 2);
+  assert(scene_get_stats(scene).awake_bodies == 1);
+  assert(scene_get_stats(scene).sleeping_bodies == 0);
+  assert(isclose(body_get_centroid(body).x - start.x, 100 * DT));
+  body_set_velocity(body, (vector_t){1000, 0});
+  scene_tick(scene, DT);
+  assert(scene_get_stats(scene).substeps == 8);
+  assert(scene_get_stats(scene).forces_run == 8);
+
+  // So do stiff springs
+  body_set_velocity(body, VEC_ZERO);
+  scene_add_stiffness(scene, 2500);
+  scene_tick(scene, DT);
+  assert(scene_get_stats(scene).substeps == 3);
+  scene_free(scene);
+}
+
+void test_fields() {
+  const double DT = 1e-2;
+  scene_t *scene = scene_init();
+  body_t *heavy = body_init(make_shape(), 2, (rgb_color_t){0, 0, 0});
+  body_t *light = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_t *floating = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_t *wall = body_init(make_shape(), INFINITY, (rgb_color_t){0, 0, 0});
+  body_set_centroid(light, (vector_t){100, 0});
+  scene_add_body(scene, heavy);
+  scene_add_body(scene, light);
+  scene_add_body(scene, floating);
+  scene_add_body(scene, wall);
+
+  size_t gravity = scene_add_field(scene, (force_field_t){
+      .kind = FIELD_UNIFORM, .force = {0, -10}, .mass_scaled = true});
+  size_t wind = scene_add_field(
+      scene, (force_field_t){.kind = FIELD_UNIFORM,
+                             .force = {5, 0},
+                             .bounded = true,
+                             .region = {.min = {90, -10}, .max = {110, 10}}});
+  assert(gravity == 0 && wind == 1);
+  body_set_field_mask(floating, ~(1u << gravity));
+  scene_tick(scene, DT);
+  // Gravity accelerates every body alike; only the light body is in the wind
+  assert(vec_isclose(body_get_velocity(heavy), (vector_t){0, -10 * DT}));
+  assert(vec_isclose(body_get_velocity(light), (vector_t){5 * DT, -10 * DT}));
+  assert(vec_isclose(body_get_velocity(floating), VEC_ZERO));
+  assert(vec_isclose(body_get_velocity(wall), VEC_ZERO));
+
+  // Drag slows bodies in proportion to their speed
+  size_t drag = scene_add_field(
+      scene, (force_field_t){.kind = FIELD_DRAG, .drag = 4});
+  body_set_field_mask(heavy, 1u << drag);
+  body_set_velocity(heavy, (vector_t){10, 0});
+  scene_tick(scene, DT);
+  assert(vec_isclose(body_get_velocity(heavy), (vector_t){10 - 20 * DT, 0}));
+  assert(vec_isclose(body_get_velocity(floating), VEC_ZERO));
+  scene_free(scene);
+}
+
+typedef struct {
+  int *log;
+  size_t *length;
+  int id;
+} record_aux_t;
+
+// A force creator that records that it ran
+void record_run(void *aux) {
+  record_aux_t *record = aux;
+  record->log[(*record->length)++] = record->id;
+}
+
+void test_phases_and_tags() {
+  const size_t FAN_TAG = 7;
+  scene_t *scene = scene_init();
+  body_t *body = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  scene_add_body(scene, body);
+  int log[8];
+  size_t length = 0;
+  record_aux_t records[4];
+  for (int i = 0; i < 4; i++) {
+    records[i] = (record_aux_t){.log = log, .length = &length, .id = i + 1};
+  }
+  list_t *fan_bodies = list_init(1, NULL);
+  list_add(fan_bodies, body);
+  scene_add_phased_force_creator(scene, FORCE_PHASE_CONTACT, 0, record_run,
+                                 &records[2], NULL, NULL, NULL);
+  scene_add_phased_force_creator(scene, FORCE_PHASE_REACT, FAN_TAG,
+                                 record_run, &records[1], fan_bodies, NULL,
+                                 NULL);
+  scene_add_phased_force_creator(scene, FORCE_PHASE_APPLY, 0, record_run,
+                                 &records[0], NULL, NULL, NULL);
+  scene_add_bodies_force_creator(scene, record_run, &records[3], NULL, NULL);
+
+  // Phases run in order, and later force creators first within a phase
+  scene_tick(scene, 1e-2);
+  assert(length == 4);
+  assert(log[0] == 1 && log[1] == 4 && log[2] == 2 && log[3] == 3);
+
+  // Disabled force creators do not run
+  scene_set_tag_enabled(scene, FAN_TAG, false);
+  length = 0;
+  scene_tick(scene, 1e-2);
+  assert(length == 3);
+  assert(log[0] == 1 && log[1] == 4 && log[2] == 3);
+
+  // Switching them back on wakes the bodies they act on
+  body_sleep(body);
+  scene_set_tag_enabled(scene, FAN_TAG, true);
+  assert(!body_is_asleep(body));
+  length = 0;
+  scene_tick(scene, 1e-2);
+  assert(length == 4);
+  scene_free(scene);
+}
+
+void test_players() {
+  scene_t *scene = scene_init();
+  body_t *player = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_t *other = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_set_centroid(other, (vector_t){10, 0});
+  body_handle_t handle = scene_add_body(scene, player);
+  scene_add_body(scene, other);
+  scene_add_player(scene, handle);
+
+  // Only the players' flags count
+  body_win(other);
+  body_lose(other);
+  scene_tick(scene, 1e-2);
+  assert(!scene_get_win(scene) && !scene_get_lose(scene));
+  body_win(player);
+  scene_tick(scene, 1e-2);
+  assert(scene_get_win(scene) && !scene_get_lose(scene));
+
+  // Clones keep the same players
+  scene_t *clone = scene_clone(scene);
+  body_win(scene_get_body(clone, 1));
+  body_lose(scene_get_body(clone, 1));
+  scene_tick(clone, 1e-2);
+  assert(scene_get_win(clone) && !scene_get_lose(clone));
+  scene_free(clone);
+  scene_free(scene);
+}
+
+void test_snapshot() {
+  const double DT = 1e-2;
+  scene_t *scene = scene_init();
+  body_t *body = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_t *other = body_init(make_shape(), 2, (rgb_color_t){0, 0, 0});
+  body_set_centroid(other, (vector_t){10, 0});
+  body_set_velocity(body, (vector_t){1, 2});
+  scene_add_body(scene, body);
+  scene_add_player(scene, scene_add_body(scene, other));
+  list_t *bodies = list_init(1, NULL);
+  list_add(bodies, other);
+  scene_add_phased_force_creator(scene, FORCE_PHASE_REACT, 1, count_only,
+                                 calloc(1, sizeof(int)), bodies, free, NULL);
+
+  size_t size;
+  void *snapshot = scene_snapshot(scene, &size);
+  vector_t start = body_get_centroid(body);
+  scene_add_field(scene, (force_field_t){.kind = FIELD_UNIFORM,
+                                         .force = {0, -10},
+                                         .mass_scaled = true});
+  scene_set_tag_enabled(scene, 1, false);
+  body_lose(other);
+  for (int i = 0; i < 10; i++) {
+    scene_tick(scene, DT);
+  }
+  assert(scene_get_lose(scene));
+  assert(!vec_isclose(body_get_centroid(body), start));
+
+  // Everything goes back, including the field added since
+  assert(scene_restore(scene, snapshot, size));
+  assert(!scene_get_lose(scene) && !body_get_lose(other));
+  assert(vec_isclose(body_get_centroid(body), start));
+  assert(vec_isclose(body_get_velocity(body), (vector_t){1, 2}));
+  scene_tick(scene, DT);
+  assert(vec_isclose(body_get_velocity(body), (vector_t){1, 2}));
+  assert(scene_get_stats(scene).forces_run == 1);
+  list_t *found = list_init(1, NULL);
+  scene_query_point(scene, vec_add(start, vec_multiply(DT, (vector_t){1, 2})),
+                    found);
+  assert(list_size(found) == 1 && list_get(found, 0) == body);
+  list_free(found);
+
+  // The force creator's count cannot be copied, so no copy of the scene was
+  // kept, and a scene that lost a body cannot be restored, even once another
+  // body takes its place
+  body_remove(other);
+  scene_tick(scene, DT);
+  assert(!scene_restore(scene, snapshot, size));
+  assert(!scene_restore(scene, snapshot, size - 1));
+  body_t *replacement = body_init(make_shape(), 2, (rgb_color_t){0, 0, 0});
+  scene_add_body(scene, replacement);
+  assert(scene_bodies(scene) == 2);
+  assert(!scene_restore(scene, snapshot, size));
+  scene_free_snapshot(snapshot);
+
+  // That force creator went with the body, so now a copy is kept, and even
+  // a lost static body comes back
+  body_t *wall = body_init(make_shape(), INFINITY, (rgb_color_t){0, 0, 0});
+  scene_add_static_body(scene, wall);
+  snapshot = scene_snapshot(scene, &size);
+  body_remove(wall);
+  scene_tick(scene, DT);
+  assert(scene_static_bodies(scene) == 0);
+  assert(scene_restore(scene, snapshot, size));
+  assert(scene_static_bodies(scene) == 1);
+  scene_free_snapshot(snapshot);
+  scene_free(scene);
+}
+
+int last_count = 0;
+
+void count_and_note(void *aux) { last_count = ++*(int *)aux; }
+
+void *copy_count(void *aux, scene_t *clone) {
+  int *copy = malloc(sizeof(int));
+  assert(copy != NULL);
+  *copy = *(int *)aux;
+  return copy;
+}
+
+void test_snapshot_removed() {
+  const double DT = 1e-2;
+  scene_t *scene = scene_init();
+  body_t *body = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_t *gem = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_t *wall = body_init(make_shape(), INFINITY, (rgb_color_t){0, 0, 0});
+  body_set_velocity(body, (vector_t){1, 2});
+  body_set_centroid(gem, (vector_t){10, 0});
+  body_set_centroid(wall, (vector_t){0, -10});
+  scene_add_body(scene, body);
+  body_handle_t gem_handle = scene_add_body(scene, gem);
+  scene_add_static_body(scene, wall);
+  list_t *bodies = list_init(1, NULL);
+  list_add(bodies, gem);
+  scene_add_phased_force_creator(scene, FORCE_PHASE_REACT, 0, count_and_note,
+                                 calloc(1, sizeof(int)), bodies, free,
+                                 copy_count);
+  for (int i = 0; i < 3; i++) {
+    scene_tick(scene, DT);
+  }
+  size_t size;
+  void *snapshot = scene_snapshot(scene, &size);
+  uint64_t checkpoint = scene_hash(scene);
+
+  // Removed bodies come back, along with the force creator that went with
+  // them and the count it had
+  for (int i = 0; i < 2; i++) {
+    scene_tick(scene, DT);
+  }
+  body_remove(gem);
+  body_remove(wall);
+  scene_tick(scene, DT);
+  assert(scene_bodies(scene) == 1 && scene_static_bodies(scene) == 0);
+  assert(scene_restore(scene, snapshot, size));
+  assert(scene_hash(scene) == checkpoint);
+  assert(scene_bodies(scene) == 2 && scene_static_bodies(scene) == 1);
+  assert(scene_resolve(scene, gem_handle) != NULL);
+  scene_tick(scene, DT);
+  assert(last_count == 4);
+
+  // Restoring a scene that still has its bodies puts back the count too
+  scene_tick(scene, DT);
+  body = scene_get_body(scene, 0);
+  assert(scene_restore(scene, snapshot, size));
+  assert(scene_get_body(scene, 0) == body);
+  assert(scene_hash(scene) == checkpoint);
+  scene_tick(scene, DT);
+  assert(last_count == 4);
+  scene_free_snapshot(snapshot);
+  scene_free(scene);
+}
+
+scene_t *make_hash_scene() {
+  scene_t *scene = scene_init();
+  body_t *body = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_t *other = body_init(make_shape(), 2, (rgb_color_t){0, 0, 0});
+  body_set_centroid(other, (vector_t){10, 0});
+  body_set_velocity(body, (vector_t){1, 2});
+  scene_add_body(scene, body);
+  scene_add_body(scene, other);
+  scene_add_field(scene, (force_field_t){.kind = FIELD_UNIFORM,
+                                         .force = {0, -10},
+                                         .mass_scaled = true});
+  return scene;
+}
+
+void test_hash() {
+  const double DT = 1e-2;
+  scene_t *scene = make_hash_scene();
+  scene_t *same = make_hash_scene();
+  for (int i = 0; i < 10; i++) {
+    assert(scene_hash(scene) == scene_hash(same));
+    scene_tick(scene, DT);
+    scene_tick(same, DT);
+  }
+  assert(scene_hash(scene) == scene_hash(same));
+
+  // The smallest possible change to one body shows up in its hash
+  body_t *body = scene_get_body(same, 1);
+  vector_t velocity = body_get_velocity(body);
+  body_set_velocity(body,
+                    (vector_t){nextafter(velocity.x, INFINITY), velocity.y});
+  assert(scene_hash(scene) != scene_hash(same));
+  assert(body_hash(scene_get_body(scene, 0)) ==
+         body_hash(scene_get_body(same, 0)));
+  assert(body_hash(scene_get_body(scene, 1)) != body_hash(body));
+  body_set_velocity(body, velocity);
+  assert(scene_hash(scene) == scene_hash(same));
+
+  // So do the scene's flags
+  body_lose(scene_get_body(same, 0));
+  scene_tick(scene, DT);
+  scene_tick(same, DT);
+  assert(scene_hash(scene) != scene_hash(same));
+  scene_free(scene);
+  scene_free(same);
+}
+
+void test_handles() {
+  scene_t *scene = scene_init();
+  body_handle_t handles[4];
+  body_t *bodies[4];
+  for (size_t i = 0; i < 4; i++) {
+    bodies[i] = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+    handles[i] = scene_add_body(scene, bodies[i]);
+  }
+  assert(scene_resolve(scene, (body_handle_t){0}) == NULL);
+  assert(scene_get_handle(scene, bodies[2]).index == handles[2].index);
+
+  // Removing a body moves the last one into its index, but handles still
+  // find every body that is left
+  body_remove(bodies[1]);
+  scene_tick(scene, 1);
+  assert(scene_bodies(scene) == 3);
+  assert(scene_get_body(scene, 1) == bodies[3]);
+  assert(scene_resolve(scene, handles[1]) == NULL);
+  for (size_t i = 0; i < 4; i++) {
+    if (i != 1) {
+      assert(scene_resolve(scene, handles[i]) == bodies[i]);
+    }
+  }
+
+  // A body that reuses the slot does not answer to the old handle
+  body_t *body = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_handle_t handle = scene_add_body(scene, body);
+  assert(handle.index == handles[1].index);
+  assert(scene_resolve(scene, handles[1]) == NULL);
+  assert(scene_resolve(scene, handle) == body);
+
+  // Handles resolve to the copies in a clone
+  scene_t *clone = scene_clone(scene);
+  assert(scene_resolve(clone, handle) == scene_find_clone(clone, body));
+  assert(scene_resolve(clone, handles[3]) ==
+         scene_find_clone(clone, bodies[3]));
+  assert(scene_resolve(clone, handles[1]) == NULL);
+  scene_free(clone);
+  scene_free(scene);
+}
+
+// Measures how long cloning a 100-body scene takes,
+// and checks that the clones match the original
+void test_clone_cost() {
+  const size_t NUM_BODIES = 100;
+  const size_t CLONES = 200;
+  scene_t *scene = scene_init();
+  body_t *bodies[NUM_BODIES];
+  for (size_t i = 0; i < NUM_BODIES; i++) {
+    bodies[i] = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+    body_set_centroid(bodies[i], (vector_t){3.0 * i, 0});
+    body_set_velocity(bodies[i], (vector_t){0, i});
+  }
+  scene_add_bodies_n(scene, bodies, NUM_BODIES, NULL);
+  // Reap a few, so the store has been reordered
+  body_remove(bodies[0]);
+  body_remove(bodies[NUM_BODIES / 2]);
+  scene_tick(scene, 1e-2);
+  assert(scene_bodies(scene) == NUM_BODIES - 2);
+
+  clock_t start = clock();
+  for (size_t i = 0; i < CLONES; i++) {
+    scene_free(scene_clone(scene));
+  }
+  double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+  printf("scene_clone and scene_free with %zu bodies: %.1f us\n",
+         scene_bodies(scene), 1e6 * seconds / CLONES);
+
+  // A clone starts out and ticks exactly like the original
+  scene_t *clone = scene_clone(scene);
+  assert(scene_hash(clone) == scene_hash(scene));
+  for (size_t i = 0; i < 10; i++) {
+    scene_tick(scene, 1e-2);
+    scene_tick(clone, 1e-2);
+  }
+  assert(scene_hash(clone) == scene_hash(scene));
+  body_t *copy = scene_find_clone(clone, bodies[NUM_BODIES - 1]);
+  assert(vec_equal(body_get_centroid(copy),
+                   body_get_centroid(bodies[NUM_BODIES - 1])));
+  scene_free(clone);
+  scene_free(scene);
+}
+
+void test_spatial_queries() {
+  scene_t *scene = scene_init();
+  body_t *mover = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  scene_add_body(scene, mover);
+  body_t *wall = body_init(make_shape(), INFINITY, (rgb_color_t){0, 0, 0});
+  body_set_centroid(wall, (vector_t){10, 0});
+  scene_add_static_body(scene, wall);
+
+  list_t *results = list_init(2, NULL);
+  scene_query_point(scene, (vector_t){0.5, 0.5}, results);
+  assert(list_size(results) == 1 && list_get(results, 0) == mover);
+  list_free(results);
+  results = list_init(2, NULL);
+  scene_query_aabb(scene, (aabb_t){{-5, -5}, {9.5, 5}}, results);
+  assert(list_size(results) == 2);
+  list_free(results);
+
+  raycast_hit_t hit = scene_raycast(scene, (vector_t){-5, 0}, (vector_t){1, 0},
+                                    100);
+  assert(hit.hit && hit.body == mover);
+  assert(isclose(hit.distance, 4));
+  assert(vec_isclose(hit.point, (vector_t){-1, 0}));
+  hit = scene_raycast(scene, (vector_t){-5, 0}, (vector_t){1, 0}, 3);
+  assert(!hit.hit);
+
+  // The index follows bodies as they move
+  body_set_velocity(mover, (vector_t){0, 100});
+  scene_tick(scene, 1);
+  results = list_init(2, NULL);
+  scene_query_point(scene, (vector_t){0.5, 0.5}, results);
+  assert(list_size(results) == 0);
+  scene_query_point(scene, (vector_t){0.5, 100.5}, results);
+  assert(list_size(results) == 1);
+  list_free(results);
+  hit = scene_raycast(scene, (vector_t){-5, 0}, (vector_t){1, 0}, 100);
+  assert(hit.hit && hit.body == wall);
+  assert(isclose(hit.distance, 14));
+
+  // Removed bodies leave the index
+  body_remove(mover);
+  scene_tick(scene, 1);
+  results = list_init(2, NULL);
+  scene_query_aabb(scene, (aabb_t){{-500, -500}, {500, 500}}, results);
+  assert(list_size(results) == 1 && list_get(results, 0) == wall);
+  list_free(results);
+  scene_free(scene);
+}
+
+void test_add_bodies_n() {
+  const size_t NUM_BODIES = 1000;
+  scene_t *scene = scene_init();
+  body_t *first = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  scene_add_body(scene, first);
+  body_t **bodies = malloc(NUM_BODIES * sizeof(body_t *));
+  body_handle_t *handles = malloc(NUM_BODIES * sizeof(body_handle_t));
+  for (size_t i = 0; i < NUM_BODIES; i++) {
+    bodies[i] = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+    body_set_centroid(bodies[i], (vector_t){3 * i, 0});
+  }
+  scene_add_bodies_n(scene, bodies, NUM_BODIES, handles);
+  // The bodies are added in order, after the ones already there
+  assert(scene_bodies(scene) == NUM_BODIES + 1);
+  assert(scene_get_body(scene, 0) == first);
+  for (size_t i = 0; i < NUM_BODIES; i++) {
+    assert(scene_get_body(scene, i + 1) == bodies[i]);
+    assert(scene_resolve(scene, handles[i]) == bodies[i]);
+  }
+
+  // Bodies added one by one after reserving room behave the same
+  scene_reserve_bodies(scene, 2);
+  scene_reserve_forces(scene, FORCE_PHASE_REACT, 2);
+  body_t *last = body_init(make_shape(), 1, (rgb_color_t){0, 0, 0});
+  body_handle_t handle = scene_add_body(scene, last);
+  assert(scene_resolve(scene, handle) == last);
+  body_set_velocity(last, (vector_t){1, 0});
+  scene_tick(scene, 1);
+  assert(vec_isclose(body_get_centroid(last), (vector_t){1, 0}));
+  assert(vec_isclose(body_get_centroid(bodies[NUM_BODIES - 1]),
+                     (vector_t){3 * (NUM_BODIES - 1), 0}));
+  free(handles);
+  free(bodies);
+  scene_free(scene);
+}
+
 int main(int argc, char *argv[]) {
   // Run all tests if there are no command-line arguments
   bool all_tests = argc == 1;
@@ -241,6 +796,18 @@ int main(int argc, char *argv[]) {
   DO_TEST(test_force_creator)
   DO_TEST(test_force_creator_aux)
   DO_TEST(test_reaping)
+  DO_TEST(test_sleeping_forces_skipped)
+  DO_TEST(test_substeps)
+  DO_TEST(test_fields)
+  DO_TEST(test_phases_and_tags)
+  DO_TEST(test_players)
+  DO_TEST(test_snapshot)
+  DO_TEST(test_snapshot_removed)
+  DO_TEST(test_hash)
+  DO_TEST(test_handles)
+  DO_TEST(test_add_bodies_n)
+  DO_TEST(test_spatial_queries)
+  DO_TEST(test_clone_cost)
 
   puts("scene_test PASS");
 }
@@ -0,0 +1,84 @@
+#include "body.h"
+#include "polygon.h"
+#include "shape.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+// Make square centered at (5, 3) with side 2
+list_t *make_offset_square() {
+  list_t *sq = list_init(4, free);
+  vector_t points[] = {{6, 4}, {4, 4}, {4, 2}, {6, 2}};
+  for (size_t i = 0; i < 4; i++) {
+    vector_t *v = malloc(sizeof(*v));
+    *v = points[i];
+    list_add(sq, v);
+  }
+  return sq;
+}
+
+void test_shape_recenters() {
+  shape_t *shape = shape_init(make_offset_square());
+  assert(vec_isclose(shape_get_origin(shape), (vector_t){5, 3}));
+  list_t *points = shape_get_points(shape);
+  assert(list_size(points) == 4);
+  assert(vec_isclose(*(vector_t *)list_get(points, 0), (vector_t){1, 1}));
+  assert(vec_isclose(*(vector_t *)list_get(points, 2), (vector_t){-1, -1}));
+  assert(vec_isclose(polygon_centroid(points), VEC_ZERO));
+  assert(shape_get_pieces(shape) == NULL);
+  shape_release(shape);
+}
+
+void test_shape_place() {
+  shape_t *shape = shape_init(make_offset_square());
+  list_t *placed =
+      shape_place(shape_get_points(shape), (vector_t){10, 20}, M_PI / 2);
+  assert(vec_isclose(*(vector_t *)list_get(placed, 0), (vector_t){9, 21}));
+  assert(vec_isclose(*(vector_t *)list_get(placed, 2), (vector_t){11, 19}));
+  // The prototype is untouched
+  assert(vec_isclose(*(vector_t *)list_get(shape_get_points(shape), 0),
+                     (vector_t){1, 1}));
+  list_free(placed);
+  shape_release(shape);
+}
+
+void test_shared_shape() {
+  shape_t *shape = shape_init(make_offset_square());
+  body_t *body1 = body_init_with_shape(shape, (vector_t){0, 0}, 1,
+                                       (rgb_color_t){0, 0, 0}, 2, 2);
+  body_t *body2 = body_init_with_shape(shape, (vector_t){10, 0}, 1,
+                                       (rgb_color_t){0, 0, 0}, 2, 2);
+  // The bodies keep the shape alive on their own
+  shape_release(shape);
+
+  body_set_centroid(body1, (vector_t){-3, 4});
+  body_set_rotation(body2, M_PI);
+  list_t *shape1 = body_get_shape(body1);
+  list_t *shape2 = body_get_shape(body2);
+  assert(vec_isclose(*(vector_t *)list_get(shape1, 0), (vector_t){-2, 5}));
+  assert(vec_isclose(*(vector_t *)list_get(shape2, 0), (vector_t){9, -1}));
+  assert(vec_isclose(polygon_centroid(shape1), (vector_t){-3, 4}));
+  assert(vec_isclose(polygon_centroid(shape2), (vector_t){10, 0}));
+  list_free(shape1);
+  list_free(shape2);
+
+  body_free(body1);
+  body_free(body2);
+}
+
+int main(int argc, char *argv[]) {
+  // Run all tests? True if there are no command-line arguments
+  bool all_tests = argc == 1;
+  // Read test name from file
+  char testname[100];
+  if (!all_tests) {
+    read_testname(argv[1], testname, sizeof(testname));
+  }
+
+  DO_TEST(test_shape_recenters)
+  DO_TEST(test_shape_place)
+  DO_TEST(test_shared_shape)
+
+  puts("shape_test PASS");
+}
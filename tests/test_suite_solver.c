@@ -0,0 +1,118 @@
+#include "contact_cache.h"
+#include "solver.h"
+#include "test_util.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+list_t *make_square() {
+  list_t *square = list_init(4, free);
+  vector_t *v = malloc(sizeof(*v));
+  *v = (vector_t){-1, -1};
+  list_add(square, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){+1, -1};
+  list_add(square, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){+1, +1};
+  list_add(square, v);
+  v = malloc(sizeof(*v));
+  *v = (vector_t){-1, +1};
+  list_add(square, v);
+  return square;
+}
+
+void test_resting_contact() {
+  const double G = 10;
+  const double DT = 1e-2;
+  const double MASS = 2;
+  contact_cache_t *cache = contact_cache_init();
+  solver_t *solver = solver_init(4, cache);
+  body_t *box = body_init(make_square(), MASS, (rgb_color_t){0, 0, 0});
+  body_t *floor = body_init(make_square(), INFINITY, (rgb_color_t){0, 0, 0});
+  body_set_centroid(floor, (vector_t){0, -2});
+
+  body_add_force(box, (vector_t){0, -MASS * G});
+  solver_add_contact(solver, box, floor, (vector_t){0, -1}, 0.1);
+  assert(solver_contacts(solver) == 1);
+  solver_solve(solver, DT);
+  assert(solver_contacts(solver) == 0);
+  // Exactly cancels the velocity gravity would add this tick
+  assert(isclose(contact_cache_get_impulse(cache, box, floor), MASS * G * DT));
+  body_tick(box, DT);
+  assert(isclose(body_get_velocity(box).y, 0));
+
+  // The remembered impulse alone holds the box up the next tick
+  contact_cache_begin_tick(cache);
+  solver_set_iterations(solver, 0);
+  body_add_force(box, (vector_t){0, -MASS * G});
+  solver_add_contact(solver, box, floor, (vector_t){0, -1}, 0.1);
+  solver_solve(solver, DT);
+  body_tick(box, DT);
+  assert(isclose(body_get_velocity(box).y, 0));
+
+  contact_cache_forget(cache, box);
+  assert(contact_cache_get_impulse(cache, box, floor) == 0);
+  solver_free(solver);
+  contact_cache_free(cache);
+  body_free(box);
+  body_free(floor);
+}
+
+void test_moving_contacts() {
+  const double DT = 1e-2;
+  contact_cache_t *cache = contact_cache_init();
+  solver_t *solver = solver_init(8, cache);
+  body_t *pusher = body_init(make_square(), 1, (rgb_color_t){0, 0, 0});
+  body_t *pushed = body_init(make_square(), 1, (rgb_color_t){0, 0, 0});
+  body_set_centroid(pushed, (vector_t){2, 0});
+
+  // Bodies moving apart are left alone
+  body_set_velocity(pusher, (vector_t){-1, 0});
+  solver_add_contact(solver, pusher, pushed, (vector_t){1, 0}, 0.1);
+  solver_solve(solver, DT);
+  assert(contact_cache_get_impulse(cache, pusher, pushed) == 0);
+  body_tick(pusher, DT);
+  assert(vec_isclose(body_get_velocity(pusher), (vector_t){-1, 0}));
+
+  // Pushing shares the momentum like an inelastic collision
+  contact_cache_begin_tick(cache);
+  body_set_velocity(pusher, (vector_t){1, 0});
+  solver_add_contact(solver, pusher, pushed, (vector_t){1, 0}, 0.1);
+  solver_solve(solver, DT);
+  body_tick(pusher, DT);
+  body_tick(pushed, DT);
+  assert(vec_isclose(body_get_velocity(pusher), (vector_t){0.5, 0}));
+  assert(vec_isclose(body_get_velocity(pushed), (vector_t){0.5, 0}));
+
+  // Deep overlaps are pushed apart
+  contact_cache_begin_tick(cache);
+  body_set_velocity(pusher, VEC_ZERO);
+  body_set_velocity(pushed, VEC_ZERO);
+  solver_add_contact(solver, pusher, pushed, (vector_t){1, 0}, 1.5);
+  solver_solve(solver, DT);
+  body_tick(pusher, DT);
+  body_tick(pushed, DT);
+  assert(body_get_velocity(pusher).x < 0);
+  assert(body_get_velocity(pushed).x > 0);
+
+  solver_free(solver);
+  contact_cache_free(cache);
+  body_free(pusher);
+  body_free(pushed);
+}
+
+int main(int argc, char *argv[]) {
+  // Run all tests? True if there are no command-line arguments
+  bool all_tests = argc == 1;
+  // Read test name from file
+  char testname[100];
+  if (!all_tests) {
+    read_testname(argv[1], testname, sizeof(testname));
+  }
+
+  DO_TEST(test_resting_contact)
+  DO_TEST(test_moving_contacts)
+
+  puts("solver_test PASS");
+}
@@ -75,6 +75,41 @@ void test_vec_rotate() {
   assert(vec_isclose(vec_rotate(VEC_ZERO, 1.0), VEC_ZERO));
 }
 
+void test_vector_array() {
+  vector_array_t array;
+  vector_array_init(&array, 0);
+  for (size_t i = 0; i < 100; i++) {
+    vector_array_add(&array, (vector_t){i, -(double)i});
+  }
+  assert(vector_array_size(&array) == 100);
+  assert(vec_equal(vector_array_get(&array, 42), (vector_t){42, -42}));
+  vector_array_set(&array, 42, VEC_ZERO);
+  assert(vec_equal(vector_array_get(&array, 42), VEC_ZERO));
+
+  // Iterating visits the elements in order
+  double sum = 0;
+  for (vector_t *v = vector_array_begin(&array); v != vector_array_end(&array);
+       v++) {
+    sum += v->x;
+  }
+  assert(sum == 99 * 100 / 2 - 42);
+
+  // Removing shifts the later elements down; swap-removing moves the last
+  assert(vec_equal(vector_array_remove(&array, 0), VEC_ZERO));
+  assert(vec_equal(vector_array_get(&array, 0), (vector_t){1, -1}));
+  assert(vec_equal(vector_array_swap_remove(&array, 0), (vector_t){1, -1}));
+  assert(vec_equal(vector_array_get(&array, 0), (vector_t){99, -99}));
+  assert(vector_array_size(&array) == 98);
+
+  vector_array_shrink_to_fit(&array);
+  assert(vec_equal(vector_array_get(&array, 97), (vector_t){98, -98}));
+  vector_array_clear(&array);
+  assert(vector_array_size(&array) == 0);
+  vector_array_add(&array, (vector_t){1, 2});
+  assert(vec_equal(vector_array_get(&array, 0), (vector_t){1, 2}));
+  vector_array_free(&array);
+}
+
 int main(int argc, char *argv[]) {
   // Run all tests if there are no command-line arguments
   bool all_tests = argc == 1;
@@ -92,6 +127,7 @@ int main(int argc, char *argv[]) {
   DO_TEST(test_vec_dot)
   DO_TEST(test_vec_cross)
   DO_TEST(test_vec_rotate)
+  DO_TEST(test_vector_array)
 
   puts("vector_test PASS");
 }